@@ -0,0 +1,64 @@
+#!/bin/sh
+# Runs the double-heap benchmark for every heap arity built by "make -f Makefile.benchmark arity"
+# and reports the fastest arity for each window size on this host.
+# Usage: ./arity_benchmark.sh <inputSequenceLength> <steps> <windowSize> [<windowSize> ...]
+# The number of measurements per arity and window size can be set with the RUNS environment variable (default 5).
+
+less_than() {
+    awk -v a="$1" -v b="$2" 'BEGIN { exit !(a < b) }'
+}
+
+if [ "$#" -lt 3 ]; then
+    echo "Usage: $0 <inputSequenceLength> <steps> <windowSize> [<windowSize> ...]"
+    exit 1
+fi
+
+BENCHMARK_DIR=$(dirname "$0")
+ARITIES="2 4 8 16"
+RUNS=${RUNS:-5}
+LENGTH=$1
+STEPS=$2
+shift 2
+
+for arity in $ARITIES; do
+    if [ ! -x "$BENCHMARK_DIR/run_benchmark_arity_$arity" ]; then
+        echo "Missing $BENCHMARK_DIR/run_benchmark_arity_$arity, please run: make -f Makefile.benchmark arity"
+        exit 1
+    fi
+done
+
+printf "%-12s" "windowSize"
+for arity in $ARITIES; do
+    printf "%-12s" "arity $arity"
+done
+printf "%s\n" "best arity"
+
+for windowSize in "$@"; do
+    printf "%-12s" "$windowSize"
+    bestArity=""
+    bestTime=""
+    for arity in $ARITIES; do
+        fastest=""
+        run=0
+        while [ "$run" -lt "$RUNS" ]; do
+            time=$("$BENCHMARK_DIR/run_benchmark_arity_$arity" "$LENGTH" 0 0 -1000 1000 "$windowSize" "$STEPS" false \
+                | sed -n 's/^Time taken: //p')
+            if [ -z "$time" ]; then
+                echo
+                echo "Benchmark failed for windowSize $windowSize (arity $arity)"
+                exit 1
+            fi
+            if [ -z "$fastest" ] || less_than "$time" "$fastest"; then
+                fastest=$time
+            fi
+            run=$((run + 1))
+        done
+
+        printf "%-12s" "$fastest"
+        if [ -z "$bestTime" ] || less_than "$fastest" "$bestTime"; then
+            bestTime=$fastest
+            bestArity=$arity
+        fi
+    done
+    printf "%s\n" "$bestArity"
+done
@@ -4,7 +4,10 @@
  * @brief This file enables benchmarks for specific parameter inputs. All parameters are freely configurable,
  *        including the length of the input sequence, the number of NaN values, the number of Inf values,
  *        the lower bound of the randomly generated numbers, the upper bound of the randomly generated numbers,
- *        the window size, the window step size, and the ignoreNaNWindows option.
+ *        the window size, the window step size, and the ignoreNaNWindows option. An optional ninth argument
+ *        (auto, tiny, heap, select, sorted, fenwick or histogram) forces an engine, so for example the
+ *        Fenwick tree can be compared to the double heap on the same input. Without it the engine is chosen by the
+ *        cost model. For the histogram the random numbers are rounded down to integers (it rejects Inf values).
  *        To run a benchmark, the project must be compiled using Makefile.benchmark, after which the executable named
  *        run_benchmark should be started. The previously mentioned parameters must be provided as command-line
  *        arguments. Important: with the exception of the lower and upper bounds of the randomly generated numbers,
@@ -15,6 +18,8 @@
  * @copyright Copyright (c) 2026
  *
  */
+#define _POSIX_C_SOURCE 199309L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,14 +40,17 @@
 #define VALID_IGNORENANWINDOWS_FALSE_STR "false"
 #define VALID_IGNORENANWINDOWS_FALSE false
 
+#define NUMBER_OF_ENGINE_NAMES 7
+
 static bool check_unsigned_digit(char *string, size_t *resultDigit);
 static bool check_signed_digit(char *string, int64_t *resultDigit);
 static size_t convert_str_to_size_t(char *string);
 static int64_t convert_str_to_int64_t(char *string, bool negative);
 static bool check_valid_ignoreNaNWindows(char *string, bool *result);
+static bool check_valid_engine(char *string, MedianWindowEngine *result);
 
 static bool benchmark_start(size_t length, size_t nanValues, size_t infValues, double lowestValue,
-    double highestValue, size_t windowSize, size_t steps, bool ignoreNaNWindows);
+    double highestValue, size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowEngine engine);
 static void test_array_init(size_t length, double lowestValue, double highestValue, double *dest);
 static void test_array_init_random_nans(double *testArray, size_t *currentIndex, size_t num,
     size_t *spcNumbersIndizesArray);
@@ -57,10 +65,11 @@ static bool result_array_init(size_t inputLength, size_t windowSize, size_t step
 static void difference_time_specs(struct timespec *spec1, struct timespec *spec2, struct timespec *result);
 
 int main(int argc, char *argv[]) {
-    if((argc <= 1) || (argc > 9)) {
+    if((argc < 9) || (argc > 10)) {
         printf("Please enter eight valid arguments:\n");
         printf("(inputSequenceLength, nanValues, infValues, lowestRandomValue, highestRandomValue) -> for the array\n");
         printf("(windowSize, steps, ignoreNaNWindows) -> for the window\n");
+        printf("(engine) -> optional: auto, tiny, heap, select, sorted, fenwick or histogram\n");
         return EXIT_FAILURE;
     }
 
@@ -86,6 +95,12 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
+    MedianWindowEngine engine = MEDIANWINDOW_ENGINE_AUTO;
+    if((argc == 10) && (!check_valid_engine(argv[9], &engine))) {
+        printf("Please enter a valid engine (auto/tiny/heap/select/sorted/fenwick/histogram).\n");
+        return EXIT_FAILURE;
+    }
+
     srand(RANDOM_SEED);
     const bool benchmarkSuccess = benchmark_start(inputSequenceLength,
                                                 nanValues,
@@ -94,7 +109,8 @@ int main(int argc, char *argv[]) {
                                                 ((double) highestPossibleValue),
                                                 windowSize,
                                                 steps,
-                                                ignoreNaNWindows);
+                                                ignoreNaNWindows,
+                                                engine);
 
     if(!benchmarkSuccess) {
         printf("It seems like there was an error!\n");
@@ -185,8 +201,28 @@ static bool check_valid_ignoreNaNWindows(char *string, bool *result) {
     return false;
 }
 
+static bool check_valid_engine(char *string, MedianWindowEngine *result) {
+    static const char *engineNames[NUMBER_OF_ENGINE_NAMES] = {
+        "auto", "tiny", "heap", "select", "sorted", "fenwick", "histogram"
+    };
+    static const MedianWindowEngine engines[NUMBER_OF_ENGINE_NAMES] = {
+        MEDIANWINDOW_ENGINE_AUTO, MEDIANWINDOW_ENGINE_TINY, MEDIANWINDOW_ENGINE_HEAP,
+        MEDIANWINDOW_ENGINE_SELECT, MEDIANWINDOW_ENGINE_SORTED, MEDIANWINDOW_ENGINE_FENWICK,
+        MEDIANWINDOW_ENGINE_HISTOGRAM
+    };
+
+    for(size_t i = 0; i < NUMBER_OF_ENGINE_NAMES; i++) {
+        if(strcmp(string, engineNames[i]) == 0) {
+            *result = engines[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static bool benchmark_start(size_t length, size_t nanValues, size_t infValues, double lowestValue,
-    double highestValue, size_t windowSize, size_t steps, bool ignoreNaNWindows) {
+    double highestValue, size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowEngine engine) {
     if(length == 0)
         return false;
     if((nanValues > length) || (infValues > length) || ((nanValues + infValues) > length))
@@ -199,6 +235,12 @@ static bool benchmark_start(size_t length, size_t nanValues, size_t infValues, d
         return false;
     test_array_init(length, lowestValue, highestValue, inputSequence);
 
+    // The histogram only counts integers
+    if(engine == MEDIANWINDOW_ENGINE_HISTOGRAM) {
+        for(size_t i = 0; i < length; i++)
+            inputSequence[i] = floor(inputSequence[i]);
+    }
+
     const size_t spcNumbersCombNum = (nanValues + infValues);
     if(spcNumbersCombNum > length) {
         free(inputSequence);
@@ -238,8 +280,8 @@ static bool benchmark_start(size_t length, size_t nanValues, size_t infValues, d
 
     struct timespec start, end, result;
     clock_gettime(CLOCK_MONOTONIC, &start);
-    const bool success = sliding_medianwindow(inputSequence, length, windowSize,
-        steps, ignoreNaNWindows, outputArray);
+    const bool success = sliding_medianwindow_with_engine(inputSequence, length, windowSize,
+        steps, ignoreNaNWindows, engine, outputArray);
     clock_gettime(CLOCK_MONOTONIC, &end);
 
     if(success) {
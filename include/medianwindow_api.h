@@ -3,14 +3,87 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+/**
+ * @brief The memory layout of a matrix of several input (and output) sequences.
+ * MEDIANWINDOW_ROW_MAJOR: the sequences are stored one after another (element j of sequence i at i * stride + j).
+ * MEDIANWINDOW_COLUMN_MAJOR: the sequences are interleaved (element j of sequence i at j * numSeries + i).
+ */
+typedef enum MedianWindowLayout
+{
+    MEDIANWINDOW_ROW_MAJOR,
+    MEDIANWINDOW_COLUMN_MAJOR
+} MedianWindowLayout;
+
+/**
+ * @brief Opaque handle of a streaming sliding median window.
+ * The handle keeps the double-heap state alive between calls, so every pushed sample costs O(log windowSize)
+ * instead of re-running the whole input sequence.
+ */
+typedef struct MedianWindowStream MedianWindowStream;
+
+/**
+ * @brief The engines that can process a sliding median window.
+ * MEDIANWINDOW_ENGINE_AUTO lets the cost model pick the engine that is expected to be the fastest.
+ * MEDIANWINDOW_ENGINE_FENWICK ranks the whole input up front and needs memory proportional to its length,
+ * so only sliding_medianwindow and sliding_medianwindow_with_engine use it.
+ * MEDIANWINDOW_ENGINE_HISTOGRAM counts integer values of a range of at most 65536 in a histogram (e.g. 8/16-bit
+ * pixels or ADC samples stored as doubles) and is likewise only used by these two functions.
+ */
+typedef enum MedianWindowEngine
+{
+    MEDIANWINDOW_ENGINE_AUTO,
+    MEDIANWINDOW_ENGINE_TINY,
+    MEDIANWINDOW_ENGINE_HEAP,
+    MEDIANWINDOW_ENGINE_SELECT,
+    MEDIANWINDOW_ENGINE_SORTED,
+    MEDIANWINDOW_ENGINE_FENWICK,
+    MEDIANWINDOW_ENGINE_HISTOGRAM
+} MedianWindowEngine;
+
+/**
+ * @brief The median of an even integer window, which lies between its two middle values lower <= upper.
+ * MEDIANWINDOW_AVERAGING_FLOOR: floor((lower + upper) / 2), which never overflows.
+ * MEDIANWINDOW_AVERAGING_LOWER: the lower middle value (the lower median).
+ * MEDIANWINDOW_AVERAGING_UPPER: the upper middle value (the upper median).
+ */
+typedef enum MedianWindowAveraging
+{
+    MEDIANWINDOW_AVERAGING_FLOOR,
+    MEDIANWINDOW_AVERAGING_LOWER,
+    MEDIANWINDOW_AVERAGING_UPPER
+} MedianWindowAveraging;
+
+/**
+ * @brief The value of a quantile q that lies between two values of a window with n valid values, where
+ * lower <= upper are the values at the positions floor(h) and floor(h) + 1 of the sorted window, h = (n - 1) * q
+ * and fraction = h - floor(h). The names follow numpy.quantile.
+ * MEDIANWINDOW_INTERPOLATION_LINEAR: lower + (upper - lower) * fraction.
+ * MEDIANWINDOW_INTERPOLATION_LOWER: lower.
+ * MEDIANWINDOW_INTERPOLATION_HIGHER: upper, or lower if fraction is 0.
+ * MEDIANWINDOW_INTERPOLATION_NEAREST: lower or upper, whichever position is nearer to h (the even one on a tie).
+ * MEDIANWINDOW_INTERPOLATION_MIDPOINT: (lower + upper) / 2, or lower if fraction is 0.
+ */
+typedef enum MedianWindowInterpolation
+{
+    MEDIANWINDOW_INTERPOLATION_LINEAR,
+    MEDIANWINDOW_INTERPOLATION_LOWER,
+    MEDIANWINDOW_INTERPOLATION_HIGHER,
+    MEDIANWINDOW_INTERPOLATION_NEAREST,
+    MEDIANWINDOW_INTERPOLATION_MIDPOINT
+} MedianWindowInterpolation;
 
 /**
  * @brief This function provides the interface for the sliding median.
- * Important: The interface determines, depending on the size of the window, which strategy is applied to process it.
- * If the window size is below the TINY_MEDIANWINDOW_THRESHOLD, median networks are used.
- * Above the threshold, a double-heap approach, commonly applied for sliding median windows, is used.
- * Important: The specified steps only indicate when a median should be obtained.
- * Regardless of the step size, all elements of the input array pass through the window.
+ * Important: The interface determines, depending on the window size, the step size, the input length and the
+ * share of NaN values in a sample of the input, which strategy is applied to process it. For this purpose a cost
+ * model estimates the runtime of the median networks (window sizes up to TINY_MEDIANWINDOW_THRESHOLD), the
+ * sorted array, the double-heap approach, the Fenwick tree over the ranks of the whole input (as long as its
+ * memory stays below FENWICK_MEDIANWINDOW_MAX_MEMORY) and the selection of every window on its own. If the sampled
+ * valid values are integers of a range of at most 65536, the model also considers a histogram, which is used if all
+ * valid values of the input turn out to be such integers. The model can be fitted to the host with
+ * medianwindow_calibrate.
  * @param inputArray - the input sequence
  * @param length - the length/size of the input sequence
  * @param windowSize - the size of the window
@@ -25,4 +98,331 @@
 bool sliding_medianwindow(double *inputArray, size_t length, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, double *outputArray);
 
+/**
+ * @brief Same as sliding_medianwindow, but processes the window with the given engine.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param engine - the engine; MEDIANWINDOW_ENGINE_TINY only supports window sizes up to 25,
+ *      MEDIANWINDOW_ENGINE_FENWICK fails if the input needs more than FENWICK_MEDIANWINDOW_MAX_MEMORY bytes,
+ *      MEDIANWINDOW_ENGINE_HISTOGRAM fails unless all valid values are integers of a range of at most 65536
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_with_engine(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowEngine engine, double *outputArray);
+
+/**
+ * @brief Computes the sliding median of 8-bit unsigned integers (e.g. pixels) with a histogram, so every window
+ * move costs O(1) whatever the window size is.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param outputArray - the output sequence (the median of an even window size is the mean of the two middle values)
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_u8(const uint8_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    double *outputArray);
+
+/**
+ * @brief Same as sliding_medianwindow_u8, but for 16-bit unsigned integers (e.g. 12-bit ADC samples). The histogram
+ * only spans the range between the smallest and the largest value of the input.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param outputArray - the output sequence (the median of an even window size is the mean of the two middle values)
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_u16(const uint16_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    double *outputArray);
+
+/**
+ * @brief Same as sliding_medianwindow, but for single precision values, which are processed as they are instead of
+ * being converted to double. Windows of up to 25 values run the median networks, larger ones the double-heap. Both
+ * keep float values, so a cache line or a vector holds twice as many of them as of double values.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param outputArray - the output sequence (the median of an even window size is the float mean of the two middle
+ * values)
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_f32(float *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *outputArray);
+
+/**
+ * @brief Same as sliding_medianwindow, but for 32-bit signed integers, whose medians are exact integers. No value is
+ * converted to a floating point value. Windows of up to 25 values run the median networks on integer vectors,
+ * larger ones the double-heap with integer comparisons.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param averaging - the median of an even window size (see MedianWindowAveraging)
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_i32(const int32_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *outputArray);
+
+/**
+ * @brief Same as sliding_medianwindow_i32, but for 64-bit signed integers (e.g. event counts or timestamp deltas),
+ * which stay exact beyond 2^53. The median networks only run on vectors with AVX-512.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param averaging - the median of an even window size (see MedianWindowAveraging)
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_i64(const int64_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *outputArray);
+
+/**
+ * @brief Computes a sliding quantile (e.g. 0.99 for rolling p99 latencies) with the double-heap, whose max-heap holds
+ * the lower part of every window up to the quantile. Every window move costs O(log windowSize) like for the median,
+ * and sliding_medianwindow_quantile(..., 0.5, MEDIANWINDOW_INTERPOLATION_MIDPOINT, ...) returns the median.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a quantile
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow (the quantile is taken of the valid values)
+ * @param quantile - the quantile (0 <= quantile <= 1)
+ * @param interpolation - the value of a quantile between two values (see MedianWindowInterpolation)
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_quantile(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, MedianWindowInterpolation interpolation, double *outputArray);
+
+/**
+ * @brief Computes several sliding quantiles (e.g. p10/p50/p90 bands) in one pass over the input. From 4 quantiles on,
+ * all of them are taken from a single order-statistic B+-tree per window, so a window move updates one structure and
+ * the quantiles share one descent of it: a window costs O(log windowSize + numQuantiles). Fewer quantiles are each
+ * taken by a double-heap, which takes the input block by block together with the other double-heaps.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain the quantiles
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param quantiles - the quantiles (0 <= quantile <= 1) in any order
+ * @param numQuantiles - the number of quantiles
+ * @param interpolation - the value of a quantile between two values (see MedianWindowInterpolation)
+ * @param outputArray - the output sequence, which holds the quantiles of every window one after another in the order
+ *      of quantiles: outputArray[(window * numQuantiles) + i] (at least numQuantiles times the number of windows)
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_quantiles(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *outputArray);
+
+/**
+ * @brief Computes the sliding rank-th smallest value (1 for the minimum, windowSize for the maximum) with the
+ * double-heap. A window with n < windowSize valid values (ignoreNaNWindows = false) returns its value at the same
+ * relative position, the ((n - 1) * (rank - 1)) / (windowSize - 1) + 1-th smallest one.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a value
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param rank - the rank (1 <= rank <= windowSize)
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_rank(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, size_t rank, double *outputArray);
+
+/**
+ * @brief Computes the sliding median absolute deviation MAD = median(|x - median|) over the valid values x of every
+ * window, together with the median. Both come from the ordered state of the window (a sorted array for small
+ * windows, the double-heap of the median and two double-heaps at the ends of the smallest deviations for larger
+ * ones), so no second pass over the deviations is needed. Multiply the MAD by 1.4826 for a consistent estimate of
+ * the standard deviation of normally distributed values.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a result
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow (the MAD is taken of the valid values)
+ * @param medianArray - the output sequence of the medians or NULL if they are not needed
+ * @param madArray - the output sequence of the median absolute deviations
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_mad(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *medianArray, double *madArray);
+
+/**
+ * @brief Computes the sliding interquartile range (IQR), the third minus the first quartile of every window, where
+ * both quartiles are taken like sliding_medianwindow_quantile takes them. A single window of two double-heaps (split
+ * at the first and at the third quartile) takes every input value once, so a window move costs O(log windowSize)
+ * for both quartiles together and no quartile is stored for a second pass.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a result
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow (the quartiles are taken of the valid values)
+ * @param interpolation - the value of a quartile between two values (see MedianWindowInterpolation)
+ * @param outputArray - the output sequence
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_iqr(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *outputArray);
+
+/**
+ * @brief Applies a Hampel filter: every value x[i] whose deviation from the median m of its centred window
+ * x[i - halfWindow] ... x[i + halfWindow] exceeds threshold * 1.4826 * MAD of that window is replaced by m.
+ * The median, the MAD and the replacement are computed in one pass over the input (by the median networks for
+ * windows of up to 25 values, otherwise by the window of sliding_medianwindow_mad), so no intermediate sequence is
+ * stored. The first and the last halfWindow values have no centred window and are copied unchanged. A NaN value is
+ * never replaced, and neither is a value whose window has no median (see ignoreNaNWindows).
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param halfWindow - the number of values on each side of the centre of a window (windows of 2 * halfWindow + 1)
+ * @param threshold - the number of scaled MADs a value may deviate from the median (e.g. 3), at least 0
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow (the median and the MAD of the valid values)
+ * @param outputArray - the filtered sequence of length values, which must not overlap inputArray
+ * @param outlierMask - NULL or a bitmask of (length + 7) / 8 bytes, where bit (i % 8) of outlierMask[i / 8] is set
+ *      if value i was replaced
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_hampel(const double *inputArray, size_t length, size_t halfWindow, double threshold,
+    bool ignoreNaNWindows, double *outputArray, uint8_t *outlierMask);
+
+/**
+ * @brief Same as sliding_medianwindow, but splits the medians to obtain into contiguous ranges that are computed
+ * on several threads. Every thread warms up its own window on the windowSize - 1 elements in front of its range,
+ * so the result matches the one of sliding_medianwindow bit for bit.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param outputArray - the output sequence
+ * @param numThreads - the number of threads (including the calling one); 0 uses one thread per online processor
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_parallel(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *outputArray, size_t numThreads);
+
+/**
+ * @brief Computes the sliding median of many independent input sequences (e.g. one per sensor channel), which are
+ * distributed over a pool of threads. Every thread reuses one workspace for all of its sequences, so the setup
+ * costs of sliding_medianwindow are only paid once per thread instead of once per sequence.
+ * The output matrix has the same layout as the input matrix, where the stride of the input is maxLength and the
+ * stride of the output is ((maxLength - windowSize) / steps + 1). Medians of sequences shorter than maxLength
+ * occupy the beginning of their output sequence; the rest of it is left untouched.
+ * @param inputMatrix - the input sequences
+ * @param numSeries - the number of input sequences
+ * @param maxLength - the stride of the input sequences (the length of the longest sequence)
+ * @param lengths - the length of every input sequence; NULL if all sequences have maxLength elements
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param layout - the layout of the input and the output matrix
+ * @param outputMatrix - the output sequences
+ * @param numThreads - the number of threads (including the calling one); 0 uses one thread per online processor
+ * @return - true on success; false if any sequence is invalid for sliding_medianwindow (nothing is computed then)
+ */
+bool sliding_medianwindow_batch(double *inputMatrix, size_t numSeries, size_t maxLength, const size_t *lengths,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout, double *outputMatrix,
+    size_t numThreads);
+
+/**
+ * @brief Fits the cost model of the engine selection to the host by timing every engine on synthetic input
+ * (takes about a second). The fitted model is used by all following calls. It replaces the previous model at once,
+ * so calls on other threads choose their engine by either the previous or the fitted model. The model is copied
+ * into static storage, so calibrating or loading any number of times takes no memory beyond the call.
+ * @param path - if not NULL, the fitted model is stored in this file, so it can be restored with
+ *      medianwindow_load_calibration instead of calibrating again
+ * @return - true on success; otherwise false (the previous model remains in use)
+ */
+bool medianwindow_calibrate(const char *path);
+
+/**
+ * @brief Restores a cost model stored by medianwindow_calibrate. Like a fitted model, it replaces the previous model
+ * at once.
+ * @param path - the file of the stored model
+ * @return - true on success; otherwise false (the previous model remains in use)
+ */
+bool medianwindow_load_calibration(const char *path);
+
+/**
+ * @brief Returns the size of the workspace (in bytes) needed by sliding_medianwindow_ws for the given window size.
+ * @param windowSize - the size of the window
+ * @return - the needed workspace size in bytes
+ */
+size_t sliding_medianwindow_ws_size(size_t windowSize);
+
+/**
+ * @brief Same as sliding_medianwindow, but works on a caller-owned workspace instead of allocating memory.
+ * This allows reusing one workspace (e.g. per thread) for many calls without any heap allocation.
+ * @param inputArray - the input sequence
+ * @param length - the length/size of the input sequence
+ * @param windowSize - the size of the window
+ * @param steps - the steps that must be taken to obtain a median
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @param outputArray - the output sequence
+ * @param workspace - the caller-owned workspace, aligned to at least 8 bytes
+ * @param workspaceSize - the size of the workspace in bytes, at least sliding_medianwindow_ws_size(windowSize)
+ * @return - true on success; otherwise false
+ */
+bool sliding_medianwindow_ws(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *outputArray, void *workspace, size_t workspaceSize);
+
+/**
+ * @brief Creates a streaming sliding median window, which always uses the double-heap approach.
+ * @param windowSize - the size of the window (at least 2)
+ * @param ignoreNaNWindows - same meaning as for sliding_medianwindow
+ * @return - the handle on success; otherwise NULL
+ */
+MedianWindowStream *medianwindow_stream_create(size_t windowSize, bool ignoreNaNWindows);
+
+/**
+ * @brief Pushes one sample into the window. Once the window is full, the oldest sample leaves it.
+ * @param stream - the handle
+ * @param value - the new sample
+ * @return - true on success; otherwise false
+ */
+bool medianwindow_stream_push(MedianWindowStream *stream, double value);
+
+/**
+ * @brief Pushes several samples into the window.
+ * @param stream - the handle
+ * @param values - the new samples
+ * @param length - the number of new samples
+ * @param outputArray - if not NULL, the median after every pushed sample is written to it
+ *      (outputArray must then hold at least length elements)
+ * @return - true on success; otherwise false
+ */
+bool medianwindow_stream_push_many(MedianWindowStream *stream, const double *values, size_t length,
+    double *outputArray);
+
+/**
+ * @brief Obtains the median of the samples currently inside the window.
+ * Important: While the window is not yet full, the median is calculated over the samples pushed so far.
+ * @param stream - the handle
+ * @param result - the destination of the median
+ * @return - true on success; false if the handle is invalid or no sample was pushed yet
+ */
+bool medianwindow_stream_median(MedianWindowStream *stream, double *result);
+
+/**
+ * @brief Creates an independent copy of the handle including the current window state (e.g. for checkpointing).
+ * @param stream - the handle to copy
+ * @return - the new handle on success; otherwise NULL
+ */
+MedianWindowStream *medianwindow_stream_clone(const MedianWindowStream *stream);
+
+/**
+ * @brief Releases the handle and all of its memory.
+ * @param stream - the handle (NULL is allowed)
+ */
+void medianwindow_stream_destroy(MedianWindowStream *stream);
+
 #endif
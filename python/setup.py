@@ -9,8 +9,27 @@ extensions = [
                 "../src/medianwindow_api.c",
                 "../src/median.c",
                 "../src/tiny_medianwindow.c",
-                "../src/median_window.c"],
+                "../src/tiny_medianwindow_f32.c",
+                "../src/tiny_integer_medianwindow.c",
+                "../src/tiny_integer_medianwindow_i64.c",
+                "../src/median_window.c",
+                "../src/median_window_f32.c",
+                "../src/median_window_i32.c",
+                "../src/median_window_i64.c",
+                "../src/select_medianwindow.c",
+                "../src/sorted_medianwindow.c",
+                "../src/tree_medianwindow.c",
+                "../src/quantiles_medianwindow.c",
+                "../src/mad_medianwindow.c",
+                "../src/hampel_medianwindow.c",
+                "../src/iqr_medianwindow.c",
+                "../src/fenwick_medianwindow.c",
+                "../src/histogram_medianwindow.c",
+                "../src/medianwindow_cost_model.c",
+                "../src/parallel_medianwindow.c"],
         include_dirs=["../include", "../src", np.get_include()],
+        extra_compile_args=["-pthread"],
+        extra_link_args=["-pthread"],
         language="c"
     )
 ]
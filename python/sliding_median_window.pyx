@@ -1,9 +1,25 @@
+cimport numpy as np
+
 cdef extern from "medianwindow_api.h":
     bint sliding_medianwindow(double *inputArray, size_t length, size_t windowSize, size_t steps,
     bint ignoreNaNWindows, double *outputArray)
+    bint sliding_medianwindow_f32(float *inputArray, size_t length, size_t windowSize, size_t steps,
+    bint ignoreNaNWindows, float *outputArray)
+    ctypedef enum MedianWindowAveraging:
+        MEDIANWINDOW_AVERAGING_FLOOR
+        MEDIANWINDOW_AVERAGING_LOWER
+        MEDIANWINDOW_AVERAGING_UPPER
+    bint sliding_medianwindow_i32(const np.int32_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, np.int32_t *outputArray)
+    bint sliding_medianwindow_i64(const np.int64_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, np.int64_t *outputArray)
 
 import numpy as np
-cimport numpy as np
+
+# The median of an even window size for the integer functions
+AVERAGING_FLOOR = MEDIANWINDOW_AVERAGING_FLOOR
+AVERAGING_LOWER = MEDIANWINDOW_AVERAGING_LOWER
+AVERAGING_UPPER = MEDIANWINDOW_AVERAGING_UPPER
 
 def sliding_median_window(np.ndarray[np.float64_t, ndim=1] array,
     windowSize, steps, ignoreNaNWindows,
@@ -39,3 +55,101 @@ def sliding_median_window(np.ndarray[np.float64_t, ndim=1] array,
     cdef double* output_array = <double*> c_output.data
 
     return sliding_medianwindow(inputArrayPtr, len, windowSize, steps, ignoreNaNWindows, output_array)
+
+def sliding_median_window_f32(np.ndarray[np.float32_t, ndim=1] array,
+    windowSize, steps, ignoreNaNWindows,
+    np.ndarray[np.float32_t, ndim=1] output):
+    """
+    Same as sliding_median_window, but for float32 sequences, which are processed without a conversion to float64.
+
+    Parameters
+    ----------
+    array : np.ndarray
+        Input sequence as a 1D array of type float32.
+    windowSize : int
+        Size of the sliding window.
+    steps : int
+        Number of steps between median outputs.
+    ignoreNaNWindows : bool
+        Same meaning as for sliding_median_window.
+    output : np.ndarray
+        Output array of type float32 to store the computed medians.
+
+    Returns
+    -------
+    bool
+        True on success, False otherwise.
+    """
+    cdef Py_ssize_t len = array.size
+    cdef np.ndarray[np.float32_t, ndim=1] c_array = np.ascontiguousarray(array, dtype=np.float32)
+    cdef float* inputArrayPtr = <float*> c_array.data
+    cdef np.ndarray[np.float32_t, ndim=1] c_output = np.ascontiguousarray(output, dtype=np.float32)
+    cdef float* output_array = <float*> c_output.data
+
+    return sliding_medianwindow_f32(inputArrayPtr, len, windowSize, steps, ignoreNaNWindows, output_array)
+
+def sliding_median_window_i32(np.ndarray[np.int32_t, ndim=1] array,
+    windowSize, steps, averaging,
+    np.ndarray[np.int32_t, ndim=1] output):
+    """
+    Same as sliding_median_window, but for int32 sequences, whose medians are exact integers.
+
+    Parameters
+    ----------
+    array : np.ndarray
+        Input sequence as a 1D array of type int32.
+    windowSize : int
+        Size of the sliding window.
+    steps : int
+        Number of steps between median outputs.
+    averaging : int
+        The median of an even window size: AVERAGING_FLOOR (floor of the mean of both middle values),
+        AVERAGING_LOWER or AVERAGING_UPPER (the lower or upper middle value).
+    output : np.ndarray
+        Output array of type int32 to store the computed medians.
+
+    Returns
+    -------
+    bool
+        True on success, False otherwise.
+    """
+    cdef Py_ssize_t len = array.size
+    cdef np.ndarray[np.int32_t, ndim=1] c_array = np.ascontiguousarray(array, dtype=np.int32)
+    cdef np.int32_t* inputArrayPtr = <np.int32_t*> c_array.data
+    cdef np.ndarray[np.int32_t, ndim=1] c_output = np.ascontiguousarray(output, dtype=np.int32)
+    cdef np.int32_t* output_array = <np.int32_t*> c_output.data
+
+    return sliding_medianwindow_i32(inputArrayPtr, len, windowSize, steps, averaging, output_array)
+
+def sliding_median_window_i64(np.ndarray[np.int64_t, ndim=1] array,
+    windowSize, steps, averaging,
+    np.ndarray[np.int64_t, ndim=1] output):
+    """
+    Same as sliding_median_window, but for int64 sequences, whose medians are exact integers.
+
+    Parameters
+    ----------
+    array : np.ndarray
+        Input sequence as a 1D array of type int64.
+    windowSize : int
+        Size of the sliding window.
+    steps : int
+        Number of steps between median outputs.
+    averaging : int
+        The median of an even window size: AVERAGING_FLOOR (floor of the mean of both middle values),
+        AVERAGING_LOWER or AVERAGING_UPPER (the lower or upper middle value).
+    output : np.ndarray
+        Output array of type int64 to store the computed medians.
+
+    Returns
+    -------
+    bool
+        True on success, False otherwise.
+    """
+    cdef Py_ssize_t len = array.size
+    cdef np.ndarray[np.int64_t, ndim=1] c_array = np.ascontiguousarray(array, dtype=np.int64)
+    cdef np.int64_t* inputArrayPtr = <np.int64_t*> c_array.data
+    cdef np.ndarray[np.int64_t, ndim=1] c_output = np.ascontiguousarray(output, dtype=np.int64)
+    cdef np.int64_t* output_array = <np.int64_t*> c_output.data
+
+    return sliding_medianwindow_i64(inputArrayPtr, len, windowSize, steps, averaging, output_array)
@@ -0,0 +1,363 @@
+/**
+ * @file fenwick_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements an offline median window for inputs that are available up front.
+ *        All valid values of the input are sorted once (LSD radix sort over the bit patterns of the doubles)
+ *        and replaced by their rank, so the window becomes a set of integers in [0, number of valid values).
+ *        The ranks inside the window are the set bits of a bitmap over all ranks, and the median is kept as a
+ *        cursor on this bitmap: every step sets one bit, clears one bit and moves the cursor by at most one set
+ *        bit, which is found by scanning the neighbouring words. Only if the neighbour is far away, a Fenwick
+ *        tree over the bit counts of the words finds it with a branchless descent in O(log n).
+ *        Unlike the double heap, no value is ever moved, which pays off for large windows over slowly varying
+ *        signals, where the ranks of consecutive values are close together.
+ *        The engine needs about 24 bytes per input element, inputs above FENWICK_MEDIANWINDOW_MAX_MEMORY are
+ *        rejected.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "fenwick_medianwindow.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// 11 bit digits need at most 6 passes, while the 2048 buckets of a pass still fit into the L1 cache
+#define FENWICK_RADIX_BITS 11
+#define FENWICK_RADIX_BUCKETS (1 << FENWICK_RADIX_BITS)
+#define FENWICK_RADIX_PASSES ((64 + FENWICK_RADIX_BITS - 1) / FENWICK_RADIX_BITS)
+#define FENWICK_RADIX_HISTOGRAMS_SIZE (FENWICK_RADIX_PASSES * FENWICK_RADIX_BUCKETS * sizeof(size_t))
+#define FENWICK_SIGN_BIT ((uint64_t) 1 << 63)
+#define FENWICK_WORD_BITS 64
+// Bitmap words scanned for the neighbour of the median before the Fenwick tree is asked
+#define FENWICK_SCAN_WORDS 8
+// The bitmap and the tree share the spare keys, which get these extra values for tiny inputs
+#define FENWICK_SPARE_PADDING 8
+
+static inline uint64_t value_to_key(double value);
+static inline double key_to_value(uint64_t key);
+static bool keys_radix_sort(uint64_t *keys, uint32_t *positions, uint64_t *spareKeys, uint32_t *sparePositions,
+    size_t length, size_t *histograms);
+static inline void median_insert(Fenwick_MedianWindow *window, size_t rank);
+static inline void median_remove(Fenwick_MedianWindow *window, size_t rank);
+static inline void median_rebalance(Fenwick_MedianWindow *window);
+static inline size_t bits_next(const Fenwick_MedianWindow *window, size_t rank, size_t order);
+static inline size_t bits_previous(const Fenwick_MedianWindow *window, size_t rank, size_t order);
+static inline void tree_update(Fenwick_MedianWindow *window, size_t word, uint32_t change);
+static inline size_t tree_select(const Fenwick_MedianWindow *window, size_t order);
+static inline size_t word_select(uint64_t word, size_t index);
+
+void fenwick_medianwindow_initialize(char **memory, const double *array, size_t length, bool ignoreNaNWindows,
+    Fenwick_MedianWindow **window) {
+    Fenwick_MedianWindow *targetWindow = (Fenwick_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_FENWICK_MEDIAN_WINDOW;
+    uint64_t *keys = (uint64_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += ((length + FENWICK_SPARE_PADDING) * sizeof(uint64_t));
+    uint64_t *spareKeys = (uint64_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += ((length + FENWICK_SPARE_PADDING) * sizeof(uint64_t));
+    uint32_t *positions = (uint32_t* ) *memory;
+    *memory += (length * sizeof(uint32_t));
+    uint32_t *sparePositions = (uint32_t* ) *memory;
+    *memory += (length * sizeof(uint32_t));
+    size_t *histograms = (size_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += FENWICK_RADIX_HISTOGRAMS_SIZE;
+
+    size_t validCount = 0;
+    for(size_t i = 0; i < length; i++) {
+        if(isnan(array[i]))
+            continue;
+
+        keys[validCount] = value_to_key(array[i]);
+        positions[validCount] = (uint32_t) i;
+        validCount++;
+    }
+
+    if(keys_radix_sort(keys, positions, spareKeys, sparePositions, validCount, histograms)) {
+        uint64_t *swappedKeys = keys;
+        keys = spareKeys;
+        spareKeys = swappedKeys;
+        uint32_t *swappedPositions = positions;
+        positions = sparePositions;
+        sparePositions = swappedPositions;
+    }
+
+    // The sorted keys are turned back into values in place, the spare arrays hold the ranks, the bitmap and
+    // the tree
+    double *sortedValues = (double* ) keys;
+    for(size_t i = 0; i < validCount; i++) {
+        const double value = key_to_value(keys[i]);
+        memcpy(&sortedValues[i], &value, sizeof(double));
+    }
+
+    uint32_t *ranks = sparePositions;
+    for(size_t i = 0; i < length; i++)
+        ranks[i] = FENWICK_NAN_RANK;
+    for(size_t i = 0; i < validCount; i++)
+        ranks[positions[i]] = (uint32_t) i;
+
+    // A tree length of a power of two lets the descent read every node it passes without a bounds check,
+    // the bitmap gets the same number of words, so scans never leave it
+    const size_t words = ((validCount + FENWICK_WORD_BITS - 1) / FENWICK_WORD_BITS);
+    size_t treeLength = 1;
+    while (treeLength < words)
+        treeLength <<= 1;
+    uint64_t *bits = spareKeys;
+    uint32_t *tree = (uint32_t* ) &bits[treeLength];
+    memset(bits, 0, (treeLength * sizeof(uint64_t)));
+    memset(tree, 0, ((treeLength + 1) * sizeof(uint32_t)));
+
+    targetWindow->validCount = 0;
+    targetWindow->nanCount = 0;
+    targetWindow->median = 0;
+    targetWindow->belowCount = 0;
+    targetWindow->treeLength = treeLength;
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->sortedValues = sortedValues;
+    targetWindow->ranks = ranks;
+    targetWindow->bits = bits;
+    targetWindow->tree = tree;
+    *window = targetWindow;
+}
+
+void fenwick_medianwindow_add(Fenwick_MedianWindow *window, size_t position) {
+    const uint32_t rank = window->ranks[position];
+    if(rank == FENWICK_NAN_RANK) {
+        window->nanCount++;
+        return;
+    }
+
+    median_insert(window, rank);
+    median_rebalance(window);
+}
+
+void fenwick_medianwindow_replace(Fenwick_MedianWindow *window, size_t oldPosition, size_t newPosition) {
+    const uint32_t oldRank = window->ranks[oldPosition];
+    if(oldRank == FENWICK_NAN_RANK)
+        window->nanCount--;
+    else
+        median_remove(window, oldRank);
+
+    const uint32_t newRank = window->ranks[newPosition];
+    if(newRank == FENWICK_NAN_RANK)
+        window->nanCount++;
+    else
+        median_insert(window, newRank);
+
+    if(window->validCount > 0)
+        median_rebalance(window);
+}
+
+void fenwick_medianwindow_result(const Fenwick_MedianWindow *restrict window, double *restrict output) {
+    const size_t validCount = window->validCount;
+    if((validCount == 0) || ((window->ignoreNaNWindows) && (window->nanCount > 0))) {
+        *output = NAN;
+        return;
+    }
+
+    const double lowerValue = window->sortedValues[window->median];
+    if((validCount % 2) != 0) {
+        *output = lowerValue;
+        return;
+    }
+
+    const size_t upperRank = bits_next(window, window->median, (window->belowCount + 2));
+    *output = (lowerValue + window->sortedValues[upperRank]) / 2;
+}
+
+bool fenwick_medianwindow_fits(size_t length) {
+    // The ranks and the positions are stored as uint32_t, FENWICK_NAN_RANK marks a NaN value
+    const size_t bytesPerElement = (2 * (sizeof(uint64_t) + sizeof(uint32_t)));
+    const size_t fixedBytes = fenwick_medianwindow_est_mem(0);
+    if((length == 0) || (length >= FENWICK_NAN_RANK) || (FENWICK_MEDIANWINDOW_MAX_MEMORY < fixedBytes))
+        return false;
+
+    return (length <= ((FENWICK_MEDIANWINDOW_MAX_MEMORY - fixedBytes) / bytesPerElement));
+}
+
+size_t fenwick_medianwindow_est_mem(size_t length) {
+    // Only valid if fenwick_medianwindow_fits(length)
+    return (SIZE_OF_FENWICK_MEDIAN_WINDOW + (length * 2 * (sizeof(uint64_t) + sizeof(uint32_t)))
+        + (2 * FENWICK_SPARE_PADDING * sizeof(uint64_t)) + FENWICK_RADIX_HISTOGRAMS_SIZE);
+}
+
+static inline uint64_t value_to_key(double value) {
+    // Maps the doubles to unsigned integers of the same order: negative values are inverted completely,
+    // positive values only get the sign bit
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(double));
+    return ((bits & FENWICK_SIGN_BIT) != 0) ? ~bits : (bits | FENWICK_SIGN_BIT);
+}
+
+static inline double key_to_value(uint64_t key) {
+    const uint64_t bits = ((key & FENWICK_SIGN_BIT) != 0) ? (key & ~FENWICK_SIGN_BIT) : ~key;
+    double value;
+    memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+static bool keys_radix_sort(uint64_t *keys, uint32_t *positions, uint64_t *spareKeys, uint32_t *sparePositions,
+    size_t length, size_t *histograms) {
+    // Sorts the keys with their positions, returns true if the result ended up in the spare arrays.
+    // All histograms are counted in one pass, a digit that is the same for all keys skips its pass.
+    memset(histograms, 0, FENWICK_RADIX_HISTOGRAMS_SIZE);
+    for(size_t i = 0; i < length; i++) {
+        for(size_t pass = 0; pass < FENWICK_RADIX_PASSES; pass++) {
+            const size_t bucket = ((keys[i] >> (pass * FENWICK_RADIX_BITS)) & (FENWICK_RADIX_BUCKETS - 1));
+            histograms[(pass * FENWICK_RADIX_BUCKETS) + bucket]++;
+        }
+    }
+
+    bool swapped = false;
+    for(size_t pass = 0; (pass < FENWICK_RADIX_PASSES) && (length > 0); pass++) {
+        const size_t shift = (pass * FENWICK_RADIX_BITS);
+        size_t *histogram = &histograms[pass * FENWICK_RADIX_BUCKETS];
+        if(histogram[(keys[0] >> shift) & (FENWICK_RADIX_BUCKETS - 1)] == length)
+            continue;
+
+        size_t offset = 0;
+        for(size_t bucket = 0; bucket < FENWICK_RADIX_BUCKETS; bucket++) {
+            const size_t count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        // Stable, so equal keys keep the order of their positions
+        for(size_t i = 0; i < length; i++) {
+            const size_t target = histogram[(keys[i] >> shift) & (FENWICK_RADIX_BUCKETS - 1)]++;
+            spareKeys[target] = keys[i];
+            sparePositions[target] = positions[i];
+        }
+
+        uint64_t *swappedKeys = keys;
+        keys = spareKeys;
+        spareKeys = swappedKeys;
+        uint32_t *swappedPositions = positions;
+        positions = sparePositions;
+        sparePositions = swappedPositions;
+        swapped = !swapped;
+    }
+
+    return swapped;
+}
+
+static inline void median_insert(Fenwick_MedianWindow *window, size_t rank) {
+    window->bits[rank / FENWICK_WORD_BITS] |= ((uint64_t) 1 << (rank % FENWICK_WORD_BITS));
+    tree_update(window, (rank / FENWICK_WORD_BITS), 1);
+    window->validCount++;
+    if(window->validCount == 1) {
+        window->median = rank;
+        window->belowCount = 0;
+        return;
+    }
+
+    window->belowCount += (rank < window->median);
+}
+
+static inline void median_remove(Fenwick_MedianWindow *window, size_t rank) {
+    window->bits[rank / FENWICK_WORD_BITS] &= ~((uint64_t) 1 << (rank % FENWICK_WORD_BITS));
+    tree_update(window, (rank / FENWICK_WORD_BITS), UINT32_MAX);
+    window->validCount--;
+    if((window->validCount == 0) || (rank > window->median))
+        return;
+
+    if(rank < window->median) {
+        window->belowCount--;
+        return;
+    }
+
+    // The median itself left, its upper neighbour takes over (the lower one if there is none)
+    if(window->belowCount < window->validCount) {
+        window->median = bits_next(window, rank, (window->belowCount + 1));
+    } else {
+        window->median = bits_previous(window, rank, window->belowCount);
+        window->belowCount--;
+    }
+}
+
+static inline void median_rebalance(Fenwick_MedianWindow *window) {
+    // The lower median has (validCount - 1) / 2 values below it, a window move shifts it by at most two ranks
+    const size_t targetCount = ((window->validCount - 1) / 2);
+    while (window->belowCount < targetCount) {
+        window->median = bits_next(window, window->median, (window->belowCount + 2));
+        window->belowCount++;
+    }
+
+    while (window->belowCount > targetCount) {
+        window->median = bits_previous(window, window->median, window->belowCount);
+        window->belowCount--;
+    }
+}
+
+static inline size_t bits_next(const Fenwick_MedianWindow *window, size_t rank, size_t order) {
+    // The lowest window rank above the given one, which is the order-th window rank (starting at 1).
+    // Close neighbours are found in the bitmap, far ones (small windows over long inputs) by the tree.
+    const uint64_t *bits = window->bits;
+    size_t word = (rank / FENWICK_WORD_BITS);
+    uint64_t remaining = (bits[word] & ((UINT64_MAX << (rank % FENWICK_WORD_BITS)) << 1));
+    for(size_t scanned = 0; (remaining == 0) && (scanned < FENWICK_SCAN_WORDS); scanned++) {
+        word++;
+        if(word == window->treeLength)
+            break;
+        remaining = bits[word];
+    }
+
+    if(remaining == 0)
+        return tree_select(window, order);
+
+    return ((word * FENWICK_WORD_BITS) + (size_t) __builtin_ctzll(remaining));
+}
+
+static inline size_t bits_previous(const Fenwick_MedianWindow *window, size_t rank, size_t order) {
+    // The highest window rank below the given one, see bits_next
+    const uint64_t *bits = window->bits;
+    size_t word = (rank / FENWICK_WORD_BITS);
+    uint64_t remaining = (bits[word] & (((uint64_t) 1 << (rank % FENWICK_WORD_BITS)) - 1));
+    for(size_t scanned = 0; (remaining == 0) && (scanned < FENWICK_SCAN_WORDS); scanned++) {
+        if(word == 0)
+            break;
+        word--;
+        remaining = bits[word];
+    }
+
+    if(remaining == 0)
+        return tree_select(window, order);
+
+    return ((word * FENWICK_WORD_BITS) + (FENWICK_WORD_BITS - 1) - (size_t) __builtin_clzll(remaining));
+}
+
+static inline void tree_update(Fenwick_MedianWindow *window, size_t word, uint32_t change) {
+    // change is 1 or UINT32_MAX (-1 in unsigned arithmetic)
+    uint32_t *tree = window->tree;
+    const size_t treeLength = window->treeLength;
+    for(size_t node = (word + 1); node <= treeLength; node += (node & (~node + 1)))
+        tree[node] += change;
+}
+
+static inline size_t tree_select(const Fenwick_MedianWindow *window, size_t order) {
+    // Returns the order-th window rank (starting at 1): the descent finds the bitmap word that holds it, where
+    // every step halves the range. The decision is a conditional move, as it is taken in half of the cases.
+    const uint32_t *tree = window->tree;
+    size_t node = 0;
+    for(size_t step = window->treeLength; step > 0; step >>= 1) {
+        const size_t nodeCount = tree[node + step];
+        const bool below = (nodeCount < order);
+        node += below ? step : 0;
+        order -= below ? nodeCount : 0;
+    }
+
+    return ((node * FENWICK_WORD_BITS) + word_select(window->bits[node], (order - 1)));
+}
+
+static inline size_t word_select(uint64_t word, size_t index) {
+    // The position of the index-th set bit (starting at 0)
+#if defined(__BMI2__)
+    return (size_t) __builtin_ctzll(_pdep_u64(((uint64_t) 1 << index), word));
+#else
+    for(size_t i = 0; i < index; i++)
+        word &= (word - 1);
+    return (size_t) __builtin_ctzll(word);
+#endif
+}
@@ -0,0 +1,46 @@
+#ifndef FENWICK_MEDIANWINDOW_H
+#define FENWICK_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#define STD_ALIGNMENT 8
+// The engine needs memory proportional to the input length, inputs that would need more are rejected.
+// The bound can be changed at build time, e.g. -DFENWICK_MEDIANWINDOW_MAX_MEMORY=1073741824
+#ifndef FENWICK_MEDIANWINDOW_MAX_MEMORY
+#define FENWICK_MEDIANWINDOW_MAX_MEMORY ((size_t) 1 << 31)
+#endif
+#define FENWICK_NAN_RANK UINT32_MAX
+
+// Every valid (non-NaN) value of the input gets a distinct rank, sortedValues[rank] is the value itself.
+// The ranks inside the window are the set bits of the bitmap, the Fenwick tree counts the set bits of every
+// bitmap word. median is the rank of the lower median and belowCount the number of window ranks below it.
+// NaN values are only counted.
+typedef struct Fenwick_MedianWindow
+{
+    size_t validCount;
+    size_t nanCount;
+    size_t median;
+    size_t belowCount;
+    size_t treeLength;
+    bool ignoreNaNWindows;
+    double *sortedValues;
+    uint32_t *ranks;
+    uint64_t *bits;
+    uint32_t *tree;
+} Fenwick_MedianWindow;
+
+void fenwick_medianwindow_initialize(char **memory, const double *array, size_t length, bool ignoreNaNWindows,
+    Fenwick_MedianWindow **window);
+void fenwick_medianwindow_add(Fenwick_MedianWindow *window, size_t position);
+void fenwick_medianwindow_replace(Fenwick_MedianWindow *window, size_t oldPosition, size_t newPosition);
+void fenwick_medianwindow_result(const Fenwick_MedianWindow *restrict window, double *restrict output);
+bool fenwick_medianwindow_fits(size_t length);
+size_t fenwick_medianwindow_est_mem(size_t length);
+
+#define SIZE_OF_FENWICK_MEDIAN_WINDOW sizeof(Fenwick_MedianWindow)
+
+#endif
@@ -0,0 +1,331 @@
+/**
+ * @file hampel_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a Hampel filter, which replaces every value that deviates from the median of its
+ *        centred window by more than threshold * 1.4826 * MAD with that median. The median, the MAD, the test and
+ *        the replacement are fused into one pass over the input, so neither the medians nor the MADs of the whole
+ *        sequence are stored, and the outliers are collected in a bitmask on the way.
+ *        Small windows (up to 25 values) are sorted by the median networks of median_networks.h: one network
+ *        evaluation selects the median, and a second one on the deviations from it selects the MAD. Every window
+ *        size has its own generated loop, in which both evaluations are inlined, and like in tiny_medianwindow.c
+ *        the networks run on AVX2/AVX-512 vectors of 4 or 8 consecutive windows where available. Larger windows
+ *        are kept in a Mad_MedianWindow (see mad_medianwindow.c), which updates the median and the MAD per moved
+ *        value.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "hampel_medianwindow.h"
+#include "median_networks.h"
+
+#define SCALAR_COMPARATOR(a, b) { \
+    const double firstValue = values[a]; \
+    const double secondValue = values[b]; \
+    values[a] = (firstValue > secondValue) ? secondValue : firstValue; \
+    values[b] = (firstValue > secondValue) ? firstValue : secondValue; \
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAMPEL_MEDIANWINDOW_VECTOR_NETWORKS
+#define AVX2_LANES 4
+#define AVX512_LANES 8
+
+// Lane j of vectors[i] holds the value at position i of the window j
+#define AVX2_COMPARATOR(a, b) { \
+    const __m256d lowValues = _mm256_min_pd(vectors[b], vectors[a]); \
+    vectors[b] = _mm256_max_pd(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+
+#define AVX512_COMPARATOR(a, b) { \
+    const __m512d lowValues = _mm512_min_pd(vectors[b], vectors[a]); \
+    vectors[b] = _mm512_max_pd(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+#endif
+
+typedef void (*hampel_network_function)(double *restrict);
+typedef void (*hampel_filter_function)(const Hampel_MedianWindow *restrict, const double *restrict, size_t,
+    double *restrict, uint8_t *restrict);
+
+static void set_network_filter(Hampel_MedianWindow *window);
+static void hampel_mad_filter(Hampel_MedianWindow *restrict window, const double *restrict input, size_t length,
+    double *restrict output, uint8_t *restrict outlierMask);
+static void hampel_network_nan_window(const double *restrict input, size_t windowSize, bool ignoreNaNWindows,
+    double *restrict median, double *restrict mad);
+static inline double hampel_network_median(double *restrict values, size_t size);
+static inline void hampel_mark(double limitFactor, const double *restrict input, size_t position, double median,
+    double mad, double *restrict output, uint8_t *restrict outlierMask);
+static inline void hampel_mark_bits(uint8_t *restrict outlierMask, size_t position, uint32_t outliers);
+
+void hampel_medianwindow_initialize(char **memory, size_t halfWindow, double threshold, bool ignoreNaNWindows,
+    Hampel_MedianWindow **window) {
+    Hampel_MedianWindow *targetWindow = (Hampel_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_HAMPEL_MEDIAN_WINDOW;
+
+    const size_t windowSize = ((2 * halfWindow) + 1);
+    targetWindow->halfWindow = halfWindow;
+    targetWindow->limitFactor = (threshold * HAMPEL_MEDIANWINDOW_MAD_SCALE);
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->mad = NULL;
+    targetWindow->networkFilter = NULL;
+    if(windowSize > HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE)
+        mad_medianwindow_initialize(memory, windowSize, ignoreNaNWindows, &targetWindow->mad);
+    else
+        set_network_filter(targetWindow);
+    *window = targetWindow;
+}
+
+// The networks of every size, which the windows with NaN values need for the number of their valid values
+#define HAMPEL_NETWORK(windowSize, ...) \
+static inline void hampel_network##windowSize(double *restrict values) { \
+    MEDIAN_NETWORK_##windowSize(SCALAR_COMPARATOR) \
+}
+
+TINY_MEDIANS_ALL_SIZES(HAMPEL_NETWORK, )
+
+static const hampel_network_function hampelNetworks[TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, hampel_network, )
+};
+
+// Centred windows have an odd size. The networks only move the values, so the deviations from the median are taken
+// of the partially sorted window in place.
+#define HAMPEL_NETWORK_FILTER(windowSize) \
+static inline void hampel_network_window##windowSize(const Hampel_MedianWindow *restrict window, \
+    const double *restrict input, size_t start, double *restrict output, uint8_t *restrict outlierMask) { \
+    double values[windowSize]; \
+    bool nanInside = false; \
+    for(size_t i = 0; i < windowSize; i++) { \
+        values[i] = input[start + i]; \
+        nanInside |= isnan(values[i]); \
+    } \
+    double median; \
+    double mad; \
+    if(!nanInside) { \
+        hampel_network##windowSize(values); \
+        median = values[windowSize / 2]; \
+        for(size_t i = 0; i < windowSize; i++) \
+            values[i] = fabs(values[i] - median); \
+        hampel_network##windowSize(values); \
+        mad = values[windowSize / 2]; \
+    } else { \
+        hampel_network_nan_window(&input[start], windowSize, window->ignoreNaNWindows, &median, &mad); \
+    } \
+    hampel_mark(window->limitFactor, input, (start + (windowSize / 2)), median, mad, output, outlierMask); \
+} \
+\
+static void hampel_network_filter##windowSize(const Hampel_MedianWindow *restrict window, \
+    const double *restrict input, size_t length, double *restrict output, uint8_t *restrict outlierMask) { \
+    for(size_t start = 0; (start + windowSize) <= length; start++) \
+        hampel_network_window##windowSize(window, input, start, output, outlierMask); \
+}
+
+#define HAMPEL_ODD_SIZES(GENERATOR, ...) \
+    GENERATOR(3, __VA_ARGS__) GENERATOR(5, __VA_ARGS__) GENERATOR(7, __VA_ARGS__) GENERATOR(9, __VA_ARGS__) \
+    GENERATOR(11, __VA_ARGS__) GENERATOR(13, __VA_ARGS__) GENERATOR(15, __VA_ARGS__) GENERATOR(17, __VA_ARGS__) \
+    GENERATOR(19, __VA_ARGS__) GENERATOR(21, __VA_ARGS__) GENERATOR(23, __VA_ARGS__) GENERATOR(25, __VA_ARGS__)
+
+#define HAMPEL_NETWORK_FILTER_OF_SIZE(windowSize, ...) HAMPEL_NETWORK_FILTER(windowSize)
+HAMPEL_ODD_SIZES(HAMPEL_NETWORK_FILTER_OF_SIZE, )
+
+static const hampel_filter_function hampelNetworkFilters[HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE + 1] = {
+    HAMPEL_ODD_SIZES(TINY_MEDIANS_TABLE_ENTRY, hampel_network_filter, )
+};
+
+#ifdef HAMPEL_MEDIANWINDOW_VECTOR_NETWORKS
+// Consecutive windows run both networks on vectors, where lane j holds the window start + j: the first network
+// selects the medians, the second one the MADs of the deviations of the loaded values from them, and the centres
+// of all lanes are tested at once. Vectors containing NaN values and the last windows that do not fill all lanes
+// fall back to the scalar networks.
+#define HAMPEL_VECTOR_NETWORK_FILTER(windowSize, ...) \
+static inline __attribute__((always_inline, target("avx2"))) bool hampel_vector_window##windowSize##_avx2( \
+    double limitFactor, const double *restrict input, size_t start, double *restrict output, \
+    uint8_t *restrict outlierMask) { \
+    __m256d vectors[windowSize]; \
+    __m256d nanMask = _mm256_setzero_pd(); \
+    for(size_t i = 0; i < windowSize; i++) { \
+        vectors[i] = _mm256_loadu_pd(&input[start + i]); \
+        nanMask = _mm256_or_pd(nanMask, _mm256_cmp_pd(vectors[i], vectors[i], _CMP_UNORD_Q)); \
+    } \
+    if(_mm256_movemask_pd(nanMask) != 0) \
+        return false; \
+    MEDIAN_NETWORK_##windowSize(AVX2_COMPARATOR) \
+    const __m256d median = vectors[windowSize / 2]; \
+    const __m256d signMask = _mm256_set1_pd(-0.0); \
+    for(size_t i = 0; i < windowSize; i++) \
+        vectors[i] = _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_loadu_pd(&input[start + i]), median)); \
+    MEDIAN_NETWORK_##windowSize(AVX2_COMPARATOR) \
+    const __m256d limit = _mm256_mul_pd(_mm256_set1_pd(limitFactor), vectors[windowSize / 2]); \
+    const __m256d values = _mm256_loadu_pd(&input[start + (windowSize / 2)]); \
+    const __m256d outliers = _mm256_cmp_pd(_mm256_andnot_pd(signMask, _mm256_sub_pd(values, median)), limit, \
+        _CMP_GT_OQ); \
+    _mm256_storeu_pd(&output[start + (windowSize / 2)], _mm256_blendv_pd(values, median, outliers)); \
+    if(outlierMask != NULL) \
+        hampel_mark_bits(outlierMask, (start + (windowSize / 2)), (uint32_t) _mm256_movemask_pd(outliers)); \
+    return true; \
+} \
+\
+static inline __attribute__((always_inline, target("avx512f"))) bool hampel_vector_window##windowSize##_avx512( \
+    double limitFactor, const double *restrict input, size_t start, double *restrict output, \
+    uint8_t *restrict outlierMask) { \
+    __m512d vectors[windowSize]; \
+    __mmask8 nanMask = 0; \
+    for(size_t i = 0; i < windowSize; i++) { \
+        vectors[i] = _mm512_loadu_pd(&input[start + i]); \
+        nanMask |= _mm512_cmp_pd_mask(vectors[i], vectors[i], _CMP_UNORD_Q); \
+    } \
+    if(nanMask != 0) \
+        return false; \
+    MEDIAN_NETWORK_##windowSize(AVX512_COMPARATOR) \
+    const __m512d median = vectors[windowSize / 2]; \
+    for(size_t i = 0; i < windowSize; i++) \
+        vectors[i] = _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(&input[start + i]), median)); \
+    MEDIAN_NETWORK_##windowSize(AVX512_COMPARATOR) \
+    const __m512d limit = _mm512_mul_pd(_mm512_set1_pd(limitFactor), vectors[windowSize / 2]); \
+    const __m512d values = _mm512_loadu_pd(&input[start + (windowSize / 2)]); \
+    const __mmask8 outliers = _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(values, median)), limit, \
+        _CMP_GT_OQ); \
+    _mm512_storeu_pd(&output[start + (windowSize / 2)], _mm512_mask_blend_pd(outliers, values, median)); \
+    if(outlierMask != NULL) \
+        hampel_mark_bits(outlierMask, (start + (windowSize / 2)), (uint32_t) outliers); \
+    return true; \
+}
+
+#define CONSECUTIVE_HAMPEL_FILTER(windowSize, ISA, TARGET, LANES) \
+__attribute__((target(TARGET))) \
+static void hampel_vector_filter##windowSize##_##ISA(const Hampel_MedianWindow *restrict window, \
+    const double *restrict input, size_t length, double *restrict output, uint8_t *restrict outlierMask) { \
+    const size_t numWindows = ((length - windowSize) + 1); \
+    size_t start = 0; \
+    for(; (start + LANES) <= numWindows; start += LANES) { \
+        if(hampel_vector_window##windowSize##_##ISA(window->limitFactor, input, start, output, outlierMask)) \
+            continue; \
+        for(size_t j = start; j < (start + LANES); j++) \
+            hampel_network_window##windowSize(window, input, j, output, outlierMask); \
+    } \
+    for(; start < numWindows; start++) \
+        hampel_network_window##windowSize(window, input, start, output, outlierMask); \
+}
+
+HAMPEL_ODD_SIZES(HAMPEL_VECTOR_NETWORK_FILTER, )
+HAMPEL_ODD_SIZES(CONSECUTIVE_HAMPEL_FILTER, avx2, "avx2", AVX2_LANES)
+HAMPEL_ODD_SIZES(CONSECUTIVE_HAMPEL_FILTER, avx512, "avx512f", AVX512_LANES)
+
+static const hampel_filter_function hampelVectorFiltersAvx2[HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE + 1] = {
+    HAMPEL_ODD_SIZES(TINY_MEDIANS_TABLE_ENTRY, hampel_vector_filter, _avx2)
+};
+
+static const hampel_filter_function hampelVectorFiltersAvx512[HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE + 1] = {
+    HAMPEL_ODD_SIZES(TINY_MEDIANS_TABLE_ENTRY, hampel_vector_filter, _avx512)
+};
+#endif
+
+static void set_network_filter(Hampel_MedianWindow *window) {
+    const size_t windowSize = ((2 * window->halfWindow) + 1);
+    window->networkFilter = hampelNetworkFilters[windowSize];
+
+#ifdef HAMPEL_MEDIANWINDOW_VECTOR_NETWORKS
+    if(__builtin_cpu_supports("avx512f"))
+        window->networkFilter = hampelVectorFiltersAvx512[windowSize];
+    else if(__builtin_cpu_supports("avx2"))
+        window->networkFilter = hampelVectorFiltersAvx2[windowSize];
+#endif
+}
+
+void hampel_medianwindow_filter(Hampel_MedianWindow *restrict window, const double *restrict input, size_t length,
+    double *restrict output, uint8_t *restrict outlierMask) {
+    const size_t halfWindow = window->halfWindow;
+    for(size_t i = 0; i < halfWindow; i++) {
+        output[i] = input[i];
+        output[length - 1 - i] = input[length - 1 - i];
+    }
+    if(outlierMask != NULL)
+        memset(outlierMask, 0, ((length + 7) / 8));
+
+    if(window->mad != NULL)
+        hampel_mad_filter(window, input, length, output, outlierMask);
+    else
+        window->networkFilter(window, input, length, output, outlierMask);
+}
+
+size_t hampel_medianwindow_est_mem(size_t halfWindow) {
+    const size_t windowSize = ((2 * halfWindow) + 1);
+    return (SIZE_OF_HAMPEL_MEDIAN_WINDOW + ((windowSize > HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE) ?
+        mad_medianwindow_est_mem(windowSize) : 0));
+}
+
+static void hampel_mad_filter(Hampel_MedianWindow *restrict window, const double *restrict input, size_t length,
+    double *restrict output, uint8_t *restrict outlierMask) {
+    const size_t halfWindow = window->halfWindow;
+    Mad_MedianWindow *mad = window->mad;
+    for(size_t i = 0; i <= (2 * halfWindow); i++)
+        mad_medianwindow_add(mad, input[i]);
+
+    for(size_t center = halfWindow;; center++) {
+        double windowMedian;
+        double windowMad;
+        mad_medianwindow_result(mad, &windowMedian, &windowMad);
+        hampel_mark(window->limitFactor, input, center, windowMedian, windowMad, output, outlierMask);
+        if((center + halfWindow + 1) >= length)
+            break;
+        mad_medianwindow_replace(mad, input[center - halfWindow], input[center + halfWindow + 1]);
+    }
+}
+
+static void hampel_network_nan_window(const double *restrict input, size_t windowSize, bool ignoreNaNWindows,
+    double *restrict median, double *restrict mad) {
+    // Only the valid values are sorted, by the network of their number
+    double values[HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE];
+    size_t validCount = 0;
+    for(size_t i = 0; i < windowSize; i++) {
+        values[validCount] = input[i];
+        validCount += (!isnan(input[i]));
+    }
+    if((validCount == 0) || (ignoreNaNWindows)) {
+        *median = NAN;
+        *mad = NAN;
+        return;
+    }
+
+    *median = hampel_network_median(values, validCount);
+    for(size_t i = 0; i < validCount; i++)
+        values[i] = fabs(values[i] - *median);
+    *mad = hampel_network_median(values, validCount);
+}
+
+static inline double hampel_network_median(double *restrict values, size_t size) {
+    if(size == 1)
+        return values[0];
+
+    // The networks of even sizes leave both middle values unordered, which does not change their average
+    hampelNetworks[size](values);
+    if((size % 2) != 0)
+        return values[size / 2];
+
+    return ((values[(size / 2) - 1] + values[size / 2]) / 2);
+}
+
+static inline void hampel_mark(double limitFactor, const double *restrict input, size_t position, double median,
+    double mad, double *restrict output, uint8_t *restrict outlierMask) {
+    // A NaN value or a window without result is never an outlier
+    const double value = input[position];
+    const bool outlier = (fabs(value - median) > (limitFactor * mad));
+    output[position] = outlier ? median : value;
+    if(outlierMask != NULL)
+        outlierMask[position / 8] |= (uint8_t) (outlier << (position % 8));
+}
+
+static inline void hampel_mark_bits(uint8_t *restrict outlierMask, size_t position, uint32_t outliers) {
+    // Bit j of outliers flags the value position + j. The mask is cleared up front, and only bytes holding a set bit
+    // are touched, so the last lanes never write behind the mask.
+    uint8_t *target = &outlierMask[position / 8];
+    uint32_t bits = (outliers << (position % 8));
+    while (bits != 0) {
+        *(target++) |= (uint8_t) bits;
+        bits >>= 8;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef HAMPEL_MEDIANWINDOW_H
+#define HAMPEL_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "tiny_medianwindow.h"
+#include "mad_medianwindow.h"
+
+// The factor that makes the MAD a consistent estimate of the standard deviation of normally distributed values
+#define HAMPEL_MEDIANWINDOW_MAD_SCALE 1.4826
+
+// Up to this window size (2 * halfWindow + 1) every window is sorted by the median networks, larger windows are
+// kept in a Mad_MedianWindow
+#define HAMPEL_MEDIANWINDOW_NETWORK_MAX_WINDOWSIZE TINY_MEDIANWINDOW_THRESHOLD
+
+// A Hampel filter over the centred windows of 2 * halfWindow + 1 values. limitFactor is the threshold times
+// HAMPEL_MEDIANWINDOW_MAD_SCALE, so a value is an outlier if its deviation from the median exceeds limitFactor * MAD.
+// Either the networks of networkFilter or mad filter the windows, the other one is NULL.
+typedef struct Hampel_MedianWindow
+{
+    size_t halfWindow;
+    double limitFactor;
+    bool ignoreNaNWindows;
+    Mad_MedianWindow *mad;
+    void (*networkFilter) (const struct Hampel_MedianWindow *restrict, const double *restrict, size_t,
+        double *restrict, uint8_t *restrict);
+} Hampel_MedianWindow;
+
+void hampel_medianwindow_initialize(char **memory, size_t halfWindow, double threshold, bool ignoreNaNWindows,
+    Hampel_MedianWindow **window);
+// Writes the filtered input to output and, unless outlierMask is NULL, sets the bit (i % 8) of outlierMask[i / 8]
+// for every replaced value i. The first and the last halfWindow values have no centred window and are copied.
+void hampel_medianwindow_filter(Hampel_MedianWindow *restrict window, const double *restrict input, size_t length,
+    double *restrict output, uint8_t *restrict outlierMask);
+size_t hampel_medianwindow_est_mem(size_t halfWindow);
+
+#define SIZE_OF_HAMPEL_MEDIAN_WINDOW sizeof(Hampel_MedianWindow)
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file histogram_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a median window for integer inputs of a small range, such as 8/16-bit pixels or
+ *        12-bit ADC samples (also when they are stored as doubles). The window is a histogram with one fine bin
+ *        per integer, and the median is kept as a pointer to its bin. Two levels of bitmaps mark the non-empty
+ *        fine bins and the non-empty words of the first bitmap, so the neighbouring non-empty bin is found with
+ *        two bit scans however far away it is. A window move changes two counts and moves the pointer by at
+ *        most one non-empty bin, so its costs depend neither on the window size nor on the range of the values.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "histogram_medianwindow.h"
+
+// Doubles up to 2^52 keep every integer and every half-integer exact, so averaging two bins never rounds
+#define HISTOGRAM_MAX_MAGNITUDE 4503599627370496.0
+
+static inline void median_insert(Histogram_MedianWindow *window, size_t bin);
+static inline void median_remove(Histogram_MedianWindow *window, size_t bin);
+static inline void median_rebalance(Histogram_MedianWindow *window);
+static inline size_t bins_next(const Histogram_MedianWindow *window, size_t bin);
+static inline size_t bins_previous(const Histogram_MedianWindow *window, size_t bin);
+static inline size_t bitmap_words(size_t bits);
+
+void histogram_medianwindow_initialize(char **memory, size_t binCount, double minimum, bool ignoreNaNWindows,
+    Histogram_MedianWindow **window) {
+    Histogram_MedianWindow *targetWindow = (Histogram_MedianWindow* ) __builtin_assume_aligned(*memory,
+        STD_ALIGNMENT);
+    *memory += SIZE_OF_HISTOGRAM_MEDIAN_WINDOW;
+
+    const size_t occupiedWords = bitmap_words(binCount);
+    const size_t coarseWords = bitmap_words(occupiedWords);
+    uint64_t *coarse = (uint64_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (coarseWords * sizeof(uint64_t));
+    uint64_t *occupied = (uint64_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (occupiedWords * sizeof(uint64_t));
+    uint32_t *fine = (uint32_t* ) *memory;
+    *memory += (binCount * sizeof(uint32_t));
+    memset(coarse, 0, (coarseWords * sizeof(uint64_t)));
+    memset(occupied, 0, (occupiedWords * sizeof(uint64_t)));
+    memset(fine, 0, (binCount * sizeof(uint32_t)));
+
+    targetWindow->validCount = 0;
+    targetWindow->nanCount = 0;
+    targetWindow->belowCount = 0;
+    targetWindow->medianBin = 0;
+    targetWindow->minimum = minimum;
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->fine = fine;
+    targetWindow->occupied = occupied;
+    targetWindow->coarse = coarse;
+    *window = targetWindow;
+}
+
+void histogram_medianwindow_add(Histogram_MedianWindow *window, uint32_t bin) {
+    if(bin == HISTOGRAM_NAN_BIN) {
+        window->nanCount++;
+        return;
+    }
+
+    median_insert(window, bin);
+    median_rebalance(window);
+}
+
+void histogram_medianwindow_replace(Histogram_MedianWindow *window, uint32_t oldBin, uint32_t newBin) {
+    // Low-cardinality inputs often replace a value by an equal one
+    if(oldBin == newBin)
+        return;
+
+    if(oldBin == HISTOGRAM_NAN_BIN)
+        window->nanCount--;
+    else
+        median_remove(window, oldBin);
+
+    if(newBin == HISTOGRAM_NAN_BIN)
+        window->nanCount++;
+    else
+        median_insert(window, newBin);
+
+    if(window->validCount > 0)
+        median_rebalance(window);
+}
+
+void histogram_medianwindow_result(const Histogram_MedianWindow *restrict window, double *restrict output) {
+    const size_t validCount = window->validCount;
+    if((validCount == 0) || ((window->ignoreNaNWindows) && (window->nanCount > 0))) {
+        *output = NAN;
+        return;
+    }
+
+    const double lowerValue = (window->minimum + (double) window->medianBin);
+    if((validCount % 2) != 0) {
+        *output = lowerValue;
+        return;
+    }
+
+    // The upper median shares the bin of the lower one unless the lower one is the last value in it
+    const size_t upperOrder = ((validCount / 2) + 1);
+    size_t upperBin = window->medianBin;
+    if((window->belowCount + window->fine[upperBin]) < upperOrder)
+        upperBin = bins_next(window, upperBin);
+    *output = (lowerValue + (window->minimum + (double) upperBin)) / 2;
+}
+
+bool histogram_medianwindow_detect(const double *array, size_t length, double *minimum, size_t *binCount) {
+    if((array == NULL) || (length == 0))
+        return false;
+
+    double lowest = INFINITY;
+    double highest = -INFINITY;
+    for(size_t i = 0; i < length; i++) {
+        const double value = array[i];
+        if(isnan(value))
+            continue;
+
+        // Also rejects +/-INFINITY, as floor keeps it but the range check below does not
+        if(floor(value) != value)
+            return false;
+
+        lowest = (value < lowest) ? value : lowest;
+        highest = (value > highest) ? value : highest;
+    }
+
+    // Only NaN values
+    if(lowest > highest)
+        return false;
+
+    if((lowest < -HISTOGRAM_MAX_MAGNITUDE) || (highest > HISTOGRAM_MAX_MAGNITUDE)
+        || ((highest - lowest) >= (double) HISTOGRAM_MAX_BINS))
+        return false;
+
+    if(minimum != NULL)
+        *minimum = lowest;
+    if(binCount != NULL)
+        *binCount = ((size_t) (highest - lowest) + 1);
+    return true;
+}
+
+size_t histogram_medianwindow_est_mem(size_t binCount) {
+    const size_t occupiedWords = bitmap_words(binCount);
+    return (SIZE_OF_HISTOGRAM_MEDIAN_WINDOW + (bitmap_words(occupiedWords) * sizeof(uint64_t))
+        + (occupiedWords * sizeof(uint64_t)) + (binCount * sizeof(uint32_t)));
+}
+
+static inline void median_insert(Histogram_MedianWindow *window, size_t bin) {
+    const size_t word = (bin >> HISTOGRAM_WORD_SHIFT);
+    window->fine[bin]++;
+    window->occupied[word] |= ((uint64_t) 1 << (bin % HISTOGRAM_WORD_BITS));
+    window->coarse[word >> HISTOGRAM_WORD_SHIFT] |= ((uint64_t) 1 << (word % HISTOGRAM_WORD_BITS));
+    window->validCount++;
+    if(window->validCount == 1) {
+        window->medianBin = bin;
+        window->belowCount = 0;
+        return;
+    }
+
+    window->belowCount += (bin < window->medianBin);
+}
+
+static inline void median_remove(Histogram_MedianWindow *window, size_t bin) {
+    // The median bin may become empty, the next rebalance moves the pointer off it
+    const size_t word = (bin >> HISTOGRAM_WORD_SHIFT);
+    window->fine[bin]--;
+    window->occupied[word] &= ~((uint64_t) (window->fine[bin] == 0) << (bin % HISTOGRAM_WORD_BITS));
+    window->coarse[word >> HISTOGRAM_WORD_SHIFT] &= ~((uint64_t) (window->occupied[word] == 0)
+        << (word % HISTOGRAM_WORD_BITS));
+    window->validCount--;
+    window->belowCount -= (bin < window->medianBin);
+}
+
+static inline void median_rebalance(Histogram_MedianWindow *window) {
+    // The lower median is the value with (validCount - 1) / 2 values below it
+    const size_t target = ((window->validCount - 1) / 2);
+    while (window->belowCount > target) {
+        window->medianBin = bins_previous(window, window->medianBin);
+        window->belowCount -= window->fine[window->medianBin];
+    }
+
+    while ((window->belowCount + window->fine[window->medianBin]) <= target) {
+        window->belowCount += window->fine[window->medianBin];
+        window->medianBin = bins_next(window, window->medianBin);
+    }
+}
+
+static inline size_t bins_next(const Histogram_MedianWindow *window, size_t bin) {
+    // The caller guarantees that a non-empty bin exists above
+    size_t word = (bin >> HISTOGRAM_WORD_SHIFT);
+    uint64_t bits = (window->occupied[word] & (~(uint64_t) 1 << (bin % HISTOGRAM_WORD_BITS)));
+    if(bits != 0)
+        return ((word << HISTOGRAM_WORD_SHIFT) + (size_t) __builtin_ctzll(bits));
+
+    size_t coarseWord = (word >> HISTOGRAM_WORD_SHIFT);
+    bits = (window->coarse[coarseWord] & (~(uint64_t) 1 << (word % HISTOGRAM_WORD_BITS)));
+    while (bits == 0)
+        bits = window->coarse[++coarseWord];
+
+    word = ((coarseWord << HISTOGRAM_WORD_SHIFT) + (size_t) __builtin_ctzll(bits));
+    return ((word << HISTOGRAM_WORD_SHIFT) + (size_t) __builtin_ctzll(window->occupied[word]));
+}
+
+static inline size_t bins_previous(const Histogram_MedianWindow *window, size_t bin) {
+    // The caller guarantees that a non-empty bin exists below
+    size_t word = (bin >> HISTOGRAM_WORD_SHIFT);
+    uint64_t bits = (window->occupied[word] & (((uint64_t) 1 << (bin % HISTOGRAM_WORD_BITS)) - 1));
+    if(bits != 0)
+        return ((word << HISTOGRAM_WORD_SHIFT) + (HISTOGRAM_WORD_BITS - 1) - (size_t) __builtin_clzll(bits));
+
+    size_t coarseWord = (word >> HISTOGRAM_WORD_SHIFT);
+    bits = (window->coarse[coarseWord] & (((uint64_t) 1 << (word % HISTOGRAM_WORD_BITS)) - 1));
+    while (bits == 0)
+        bits = window->coarse[--coarseWord];
+
+    word = ((coarseWord << HISTOGRAM_WORD_SHIFT) + (HISTOGRAM_WORD_BITS - 1) - (size_t) __builtin_clzll(bits));
+    return ((word << HISTOGRAM_WORD_SHIFT) + (HISTOGRAM_WORD_BITS - 1)
+        - (size_t) __builtin_clzll(window->occupied[word]));
+}
+
+static inline size_t bitmap_words(size_t bits) {
+    return ((bits + HISTOGRAM_WORD_BITS - 1) >> HISTOGRAM_WORD_SHIFT);
+}
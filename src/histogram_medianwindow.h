@@ -0,0 +1,44 @@
+#ifndef HISTOGRAM_MEDIANWINDOW_H
+#define HISTOGRAM_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#define STD_ALIGNMENT 8
+// Inputs whose valid values span more integers are left to the other engines
+#define HISTOGRAM_MAX_BINS ((size_t) 1 << 16)
+#define HISTOGRAM_WORD_SHIFT 6
+#define HISTOGRAM_WORD_BITS ((size_t) 1 << HISTOGRAM_WORD_SHIFT)
+#define HISTOGRAM_NAN_BIN UINT32_MAX
+
+// A histogram over the integers minimum, minimum + 1, ..., minimum + binCount - 1 inside the window.
+// fine counts the values of every bin, every bit of occupied marks a non-empty fine bin and every bit of coarse
+// a non-empty word of occupied. medianBin is the bin of the lower median and belowCount the number of window
+// values in the bins below it. NaN values are only counted.
+typedef struct Histogram_MedianWindow
+{
+    size_t validCount;
+    size_t nanCount;
+    size_t belowCount;
+    size_t medianBin;
+    double minimum;
+    bool ignoreNaNWindows;
+    uint32_t *fine;
+    uint64_t *occupied;
+    uint64_t *coarse;
+} Histogram_MedianWindow;
+
+void histogram_medianwindow_initialize(char **memory, size_t binCount, double minimum, bool ignoreNaNWindows,
+    Histogram_MedianWindow **window);
+void histogram_medianwindow_add(Histogram_MedianWindow *window, uint32_t bin);
+void histogram_medianwindow_replace(Histogram_MedianWindow *window, uint32_t oldBin, uint32_t newBin);
+void histogram_medianwindow_result(const Histogram_MedianWindow *restrict window, double *restrict output);
+bool histogram_medianwindow_detect(const double *array, size_t length, double *minimum, size_t *binCount);
+size_t histogram_medianwindow_est_mem(size_t binCount);
+
+#define SIZE_OF_HISTOGRAM_MEDIAN_WINDOW sizeof(Histogram_MedianWindow)
+
+#endif
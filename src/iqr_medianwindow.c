@@ -0,0 +1,59 @@
+/**
+ * @file iqr_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a window that yields the interquartile range (IQR), the third minus the first
+ *        quartile of the valid values. The window is made of four heaps: the double-heap of the first quartile
+ *        keeps the lowest quarter of the values in its max-heap and the others in its min-heap, the double-heap
+ *        of the third quartile keeps the highest quarter in its min-heap and the others in its max-heap. The roots
+ *        of the four heaps are the values at both sides of both quartiles, and every moved value updates both
+ *        double-heaps in turn, each in O(log windowSize).
+ *        A partition into four disjoint heaps (lowest quarter, two middle quarters, highest quarter) would need
+ *        both the smallest and the largest value of each middle quarter, one end at a quartile and the other at
+ *        the median, which a single heap cannot provide.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "iqr_medianwindow.h"
+
+#define IQR_MEDIANWINDOW_FIRST_QUARTILE 0.25
+#define IQR_MEDIANWINDOW_THIRD_QUARTILE 0.75
+
+void iqr_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    MedianWindowInterpolation interpolation, Iqr_MedianWindow **window) {
+    Iqr_MedianWindow *targetWindow = (Iqr_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_IQR_MEDIAN_WINDOW;
+
+    medianwindow_initialize_quantile(memory, windowSize, 1, ignoreNaNWindows, IQR_MEDIANWINDOW_FIRST_QUARTILE, 0,
+        &targetWindow->lower);
+    medianwindow_initialize_quantile(memory, windowSize, 1, ignoreNaNWindows, IQR_MEDIANWINDOW_THIRD_QUARTILE, 0,
+        &targetWindow->upper);
+    targetWindow->interpolation = interpolation;
+    *window = targetWindow;
+}
+
+void iqr_medianwindow_add(Iqr_MedianWindow *window, double value) {
+    medianwindow_addNew(window->lower, value);
+    medianwindow_addNew(window->upper, value);
+}
+
+void iqr_medianwindow_replace(Iqr_MedianWindow *window, double newValue) {
+    medianwindow_updateOld(window->lower, newValue);
+    medianwindow_updateOld(window->upper, newValue);
+}
+
+void iqr_medianwindow_result(Iqr_MedianWindow *restrict window, double *restrict output) {
+    // Both double-heaps hold the same values, so a window without result is NaN in both
+    double firstQuartile;
+    double thirdQuartile;
+    medianwindow_quantile_result(window->lower, window->interpolation, &firstQuartile);
+    medianwindow_quantile_result(window->upper, window->interpolation, &thirdQuartile);
+    *output = (thirdQuartile - firstQuartile);
+}
+
+size_t iqr_medianwindow_est_mem(size_t windowSize) {
+    return (SIZE_OF_IQR_MEDIAN_WINDOW + medianwindow_pack_size(2, windowSize));
+}
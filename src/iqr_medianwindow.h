@@ -0,0 +1,32 @@
+#ifndef IQR_MEDIANWINDOW_H
+#define IQR_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "median_window.h"
+
+// The interquartile range of the valid values of a window from two double-heaps that take every value in turn:
+// lower is split at the quantile 0.25 and upper at 0.75, so the roots of all four heaps are the values at both
+// sides of the quartiles.
+typedef struct Iqr_MedianWindow
+{
+    MedianWindow *lower;
+    MedianWindow *upper;
+    MedianWindowInterpolation interpolation;
+} Iqr_MedianWindow;
+
+void iqr_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    MedianWindowInterpolation interpolation, Iqr_MedianWindow **window);
+void iqr_medianwindow_add(Iqr_MedianWindow *window, double value);
+// Replaces the oldest value of the window
+void iqr_medianwindow_replace(Iqr_MedianWindow *window, double newValue);
+// Writes the third minus the first quartile, NaN for a window without result
+void iqr_medianwindow_result(Iqr_MedianWindow *restrict window, double *restrict output);
+size_t iqr_medianwindow_est_mem(size_t windowSize);
+
+#define SIZE_OF_IQR_MEDIAN_WINDOW sizeof(Iqr_MedianWindow)
+
+#endif
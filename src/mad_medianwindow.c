@@ -0,0 +1,238 @@
+/**
+ * @file mad_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a window that yields the median absolute deviation (MAD), the median of |x - m|
+ *        over the valid values x of the window with the median m. Taken in order, the half values below the median
+ *        and the others give two ascending sequences of deviations, m - x going down from the median and x - m
+ *        going up. The smallest half + 1 deviations therefore belong to a contiguous range of the sorted window
+ *        around the median, and the MAD is the largest of them (or the average of the largest two). The range is
+ *        found by searching how many of its values lie below the median: a probe compares the deviations of the
+ *        value just outside the range below the median and of the highest value inside it.
+ *        Moving the window by one value moves the range by a few positions at most, so the search starts at the
+ *        range of the previous window and takes a constant number of probes on most windows.
+ *        Small windows keep their values in a sorted array, which reads every rank directly. Larger windows keep
+ *        the double-heap of the median and two more double-heaps that are split at both ends of the range: the
+ *        roots of these heaps are the values a probe compares, and moving the range by one position moves one root
+ *        from one heap to the other. A window move thus costs three heap updates instead of a second sliding
+ *        median over all deviations.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "mad_medianwindow.h"
+
+static void mad_sorted_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad);
+static void mad_heaps_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad);
+static inline bool mad_sorted_take_lower(const double *values, double median, size_t half, size_t lowerCount);
+static size_t mad_sorted_search_lower_count(const double *values, double median, size_t half, size_t minimum,
+    size_t start);
+static inline void mad_heaps_move_range(Mad_MedianWindow *window, bool down);
+static inline double mad_of_last_deviations(double lowerLast, double lowerSecond, double upperLast,
+    double upperSecond, bool oddCount);
+
+void mad_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Mad_MedianWindow **window) {
+    Mad_MedianWindow *targetWindow = (Mad_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_MAD_MEDIAN_WINDOW;
+
+    targetWindow->sorted = NULL;
+    targetWindow->median = NULL;
+    targetWindow->lower = NULL;
+    targetWindow->upper = NULL;
+    targetWindow->lowerCount = 0;
+    if(windowSize <= MAD_MEDIANWINDOW_SORTED_MAX_WINDOWSIZE) {
+        sorted_medianwindow_initialize(memory, windowSize, ignoreNaNWindows, &targetWindow->sorted);
+    } else {
+        // The range starts without values below the median, the heaps move it to the first window's one
+        const size_t half = (windowSize / 2);
+        medianwindow_initialize(memory, windowSize, 1, ignoreNaNWindows, &targetWindow->median);
+        medianwindow_initialize_split(memory, windowSize, 1, ignoreNaNWindows, half, &targetWindow->lower);
+        medianwindow_initialize_split(memory, windowSize, 1, ignoreNaNWindows, ((2 * half) + 1),
+            &targetWindow->upper);
+    }
+    *window = targetWindow;
+}
+
+void mad_medianwindow_add(Mad_MedianWindow *window, double value) {
+    if(window->sorted != NULL) {
+        sorted_medianwindow_add(window->sorted, value);
+        return;
+    }
+
+    medianwindow_addNew(window->median, value);
+    medianwindow_addNew(window->lower, value);
+    medianwindow_addNew(window->upper, value);
+}
+
+void mad_medianwindow_replace(Mad_MedianWindow *window, double oldValue, double newValue) {
+    if(window->sorted != NULL) {
+        sorted_medianwindow_replace(window->sorted, oldValue, newValue);
+        return;
+    }
+
+    // The heaps remove the oldest value of their own ring
+    medianwindow_updateOld(window->median, newValue);
+    medianwindow_updateOld(window->lower, newValue);
+    medianwindow_updateOld(window->upper, newValue);
+}
+
+void mad_medianwindow_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad) {
+    if(window->sorted != NULL)
+        mad_sorted_result(window, median, mad);
+    else
+        mad_heaps_result(window, median, mad);
+}
+
+size_t mad_medianwindow_est_mem(size_t windowSize) {
+    return (SIZE_OF_MAD_MEDIAN_WINDOW + ((windowSize <= MAD_MEDIANWINDOW_SORTED_MAX_WINDOWSIZE) ?
+        sorted_medianwindow_est_mem(windowSize) :
+        (medianwindow_pack_size(1, windowSize) + medianwindow_pack_size_split(2, windowSize))));
+}
+
+static void mad_sorted_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad) {
+    const Sorted_MedianWindow *sorted = window->sorted;
+    const size_t validCount = sorted->validCount;
+    if((validCount == 0) || ((sorted->ignoreNaNWindows) && (sorted->nanCount > 0))) {
+        *median = NAN;
+        *mad = NAN;
+        return;
+    }
+
+    // The values of the ranks half - 1 down to 0 lie below the median, the others at or above it. The range of the
+    // smallest half + 1 deviations spans lowerCount of the former and half + 1 - lowerCount of the latter.
+    const double *values = sorted->values;
+    const size_t half = (validCount / 2);
+    const bool oddCount = ((validCount % 2) != 0);
+    *median = oddCount ? values[half] : ((values[half - 1] + values[half]) / 2);
+
+    const size_t upperLength = (validCount - half);
+    const size_t minimum = ((half + 1) > upperLength) ? ((half + 1) - upperLength) : 0;
+    const size_t start = (window->lowerCount < minimum) ? minimum : ((window->lowerCount > half) ? half :
+        window->lowerCount);
+    const size_t lowerCount = mad_sorted_search_lower_count(values, *median, half, minimum, start);
+    const size_t upperCount = ((half + 1) - lowerCount);
+    window->lowerCount = lowerCount;
+
+    *mad = mad_of_last_deviations((lowerCount >= 1) ? (*median - values[half - lowerCount]) : -INFINITY,
+        (lowerCount >= 2) ? (*median - values[half - lowerCount + 1]) : -INFINITY,
+        (values[half + upperCount - 1] - *median),
+        (upperCount >= 2) ? (values[half + upperCount - 2] - *median) : -INFINITY, oddCount);
+}
+
+static void mad_heaps_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad) {
+    MedianWindow *lower = window->lower;
+    MedianWindow *upper = window->upper;
+    const size_t validCount = (lower->maxHeapLength + lower->minHeapLength);
+    if((validCount == 0) || ((lower->ignoreNaNWindows) && (lower->spcNumbers > 0))) {
+        *median = NAN;
+        *mad = NAN;
+        return;
+    }
+
+    // lower keeps the values below the range in its max-heap (half - lowerCount values) and upper the values up to
+    // the end of the range (2 * half + 1 - lowerCount values). NaN values entering or leaving the window change
+    // half, so both splits are first brought to the same lowerCount.
+    medianwindow_result(window->median, median);
+    const size_t half = (validCount / 2);
+    const size_t upperLength = (validCount - half);
+    const size_t minimum = ((half + 1) > upperLength) ? ((half + 1) - upperLength) : 0;
+    size_t lowerCount = (lower->rank < half) ? (half - lower->rank) : 0;
+    lowerCount = (lowerCount < minimum) ? minimum : lowerCount;
+    while (lower->rank < (half - lowerCount))
+        medianwindow_move_split(lower, true);
+    while (lower->rank > (half - lowerCount))
+        medianwindow_move_split(lower, false);
+    while (upper->rank < ((2 * half) + 1 - lowerCount))
+        medianwindow_move_split(upper, true);
+    while (upper->rank > ((2 * half) + 1 - lowerCount))
+        medianwindow_move_split(upper, false);
+
+    // A probe compares the deviation of the max-heap root of lower (the next value below the range) with the one
+    // of the max-heap root of upper (the highest value in the range)
+    const double middle = *median;
+    for(;;) {
+        if((lowerCount < half) && ((middle - lower->maxHeap[0]) < (upper->maxHeap[0] - middle))) {
+            mad_heaps_move_range(window, true);
+            lowerCount++;
+        } else if((lowerCount > minimum) && ((middle - lower->minHeap[0]) >= (upper->minHeap[0] - middle))) {
+            mad_heaps_move_range(window, false);
+            lowerCount--;
+        } else {
+            break;
+        }
+    }
+
+    const size_t upperCount = ((half + 1) - lowerCount);
+    *mad = mad_of_last_deviations((lowerCount >= 1) ? (middle - lower->minHeap[0]) : -INFINITY,
+        (lowerCount >= 2) ? (middle - medianwindow_minheap_second(lower)) : -INFINITY,
+        (upper->maxHeap[0] - middle),
+        (upperCount >= 2) ? (medianwindow_maxheap_second(upper) - middle) : -INFINITY, ((validCount % 2) != 0));
+}
+
+static inline bool mad_sorted_take_lower(const double *values, double median, size_t half, size_t lowerCount) {
+    // Whether the range takes more than lowerCount values below the median: the next one below the range
+    // (rank half - 1 - lowerCount) deviates less than the highest one in it (rank 2 * half - lowerCount)
+    return ((median - values[half - 1 - lowerCount]) < (values[(2 * half) - lowerCount] - median));
+}
+
+static size_t mad_sorted_search_lower_count(const double *values, double median, size_t half, size_t minimum,
+    size_t start) {
+    // The first count in [minimum, half] that takes no more values below the median, which half never does.
+    // The search gallops away from start and then halves the remaining interval.
+    size_t low = minimum, high = half, step = 1;
+    if((start < half) && (mad_sorted_take_lower(values, median, half, start))) {
+        low = (start + 1);
+        while (low < high) {
+            const size_t probe = (low + step - 1);
+            if(probe >= high)
+                break;
+            if(!mad_sorted_take_lower(values, median, half, probe)) {
+                high = probe;
+                break;
+            }
+            low = (probe + 1);
+            step *= 2;
+        }
+    } else {
+        high = start;
+        while (low < high) {
+            const size_t probe = ((high - low) > step) ? (high - step) : low;
+            if(mad_sorted_take_lower(values, median, half, probe)) {
+                low = (probe + 1);
+                break;
+            }
+            high = probe;
+            step *= 2;
+        }
+    }
+
+    while (low < high) {
+        const size_t middle = (low + ((high - low) / 2));
+        if(mad_sorted_take_lower(values, median, half, middle))
+            low = (middle + 1);
+        else
+            high = middle;
+    }
+    return low;
+}
+
+static inline void mad_heaps_move_range(Mad_MedianWindow *window, bool down) {
+    // Taking one more value below the median moves both ends of the range one value down
+    medianwindow_move_split(window->lower, !down);
+    medianwindow_move_split(window->upper, !down);
+}
+
+static inline double mad_of_last_deviations(double lowerLast, double lowerSecond, double upperLast,
+    double upperSecond, bool oddCount) {
+    // The largest two deviations of the range are among the last two of each side
+    const double largest = (lowerLast >= upperLast) ? lowerLast : upperLast;
+    if(oddCount)
+        return largest;
+
+    const double secondLargest = (lowerLast >= upperLast) ? fmax(lowerSecond, upperLast) :
+        fmax(lowerLast, upperSecond);
+    return (secondLargest + largest) / 2;
+}
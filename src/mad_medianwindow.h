@@ -0,0 +1,38 @@
+#ifndef MAD_MEDIANWINDOW_H
+#define MAD_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "sorted_medianwindow.h"
+#include "median_window.h"
+
+// Up to this window size the values are kept in a sorted array, larger windows use three double-heaps
+#define MAD_MEDIANWINDOW_SORTED_MAX_WINDOWSIZE 256
+
+// The median absolute deviation of the valid values of a window, either from a sorted array or from three
+// double-heaps: median splits at the median, lower below the lowest and upper behind the highest of the values
+// whose deviations are the smallest half + 1 (see mad_medianwindow.c). lowerCount is the number of those values
+// below the median in the previous window of the sorted array, where the search of the next window starts.
+typedef struct Mad_MedianWindow
+{
+    Sorted_MedianWindow *sorted;
+    MedianWindow *median;
+    MedianWindow *lower;
+    MedianWindow *upper;
+    size_t lowerCount;
+} Mad_MedianWindow;
+
+void mad_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Mad_MedianWindow **window);
+void mad_medianwindow_add(Mad_MedianWindow *window, double value);
+void mad_medianwindow_replace(Mad_MedianWindow *window, double oldValue, double newValue);
+// Writes the median and the median absolute deviation of the window, both NaN for a window without result
+void mad_medianwindow_result(Mad_MedianWindow *restrict window, double *restrict median, double *restrict mad);
+size_t mad_medianwindow_est_mem(size_t windowSize);
+
+#define SIZE_OF_MAD_MEDIAN_WINDOW sizeof(Mad_MedianWindow)
+
+#endif
@@ -1,14 +1,71 @@
 #include "median.h"
 
-static bool valid_window(double  *array, size_t length, size_t windowSize, size_t steps, double *result);
-static inline bool median_window_full(MedianWindow *window);
-static inline bool median_window_steps_reached(MedianWindow *window);
-static inline bool tiny_medianwindow_full(Tiny_MedianWindow *window);
-static inline bool tiny_medianwindow_steps_reached(Tiny_MedianWindow *window);
+// The loop of the engines that keep their window sorted in some structure: ADD puts the value at i into the first
+// window, REPLACE swaps the value at i - windowSize for the one at i, and EMIT writes the result of the current window
+// and moves the output on. A result is emitted for the first window and after every steps replacements.
+#define SLIDING_WINDOW_LOOP(windowSize, length, steps, ADD, REPLACE, EMIT) { \
+    for(size_t i = 0; i < (windowSize); i++) \
+        ADD; \
+    EMIT \
+    \
+    size_t stepDistance = ((steps) - 1); \
+    for(size_t i = (windowSize); i < (length); i++) { \
+        REPLACE; \
+        if(stepDistance == 0) { \
+            EMIT \
+            stepDistance = ((steps) - 1); \
+        } else { \
+            stepDistance--; \
+        } \
+    } \
+}
+
+static void heap_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory);
+static void tiny_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory);
+static void select_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory);
+static void sorted_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory);
+static void fenwick_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory);
+static void histogram_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory, size_t binCount, double minimum);
+static void histogram_medianwindow_process_u8(const uint8_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result, char *memory);
+static void histogram_medianwindow_process_u16(const uint16_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result, char *memory, size_t binCount, uint16_t minimum);
+static void heap_medianwindow_process_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result, char *memory);
+static void tiny_medianwindow_process_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result, char *memory);
+static void heap_quantilewindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, size_t rank, MedianWindowInterpolation interpolation,
+    double *restrict result, char *memory);
+static void quantiles_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *restrict result, char *memory);
+static void heap_quantiles_medianwindow_process(double *restrict array, size_t length, size_t windowSize,
+    size_t steps, bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles,
+    MedianWindowInterpolation interpolation, double *restrict result, char *memory);
+static void mad_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict medianResult, double *restrict madResult, char *memory);
+static void iqr_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *restrict result, char *memory);
+static void heap_medianwindow_process_i32(const int32_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int32_t *restrict result, char *memory);
+static void heap_medianwindow_process_i64(const int64_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int64_t *restrict result, char *memory);
+static void tiny_integer_medianwindow_process_i32(const int32_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int32_t *restrict result, char *memory);
+static void tiny_integer_medianwindow_process_i64(const int64_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int64_t *restrict result, char *memory);
+static inline uint32_t histogram_bin(double value, double minimum);
 
 bool sliding_heap_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, double *restrict result) {
-    if(!valid_window(array, length, windowSize, steps, result))
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
         return false;
 
     const size_t neededWindowMemory = medianwindow_est_mem(windowSize);
@@ -16,7 +73,398 @@ bool sliding_heap_medianwindow(double *restrict array, size_t length, size_t win
     if(memory == NULL)
         return false;
 
-    char *startMemPtr = memory;
+    heap_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_heap_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (workspace == NULL))
+        return false;
+
+    heap_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, workspace);
+    return true;
+}
+
+bool sliding_tiny_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    char *memory = malloc(SIZE_OF_TINY_MEDIAN_WINDOW);
+    if(memory == NULL)
+        return false;
+
+    tiny_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_tiny_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (workspace == NULL))
+        return false;
+
+    tiny_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, workspace);
+    return true;
+}
+
+bool sliding_select_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    char *memory = (char* ) malloc(select_medianwindow_est_mem(windowSize));
+    if(memory == NULL)
+        return false;
+
+    select_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_select_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (workspace == NULL))
+        return false;
+
+    select_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, workspace);
+    return true;
+}
+
+bool sliding_sorted_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    char *memory = (char* ) malloc(sorted_medianwindow_est_mem(windowSize));
+    if(memory == NULL)
+        return false;
+
+    sorted_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_sorted_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (workspace == NULL))
+        return false;
+
+    sorted_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, workspace);
+    return true;
+}
+
+bool sliding_fenwick_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (!fenwick_medianwindow_fits(length)))
+        return false;
+
+    char *memory = (char* ) malloc(fenwick_medianwindow_est_mem(length));
+    if(memory == NULL)
+        return false;
+
+    fenwick_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_histogram_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    double minimum = 0;
+    size_t binCount = 0;
+    if(!histogram_medianwindow_detect(array, length, &minimum, &binCount))
+        return false;
+
+    char *memory = (char* ) malloc(histogram_medianwindow_est_mem(binCount));
+    if(memory == NULL)
+        return false;
+
+    histogram_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory, binCount,
+        minimum);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_histogram_medianwindow_u8(const uint8_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(histogram_medianwindow_est_mem(UINT8_MAX + 1));
+    if(memory == NULL)
+        return false;
+
+    histogram_medianwindow_process_u8(array, length, windowSize, steps, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_histogram_medianwindow_u16(const uint16_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    // 12-bit samples only need a 16th of the full histogram
+    uint16_t minimum = UINT16_MAX;
+    uint16_t maximum = 0;
+    for(size_t i = 0; i < length; i++) {
+        minimum = (array[i] < minimum) ? array[i] : minimum;
+        maximum = (array[i] > maximum) ? array[i] : maximum;
+    }
+
+    const size_t binCount = ((size_t) (maximum - minimum) + 1);
+    char *memory = (char* ) malloc(histogram_medianwindow_est_mem(binCount));
+    if(memory == NULL)
+        return false;
+
+    histogram_medianwindow_process_u16(array, length, windowSize, steps, result, memory, binCount, minimum);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_heap_medianwindow_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(medianwindow_est_mem_f32(windowSize));
+    if(memory == NULL)
+        return false;
+
+    heap_medianwindow_process_f32(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_tiny_medianwindow_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(SIZE_OF_TINY_MEDIAN_WINDOW_F32);
+    if(memory == NULL)
+        return false;
+
+    tiny_medianwindow_process_f32(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_heap_quantilewindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, size_t rank, MedianWindowInterpolation interpolation,
+    double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    char *memory = (char* ) malloc(medianwindow_est_mem(windowSize));
+    if(memory == NULL)
+        return false;
+
+    heap_quantilewindow_process(array, length, windowSize, steps, ignoreNaNWindows, quantile, rank, interpolation,
+        result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_quantiles_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *restrict result) {
+    if((!medianwindow_valid_input(array, length, windowSize, steps, result)) || (quantiles == NULL)
+        || (numQuantiles == 0))
+        return false;
+
+    // Below QUANTILES_MEDIANWINDOW_TREE_THRESHOLD quantiles, a double-heap per quantile beats the tree on big windows
+    const bool useTree = (numQuantiles >= QUANTILES_MEDIANWINDOW_TREE_THRESHOLD);
+    char *memory = (char* ) malloc(useTree ? quantiles_medianwindow_est_mem(windowSize, numQuantiles) :
+        (aligned_size(numQuantiles * sizeof(MedianWindow*)) + medianwindow_pack_size(numQuantiles, windowSize)));
+    if(memory == NULL)
+        return false;
+
+    if(useTree)
+        quantiles_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, quantiles, numQuantiles,
+            interpolation, result, memory);
+    else
+        heap_quantiles_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, quantiles,
+            numQuantiles, interpolation, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_mad_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict medianResult, double *restrict madResult) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, madResult))
+        return false;
+
+    char *memory = (char* ) malloc(mad_medianwindow_est_mem(windowSize));
+    if(memory == NULL)
+        return false;
+
+    mad_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, medianResult, madResult, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_iqr_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *restrict result) {
+    if(!medianwindow_valid_input(array, length, windowSize, steps, result))
+        return false;
+
+    char *memory = (char* ) malloc(iqr_medianwindow_est_mem(windowSize));
+    if(memory == NULL)
+        return false;
+
+    iqr_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, interpolation, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_hampel_medianwindow(const double *restrict array, size_t length, size_t halfWindow, double threshold,
+    bool ignoreNaNWindows, double *restrict result, uint8_t *restrict outlierMask) {
+    // The first check keeps 2 * halfWindow + 1 from overflowing, !(threshold >= 0) also rejects NaN
+    if((array == NULL) || (result == NULL) || (halfWindow == 0) || (halfWindow > (length / 2))
+        || (!medianwindow_valid_window(length, ((2 * halfWindow) + 1), 1)) || (!(threshold >= 0)))
+        return false;
+
+    char *memory = (char* ) malloc(hampel_medianwindow_est_mem(halfWindow));
+    if(memory == NULL)
+        return false;
+
+    Hampel_MedianWindow *window;
+    char *windowMemory = memory;
+    hampel_medianwindow_initialize(&windowMemory, halfWindow, threshold, ignoreNaNWindows, &window);
+    hampel_medianwindow_filter(window, array, length, result, outlierMask);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_heap_medianwindow_i32(const int32_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(medianwindow_est_mem_i32(windowSize));
+    if(memory == NULL)
+        return false;
+
+    heap_medianwindow_process_i32(array, length, windowSize, steps, averaging, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_tiny_medianwindow_i32(const int32_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(SIZE_OF_TINY_MEDIAN_WINDOW_I32);
+    if(memory == NULL)
+        return false;
+
+    tiny_integer_medianwindow_process_i32(array, length, windowSize, steps, averaging, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_heap_medianwindow_i64(const int64_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(medianwindow_est_mem_i64(windowSize));
+    if(memory == NULL)
+        return false;
+
+    heap_medianwindow_process_i64(array, length, windowSize, steps, averaging, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+bool sliding_tiny_medianwindow_i64(const int64_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *restrict result) {
+    if((array == NULL) || (result == NULL) || (!medianwindow_valid_window(length, windowSize, steps)))
+        return false;
+
+    char *memory = (char* ) malloc(SIZE_OF_TINY_MEDIAN_WINDOW_I64);
+    if(memory == NULL)
+        return false;
+
+    tiny_integer_medianwindow_process_i64(array, length, windowSize, steps, averaging, result, memory);
+    free(memory);
+    memory = NULL;
+    return true;
+}
+
+size_t medianwindow_engine_est_mem(MedianWindowEngine engine, size_t windowSize) {
+    switch (engine) {
+        case MEDIANWINDOW_ENGINE_TINY:
+            return SIZE_OF_TINY_MEDIAN_WINDOW;
+        case MEDIANWINDOW_ENGINE_SELECT:
+            return select_medianwindow_est_mem(windowSize);
+        case MEDIANWINDOW_ENGINE_SORTED:
+            return sorted_medianwindow_est_mem(windowSize);
+        default:
+            return medianwindow_est_mem(windowSize);
+    }
+}
+
+size_t medianwindow_engines_est_mem(size_t windowSize) {
+    // The memory that fits every engine the cost model may choose
+    const MedianWindowEngine engines[] = { MEDIANWINDOW_ENGINE_TINY, MEDIANWINDOW_ENGINE_HEAP,
+        MEDIANWINDOW_ENGINE_SELECT, MEDIANWINDOW_ENGINE_SORTED };
+    const size_t numEngines = (sizeof(engines) / sizeof(engines[0]));
+
+    size_t neededMemory = 0;
+    for(size_t i = 0; i < numEngines; i++) {
+        const size_t engineMemory = medianwindow_engine_est_mem(engines[i], windowSize);
+        neededMemory = (engineMemory > neededMemory) ? engineMemory : neededMemory;
+    }
+
+    return neededMemory;
+}
+
+void medianwindow_engine_process(MedianWindowEngine engine, double *restrict array, size_t length,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, double *restrict result, char *memory) {
+    switch (engine) {
+        case MEDIANWINDOW_ENGINE_TINY:
+            tiny_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+            break;
+        case MEDIANWINDOW_ENGINE_SELECT:
+            select_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+            break;
+        case MEDIANWINDOW_ENGINE_SORTED:
+            sorted_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+            break;
+        default:
+            heap_medianwindow_process(array, length, windowSize, steps, ignoreNaNWindows, result, memory);
+            break;
+    }
+}
+
+static void heap_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory) {
     MedianWindow *window;
     medianwindow_initialize(&memory, windowSize, steps, ignoreNaNWindows, &window);
 
@@ -35,78 +483,296 @@ bool sliding_heap_medianwindow(double *restrict array, size_t length, size_t win
             }
         }
     }
-
-    free(startMemPtr);
-    startMemPtr = NULL;
-    memory = NULL;
-    return true;
 }
 
-bool sliding_tiny_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
-    bool ignoreNaNWindows, double *restrict result) {
-    if(!valid_window(array, length, windowSize, steps, result))
-        return false;
-
-    char *memory = malloc(SIZE_OF_TINY_MEDIAN_WINDOW);
-    if(memory == NULL)
-        return false;
-
-    char *startPtr = memory;
+static void tiny_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory) {
     Tiny_MedianWindow *window;
     tiny_medianwindow_initialize(&memory, windowSize, steps, ignoreNaNWindows, &window);
+    tiny_medianwindow_results(window, array, length, result);
+}
+
+static void heap_medianwindow_process_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result, char *memory) {
+    MedianWindow_F32 *window;
+    medianwindow_initialize_f32(&memory, windowSize, steps, ignoreNaNWindows, &window);
 
     for(size_t i = 0; i < length; i++) {
-        if(tiny_medianwindow_full(window))
-            tiny_medianwindow_move_tail(window);
+        if(median_window_full_f32(window)) {
+            medianwindow_updateOld_f32(window, array[i]);
+            if(median_window_steps_reached_f32(window)) {
+                medianwindow_result_f32(window, result);
+                result++;
+            }
+        } else {
+            medianwindow_addNew_f32(window, array[i]);
+            if(median_window_full_f32(window)) {
+                medianwindow_result_f32(window, result);
+                result++;
+            }
+        }
+    }
+}
+
+static void tiny_medianwindow_process_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result, char *memory) {
+    Tiny_MedianWindow_F32 *window;
+    tiny_medianwindow_initialize_f32(&memory, windowSize, steps, ignoreNaNWindows, &window);
+    tiny_medianwindow_results_f32(window, array, length, result);
+}
+
+static void heap_quantilewindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, size_t rank, MedianWindowInterpolation interpolation,
+    double *restrict result, char *memory) {
+    MedianWindow *window;
+    medianwindow_initialize_quantile(&memory, windowSize, steps, ignoreNaNWindows, quantile, rank, &window);
 
-        tiny_medianwindow_move_head(window);
-        if((tiny_medianwindow_full(window)) && (tiny_medianwindow_steps_reached(window))) {
-            tiny_medianwindow_result(window, array, result);
-            result++;
+    for(size_t i = 0; i < length; i++) {
+        if(median_window_full(window)) {
+            medianwindow_updateOld(window, array[i]);
+            if(median_window_steps_reached(window)) {
+                medianwindow_quantile_result(window, interpolation, result);
+                result++;
+            }
+        } else {
+            medianwindow_addNew(window, array[i]);
+            if(median_window_full(window)) {
+                medianwindow_quantile_result(window, interpolation, result);
+                result++;
+            }
         }
     }
+}
 
-    free(startPtr);
-    startPtr = NULL;
-    memory = NULL;
-    return true;
+static void heap_medianwindow_process_i32(const int32_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int32_t *restrict result, char *memory) {
+    MedianWindow_I32 *window;
+    medianwindow_initialize_i32(&memory, windowSize, steps, false, &window);
+
+    for(size_t i = 0; i < length; i++) {
+        if(median_window_full_i32(window)) {
+            medianwindow_updateOld_i32(window, array[i]);
+            if(median_window_steps_reached_i32(window)) {
+                medianwindow_result_i32(window, averaging, result);
+                result++;
+            }
+        } else {
+            medianwindow_addNew_i32(window, array[i]);
+            if(median_window_full_i32(window)) {
+                medianwindow_result_i32(window, averaging, result);
+                result++;
+            }
+        }
+    }
 }
 
-static bool valid_window(double *array, size_t length, size_t windowSize, size_t steps, double *result) {
-    if((array == NULL) || (length == 0) || (result == NULL))
-        return false;
+static void heap_medianwindow_process_i64(const int64_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int64_t *restrict result, char *memory) {
+    MedianWindow_I64 *window;
+    medianwindow_initialize_i64(&memory, windowSize, steps, false, &window);
 
-    if((windowSize > length) || (windowSize <= 1) || (steps >= (length - windowSize)) || (steps == 0))
-        return false;
+    for(size_t i = 0; i < length; i++) {
+        if(median_window_full_i64(window)) {
+            medianwindow_updateOld_i64(window, array[i]);
+            if(median_window_steps_reached_i64(window)) {
+                medianwindow_result_i64(window, averaging, result);
+                result++;
+            }
+        } else {
+            medianwindow_addNew_i64(window, array[i]);
+            if(median_window_full_i64(window)) {
+                medianwindow_result_i64(window, averaging, result);
+                result++;
+            }
+        }
+    }
+}
 
-    return true;
+static void tiny_integer_medianwindow_process_i32(const int32_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int32_t *restrict result, char *memory) {
+    Tiny_MedianWindow_I32 *window;
+    tiny_medianwindow_initialize_i32(&memory, windowSize, steps, averaging, &window);
+    tiny_medianwindow_results_i32(window, array, length, result);
 }
 
-static inline bool median_window_full(MedianWindow *window) {
-    return (window->currentSize == window->windowSize);
+static void tiny_integer_medianwindow_process_i64(const int64_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, MedianWindowAveraging averaging, int64_t *restrict result, char *memory) {
+    Tiny_MedianWindow_I64 *window;
+    tiny_medianwindow_initialize_i64(&memory, windowSize, steps, averaging, &window);
+    tiny_medianwindow_results_i64(window, array, length, result);
 }
 
-static inline bool median_window_steps_reached(MedianWindow *window) {
-    if(window->stepDistance == 0) {
-        window->stepDistance = window->steps - 1;
-        return true;
+static void select_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory) {
+    Select_MedianWindow *window;
+    select_medianwindow_initialize(&memory, windowSize, ignoreNaNWindows, &window);
+
+    // Every window is selected on its own, the elements skipped between two windows are never touched
+    for(size_t start = 0; (start + windowSize) <= length; start += steps) {
+        select_medianwindow_result(window, &array[start], result);
+        result++;
     }
+}
 
-    window->stepDistance -= 1;
-    return false;
+static void sorted_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory) {
+    Sorted_MedianWindow *window;
+    sorted_medianwindow_initialize(&memory, windowSize, ignoreNaNWindows, &window);
+
+    // The outgoing value is still available in the input, so the window does not need a ring of its own
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        sorted_medianwindow_add(window, array[i]),
+        sorted_medianwindow_replace(window, array[i - windowSize], array[i]),
+        { sorted_medianwindow_result(window, result); result++; })
+}
+
+static void quantiles_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *restrict result, char *memory) {
+    Quantiles_MedianWindow *window;
+    quantiles_medianwindow_initialize(&memory, windowSize, ignoreNaNWindows, quantiles, numQuantiles, interpolation,
+        &window);
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        quantiles_medianwindow_add(window, array[i]),
+        quantiles_medianwindow_replace(window, array[i - windowSize], array[i]),
+        { quantiles_medianwindow_result(window, result); result += numQuantiles; })
+}
+
+static void mad_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict medianResult, double *restrict madResult, char *memory) {
+    Mad_MedianWindow *window;
+    mad_medianwindow_initialize(&memory, windowSize, ignoreNaNWindows, &window);
+
+    // Without medianResult, every median is written to the same slot
+    double median;
+    double *medianTarget = (medianResult != NULL) ? medianResult : &median;
+    const size_t medianStep = (medianResult != NULL) ? 1 : 0;
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        mad_medianwindow_add(window, array[i]),
+        mad_medianwindow_replace(window, array[i - windowSize], array[i]),
+        { mad_medianwindow_result(window, medianTarget, madResult); medianTarget += medianStep; madResult++; })
 }
 
-static inline bool tiny_medianwindow_full(Tiny_MedianWindow *window) {
-    const size_t currentSize = (window->headPtr - window->tailPtr);
-    return (currentSize == (size_t) window->windowSize);
+static void iqr_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *restrict result, char *memory) {
+    Iqr_MedianWindow *window;
+    iqr_medianwindow_initialize(&memory, windowSize, ignoreNaNWindows, interpolation, &window);
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        iqr_medianwindow_add(window, array[i]),
+        iqr_medianwindow_replace(window, array[i]),
+        { iqr_medianwindow_result(window, result); result++; })
 }
 
-static inline bool tiny_medianwindow_steps_reached(Tiny_MedianWindow *window) {
-    if(window->stepDistance == 0) {
-        window->stepDistance = window->steps - 1;
-        return true;
+static void heap_quantiles_medianwindow_process(double *restrict array, size_t length, size_t windowSize,
+    size_t steps, bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles,
+    MedianWindowInterpolation interpolation, double *restrict result, char *memory) {
+    // The windows take the input block by block, so a block is read from the cache by all but the first window
+    // while every window keeps its heaps to itself for a whole block
+    MedianWindow **windows = (MedianWindow** ) __builtin_assume_aligned(memory, STD_ALIGNMENT);
+    memory += aligned_size(numQuantiles * sizeof(MedianWindow*));
+    for(size_t k = 0; k < numQuantiles; k++)
+        medianwindow_initialize_quantile(&memory, windowSize, steps, ignoreNaNWindows, quantiles[k], 0, &windows[k]);
+
+    size_t numResults = 0;
+    for(size_t blockStart = 0; blockStart < length; blockStart += QUANTILES_MEDIANWINDOW_BLOCK_SIZE) {
+        const size_t blockEnd = ((length - blockStart) > QUANTILES_MEDIANWINDOW_BLOCK_SIZE) ?
+            (blockStart + QUANTILES_MEDIANWINDOW_BLOCK_SIZE) : length;
+        size_t blockResults = 0;
+        for(size_t k = 0; k < numQuantiles; k++) {
+            MedianWindow *window = windows[k];
+            double *output = &result[(numResults * numQuantiles) + k];
+            blockResults = 0;
+            for(size_t i = blockStart; i < blockEnd; i++) {
+                if(median_window_full(window)) {
+                    medianwindow_updateOld(window, array[i]);
+                    if(median_window_steps_reached(window)) {
+                        medianwindow_quantile_result(window, interpolation, output);
+                        output += numQuantiles;
+                        blockResults++;
+                    }
+                } else {
+                    medianwindow_addNew(window, array[i]);
+                    if(median_window_full(window)) {
+                        medianwindow_quantile_result(window, interpolation, output);
+                        output += numQuantiles;
+                        blockResults++;
+                    }
+                }
+            }
+        }
+        numResults += blockResults;
     }
+}
+
+static void fenwick_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory) {
+    Fenwick_MedianWindow *window;
+    fenwick_medianwindow_initialize(&memory, array, length, ignoreNaNWindows, &window);
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        fenwick_medianwindow_add(window, i),
+        fenwick_medianwindow_replace(window, (i - windowSize), i),
+        { fenwick_medianwindow_result(window, result); result++; })
+}
+
+static void histogram_medianwindow_process(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *memory, size_t binCount, double minimum) {
+    Histogram_MedianWindow *window;
+    histogram_medianwindow_initialize(&memory, binCount, minimum, ignoreNaNWindows, &window);
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        histogram_medianwindow_add(window, histogram_bin(array[i], minimum)),
+        histogram_medianwindow_replace(window, histogram_bin(array[i - windowSize], minimum),
+            histogram_bin(array[i], minimum)),
+        { histogram_medianwindow_result(window, result); result++; })
+}
+
+static void histogram_medianwindow_process_u8(const uint8_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result, char *memory) {
+    Histogram_MedianWindow *window;
+    histogram_medianwindow_initialize(&memory, (UINT8_MAX + 1), 0, false, &window);
 
-    window->stepDistance -= 1;
-    return false;
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        histogram_medianwindow_add(window, array[i]),
+        histogram_medianwindow_replace(window, array[i - windowSize], array[i]),
+        { histogram_medianwindow_result(window, result); result++; })
+}
+
+static void histogram_medianwindow_process_u16(const uint16_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result, char *memory, size_t binCount, uint16_t minimum) {
+    Histogram_MedianWindow *window;
+    histogram_medianwindow_initialize(&memory, binCount, (double) minimum, false, &window);
+
+    SLIDING_WINDOW_LOOP(windowSize, length, steps,
+        histogram_medianwindow_add(window, (uint32_t) (array[i] - minimum)),
+        histogram_medianwindow_replace(window, (uint32_t) (array[i - windowSize] - minimum),
+            (uint32_t) (array[i] - minimum)),
+        { histogram_medianwindow_result(window, result); result++; })
+}
+
+static inline uint32_t histogram_bin(double value, double minimum) {
+    return isnan(value) ? HISTOGRAM_NAN_BIN : (uint32_t) (value - minimum);
+}
+
+bool medianwindow_valid_input(double *array, size_t length, size_t windowSize, size_t steps, double *result) {
+    if((array == NULL) || (result == NULL))
+        return false;
+
+    return medianwindow_valid_window(length, windowSize, steps);
+}
+
+bool medianwindow_valid_window(size_t length, size_t windowSize, size_t steps) {
+    if(length == 0)
+        return false;
+
+    if((windowSize > length) || (windowSize <= 1) || (steps >= (length - windowSize)) || (steps == 0))
+        return false;
+
+    if(windowSize > MEDIANWINDOW_MAX_WINDOWSIZE)
+        return false;
+
+    return true;
 }
@@ -4,7 +4,17 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "tiny_medianwindow.h"
+#include "tiny_integer_medianwindow.h"
 #include "median_window.h"
+#include "select_medianwindow.h"
+#include "sorted_medianwindow.h"
+#include "quantiles_medianwindow.h"
+#include "mad_medianwindow.h"
+#include "hampel_medianwindow.h"
+#include "iqr_medianwindow.h"
+#include "fenwick_medianwindow.h"
+#include "histogram_medianwindow.h"
+#include "medianwindow_api.h"
 
 bool sliding_heap_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, double *restrict result);
@@ -12,4 +22,90 @@ bool sliding_heap_medianwindow(double *restrict array, size_t length, size_t win
 bool sliding_tiny_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, double *restrict result);
 
+bool sliding_select_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result);
+
+bool sliding_sorted_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result);
+
+// Offline only: the memory depends on the input length, so there is no workspace variant
+bool sliding_fenwick_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result);
+
+bool sliding_heap_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace);
+
+bool sliding_tiny_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace);
+
+bool sliding_select_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace);
+
+bool sliding_sorted_medianwindow_ws(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result, char *restrict workspace);
+
+// Offline only: the memory depends on the range of the values. Returns false unless all valid values are integers
+// of a range of at most HISTOGRAM_MAX_BINS (see histogram_medianwindow_detect)
+bool sliding_histogram_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict result);
+
+bool sliding_histogram_medianwindow_u8(const uint8_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result);
+
+bool sliding_histogram_medianwindow_u16(const uint16_t *restrict array, size_t length, size_t windowSize,
+    size_t steps, double *restrict result);
+
+// Float counterparts of the heap and the tiny engine, which keep the input and the output in float
+bool sliding_heap_medianwindow_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result);
+
+bool sliding_tiny_medianwindow_f32(float *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *restrict result);
+
+// The double-heap split at a quantile, or at the rank-th smallest value if rank is not 0
+bool sliding_heap_quantilewindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, size_t rank, MedianWindowInterpolation interpolation,
+    double *restrict result);
+
+// Several quantiles per window from one order-statistic B+-tree or, for fewer than
+// QUANTILES_MEDIANWINDOW_TREE_THRESHOLD quantiles, from a double-heap each. result holds numQuantiles values
+// per window.
+bool sliding_quantiles_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *restrict result);
+
+// The median absolute deviation of every window and, unless medianResult is NULL, its median
+bool sliding_mad_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *restrict medianResult, double *restrict madResult);
+
+// The third minus the first quartile of every window, both taken from the double-heaps of iqr_medianwindow.c
+bool sliding_iqr_medianwindow(double *restrict array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *restrict result);
+
+// The Hampel filter over the centred windows of 2 * halfWindow + 1 values, see hampel_medianwindow_filter
+bool sliding_hampel_medianwindow(const double *restrict array, size_t length, size_t halfWindow, double threshold,
+    bool ignoreNaNWindows, double *restrict result, uint8_t *restrict outlierMask);
+
+// Integer counterparts of the heap and the tiny engine, see MedianWindowAveraging for even window sizes
+bool sliding_heap_medianwindow_i32(const int32_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *restrict result);
+
+bool sliding_tiny_medianwindow_i32(const int32_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *restrict result);
+
+bool sliding_heap_medianwindow_i64(const int64_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *restrict result);
+
+bool sliding_tiny_medianwindow_i64(const int64_t *restrict array, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *restrict result);
+
+bool medianwindow_valid_input(double *array, size_t length, size_t windowSize, size_t steps, double *result);
+bool medianwindow_valid_window(size_t length, size_t windowSize, size_t steps);
+
+// The engine functions below do not validate their input and expect a resolved engine (not AUTO)
+size_t medianwindow_engine_est_mem(MedianWindowEngine engine, size_t windowSize);
+size_t medianwindow_engines_est_mem(size_t windowSize);
+void medianwindow_engine_process(MedianWindowEngine engine, double *restrict array, size_t length,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, double *restrict result, char *memory);
+
 #endif
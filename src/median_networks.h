@@ -0,0 +1,294 @@
+#ifndef MEDIAN_NETWORKS_H
+#define MEDIAN_NETWORKS_H
+
+// Comparator lists of the networks. Every entry COMPARATOR(a, b) orders the values at the positions a and b,
+// so the same network can be expanded for a single window (scalar) or for consecutive windows (vectors).
+// The networks of even window sizes leave both middle values at (windowSize / 2) - 1 and windowSize / 2, but not
+// necessarily in order.
+
+#define MEDIAN_NETWORK_2(COMPARATOR) \
+    COMPARATOR(0, 1)
+
+#define MEDIAN_NETWORK_3(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(1, 2) COMPARATOR(0, 1)
+
+#define MEDIAN_NETWORK_4(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(0, 2) COMPARATOR(1, 3)
+
+#define MEDIAN_NETWORK_5(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(0, 2) COMPARATOR(1, 3) \
+    COMPARATOR(2, 4) COMPARATOR(1, 2) COMPARATOR(2, 4)
+
+#define MEDIAN_NETWORK_6(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(4, 5) COMPARATOR(0, 5) COMPARATOR(1, 3) \
+    COMPARATOR(2, 4) COMPARATOR(0, 2) COMPARATOR(1, 4) COMPARATOR(3, 5) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4)
+
+#define SORTING_NETWORK_6(COMPARATOR) \
+    COMPARATOR(0, 3) COMPARATOR(1, 4) COMPARATOR(2, 5) COMPARATOR(0, 2) \
+    COMPARATOR(3, 5) COMPARATOR(1, 3) COMPARATOR(2, 4) COMPARATOR(0, 1) \
+    COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(1, 2) COMPARATOR(3, 4)
+
+#define MEDIAN_NETWORK_7(COMPARATOR) \
+    COMPARATOR(0, 6) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(0, 2) \
+    COMPARATOR(1, 4) COMPARATOR(3, 5) COMPARATOR(0, 1) COMPARATOR(2, 5) \
+    COMPARATOR(4, 6) COMPARATOR(1, 3) COMPARATOR(2, 4) COMPARATOR(3, 4) \
+    COMPARATOR(2, 3)
+
+#define MEDIAN_NETWORK_8(COMPARATOR) \
+    COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) \
+    COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) \
+    COMPARATOR(0, 1) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 7) \
+    COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(1, 4) COMPARATOR(3, 6)
+
+#define SORTING_NETWORK_8(COMPARATOR) \
+    COMPARATOR(0, 5) COMPARATOR(1, 3) COMPARATOR(2, 7) COMPARATOR(4, 6) \
+    COMPARATOR(0, 2) COMPARATOR(1, 4) COMPARATOR(3, 6) COMPARATOR(5, 7) \
+    COMPARATOR(0, 1) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 7) \
+    COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(2, 3) COMPARATOR(4, 5) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6)
+
+// The networks for the window sizes 9 to 25 are Batcher's odd-even merge sort networks (built for the next power
+// of two, without the comparators of the missing positions), reduced to the comparators the median depends on.
+// They were verified for all 0-1 inputs.
+#define MEDIAN_NETWORK_9(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(0, 2) COMPARATOR(1, 3) \
+    COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(0, 4) COMPARATOR(1, 5) \
+    COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(1, 2) COMPARATOR(3, 4) \
+    COMPARATOR(5, 6) COMPARATOR(0, 8) COMPARATOR(4, 8) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(3, 4)
+
+#define MEDIAN_NETWORK_10(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(0, 2) \
+    COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(0, 4) \
+    COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(1, 2) \
+    COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(4, 8) COMPARATOR(5, 9) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(3, 4) COMPARATOR(5, 6)
+
+#define MEDIAN_NETWORK_11(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(0, 2) \
+    COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(1, 2) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(2, 4) \
+    COMPARATOR(3, 5) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(0, 8) \
+    COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(3, 5) \
+    COMPARATOR(6, 8) COMPARATOR(5, 6)
+
+#define MEDIAN_NETWORK_12(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) \
+    COMPARATOR(3, 7) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 8) \
+    COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(5, 6)
+
+#define MEDIAN_NETWORK_13(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) \
+    COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(1, 2) \
+    COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(0, 8) COMPARATOR(1, 9) \
+    COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) \
+    COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(5, 6)
+
+#define MEDIAN_NETWORK_14(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) \
+    COMPARATOR(9, 11) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(0, 4) COMPARATOR(1, 5) \
+    COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(2, 4) COMPARATOR(3, 5) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) \
+    COMPARATOR(11, 12) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) \
+    COMPARATOR(5, 13) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(3, 5) \
+    COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(5, 6) COMPARATOR(7, 8)
+
+#define MEDIAN_NETWORK_15(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) \
+    COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) \
+    COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) \
+    COMPARATOR(10, 14) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) \
+    COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(0, 8) \
+    COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) \
+    COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(6, 8) COMPARATOR(7, 9) \
+    COMPARATOR(7, 8)
+
+#define MEDIAN_NETWORK_16(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) \
+    COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(1, 2) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) \
+    COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(2, 4) COMPARATOR(3, 5) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) \
+    COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) \
+    COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) \
+    COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(7, 8)
+
+#define MEDIAN_NETWORK_17(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) \
+    COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(1, 2) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) \
+    COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(2, 4) COMPARATOR(3, 5) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) \
+    COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) \
+    COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) \
+    COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) COMPARATOR(9, 10) \
+    COMPARATOR(11, 12) COMPARATOR(0, 16) COMPARATOR(8, 16) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) \
+    COMPARATOR(7, 11) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(7, 8)
+
+#define MEDIAN_NETWORK_18(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) \
+    COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(1, 2) \
+    COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) \
+    COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(2, 4) \
+    COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) \
+    COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) \
+    COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) \
+    COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) \
+    COMPARATOR(7, 8) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(8, 16) \
+    COMPARATOR(9, 17) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) \
+    COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(7, 8) COMPARATOR(9, 10)
+
+#define MEDIAN_NETWORK_19(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) \
+    COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(16, 18) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(0, 4) \
+    COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) \
+    COMPARATOR(11, 15) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) \
+    COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) \
+    COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) \
+    COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(7, 8) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(17, 18) \
+    COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) COMPARATOR(8, 16) COMPARATOR(9, 17) COMPARATOR(10, 18) \
+    COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(7, 9) COMPARATOR(10, 12) \
+    COMPARATOR(9, 10)
+
+#define MEDIAN_NETWORK_20(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(0, 2) COMPARATOR(1, 3) \
+    COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) \
+    COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) \
+    COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) \
+    COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) \
+    COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) \
+    COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) \
+    COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(17, 18) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) \
+    COMPARATOR(3, 19) COMPARATOR(8, 16) COMPARATOR(9, 17) COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(5, 9) \
+    COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(9, 10)
+
+#define MEDIAN_NETWORK_21(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(0, 2) COMPARATOR(1, 3) \
+    COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) COMPARATOR(13, 15) \
+    COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) \
+    COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(16, 20) COMPARATOR(2, 4) COMPARATOR(3, 5) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(0, 8) \
+    COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) \
+    COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) \
+    COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) COMPARATOR(9, 10) COMPARATOR(11, 12) \
+    COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) COMPARATOR(3, 19) \
+    COMPARATOR(4, 20) COMPARATOR(8, 16) COMPARATOR(9, 17) COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(12, 20) \
+    COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(7, 9) COMPARATOR(10, 12) \
+    COMPARATOR(9, 10)
+
+#define MEDIAN_NETWORK_22(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(20, 21) COMPARATOR(0, 2) \
+    COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) \
+    COMPARATOR(13, 15) COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) \
+    COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) \
+    COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(16, 20) COMPARATOR(17, 21) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) \
+    COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) \
+    COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) \
+    COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) COMPARATOR(1, 2) COMPARATOR(3, 4) \
+    COMPARATOR(5, 6) COMPARATOR(7, 8) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) \
+    COMPARATOR(19, 20) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) COMPARATOR(3, 19) COMPARATOR(4, 20) \
+    COMPARATOR(5, 21) COMPARATOR(8, 16) COMPARATOR(9, 17) COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(12, 20) \
+    COMPARATOR(13, 21) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(13, 17) \
+    COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(9, 10) COMPARATOR(11, 12)
+
+#define MEDIAN_NETWORK_23(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(20, 21) COMPARATOR(0, 2) \
+    COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) COMPARATOR(12, 14) \
+    COMPARATOR(13, 15) COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(20, 22) COMPARATOR(1, 2) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(21, 22) COMPARATOR(0, 4) COMPARATOR(1, 5) \
+    COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) COMPARATOR(10, 14) COMPARATOR(11, 15) \
+    COMPARATOR(16, 20) COMPARATOR(17, 21) COMPARATOR(18, 22) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) \
+    COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) \
+    COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) \
+    COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) \
+    COMPARATOR(18, 20) COMPARATOR(19, 21) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) \
+    COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) COMPARATOR(3, 19) COMPARATOR(4, 20) COMPARATOR(5, 21) \
+    COMPARATOR(6, 22) COMPARATOR(8, 16) COMPARATOR(9, 17) COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(12, 20) \
+    COMPARATOR(13, 21) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(13, 17) COMPARATOR(10, 12) \
+    COMPARATOR(11, 13) COMPARATOR(11, 12)
+
+#define MEDIAN_NETWORK_24(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(20, 21) COMPARATOR(22, 23) \
+    COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) \
+    COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(20, 22) COMPARATOR(21, 23) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(21, 22) \
+    COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) \
+    COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(16, 20) COMPARATOR(17, 21) COMPARATOR(18, 22) COMPARATOR(19, 23) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) \
+    COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(4, 8) \
+    COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(6, 8) \
+    COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) COMPARATOR(1, 2) \
+    COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) \
+    COMPARATOR(3, 19) COMPARATOR(4, 20) COMPARATOR(5, 21) COMPARATOR(6, 22) COMPARATOR(7, 23) COMPARATOR(8, 16) \
+    COMPARATOR(9, 17) COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(12, 20) COMPARATOR(13, 21) COMPARATOR(6, 10) \
+    COMPARATOR(7, 11) COMPARATOR(12, 16) COMPARATOR(13, 17) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(11, 12)
+
+#define MEDIAN_NETWORK_25(COMPARATOR) \
+    COMPARATOR(0, 1) COMPARATOR(2, 3) COMPARATOR(4, 5) COMPARATOR(6, 7) COMPARATOR(8, 9) COMPARATOR(10, 11) \
+    COMPARATOR(12, 13) COMPARATOR(14, 15) COMPARATOR(16, 17) COMPARATOR(18, 19) COMPARATOR(20, 21) COMPARATOR(22, 23) \
+    COMPARATOR(0, 2) COMPARATOR(1, 3) COMPARATOR(4, 6) COMPARATOR(5, 7) COMPARATOR(8, 10) COMPARATOR(9, 11) \
+    COMPARATOR(12, 14) COMPARATOR(13, 15) COMPARATOR(16, 18) COMPARATOR(17, 19) COMPARATOR(20, 22) COMPARATOR(21, 23) \
+    COMPARATOR(1, 2) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(21, 22) \
+    COMPARATOR(0, 4) COMPARATOR(1, 5) COMPARATOR(2, 6) COMPARATOR(3, 7) COMPARATOR(8, 12) COMPARATOR(9, 13) \
+    COMPARATOR(10, 14) COMPARATOR(11, 15) COMPARATOR(16, 20) COMPARATOR(17, 21) COMPARATOR(18, 22) COMPARATOR(19, 23) \
+    COMPARATOR(2, 4) COMPARATOR(3, 5) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) COMPARATOR(19, 21) \
+    COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) \
+    COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) COMPARATOR(0, 8) COMPARATOR(1, 9) COMPARATOR(2, 10) \
+    COMPARATOR(3, 11) COMPARATOR(4, 12) COMPARATOR(5, 13) COMPARATOR(6, 14) COMPARATOR(7, 15) COMPARATOR(16, 24) \
+    COMPARATOR(4, 8) COMPARATOR(5, 9) COMPARATOR(6, 10) COMPARATOR(7, 11) COMPARATOR(20, 24) COMPARATOR(2, 4) \
+    COMPARATOR(3, 5) COMPARATOR(6, 8) COMPARATOR(7, 9) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(18, 20) \
+    COMPARATOR(19, 21) COMPARATOR(22, 24) COMPARATOR(1, 2) COMPARATOR(3, 4) COMPARATOR(5, 6) COMPARATOR(7, 8) \
+    COMPARATOR(9, 10) COMPARATOR(11, 12) COMPARATOR(13, 14) COMPARATOR(17, 18) COMPARATOR(19, 20) COMPARATOR(21, 22) \
+    COMPARATOR(23, 24) COMPARATOR(0, 16) COMPARATOR(1, 17) COMPARATOR(2, 18) COMPARATOR(3, 19) COMPARATOR(4, 20) \
+    COMPARATOR(5, 21) COMPARATOR(6, 22) COMPARATOR(7, 23) COMPARATOR(8, 24) COMPARATOR(8, 16) COMPARATOR(9, 17) \
+    COMPARATOR(10, 18) COMPARATOR(11, 19) COMPARATOR(12, 20) COMPARATOR(13, 21) COMPARATOR(6, 10) COMPARATOR(7, 11) \
+    COMPARATOR(12, 16) COMPARATOR(13, 17) COMPARATOR(10, 12) COMPARATOR(11, 13) COMPARATOR(11, 12)
+
+// Generators over every window size a network exists for, e.g. for the tables of the per-size functions
+#define TINY_MEDIANS_TABLE_ENTRY(windowSize, PREFIX, SUFFIX) [windowSize] = PREFIX##windowSize##SUFFIX,
+
+#define TINY_MEDIANS_ALL_SIZES(GENERATOR, ...) \
+    GENERATOR(2, __VA_ARGS__) GENERATOR(3, __VA_ARGS__) GENERATOR(4, __VA_ARGS__) GENERATOR(5, __VA_ARGS__) \
+    GENERATOR(6, __VA_ARGS__) GENERATOR(7, __VA_ARGS__) GENERATOR(8, __VA_ARGS__) GENERATOR(9, __VA_ARGS__) \
+    GENERATOR(10, __VA_ARGS__) GENERATOR(11, __VA_ARGS__) GENERATOR(12, __VA_ARGS__) GENERATOR(13, __VA_ARGS__) \
+    GENERATOR(14, __VA_ARGS__) GENERATOR(15, __VA_ARGS__) GENERATOR(16, __VA_ARGS__) GENERATOR(17, __VA_ARGS__) \
+    GENERATOR(18, __VA_ARGS__) GENERATOR(19, __VA_ARGS__) GENERATOR(20, __VA_ARGS__) GENERATOR(21, __VA_ARGS__) \
+    GENERATOR(22, __VA_ARGS__) GENERATOR(23, __VA_ARGS__) GENERATOR(24, __VA_ARGS__) GENERATOR(25, __VA_ARGS__)
+
+#endif
@@ -2,10 +2,20 @@
  * @file median_window.c
  * @author Jens Trappmann (jens.trappmann@icloud.com)
  * @brief This file implements a double-heap sliding median window.
+ *        Both heaps store their values inline, so heap operations compare contiguous values.
+ *        A parallel index array references the node of each heap value.
+ *        The file is written once for all value types: it is compiled as is for double values, and
+ *        median_window_f32.c, median_window_i32.c and median_window_i64.c compile it again with
+ *        MEDIANWINDOW_FLOAT, MEDIANWINDOW_INT32 or MEDIANWINDOW_INT64 defined.
+ *        Integer windows hold no NaN values and average the middle values of an even window as selected.
+ *        The split between both heaps is not bound to the middle of the window: a window of a quantile or a rank
+ *        keeps the values up to it in the max-heap, so its root (and the min-heap root) yields the quantile.
+ *        A window with a count split keeps a given number of values in the max-heap and moves its split by one
+ *        value at a time, which the median absolute deviation uses to follow both ends of a range of ranks.
  * @note The implementation follows the same general concept as other implementations,
  *       such as Bottleneck (https://github.com/pydata/bottleneck).
- * @version 0.3
- * @date 2025-12-30
+ * @version 0.8
+ * @date 2026-10-16
  *
  * @copyright Copyright (c) 2025
  *
@@ -13,65 +23,205 @@
 
 #include "median_window.h"
 
-static inline size_t maxheap_put(MedianWindow *restrict window, HeapNode *restrict targetNode);
-static void maxheap_heapifyUp(HeapNode *restrict *restrict maxHeapNodes, size_t position);
-static void maxheap_heapifyDown(HeapNode *restrict *restrict maxHeapNodes, size_t heapLength, size_t position);
-static void maxheap_largestChild(HeapNode *restrict *restrict maxHeapNodes, size_t heapLength, size_t position,
-    size_t *restrict childPosition);
-static inline size_t minheap_put(MedianWindow *restrict window, HeapNode *restrict targetNode);
-static void minheap_heapifyUp(HeapNode *restrict *restrict minHeapNodes, size_t position);
-static void minheap_heapifyDown(HeapNode *restrict *restrict minHeapNodes, size_t heapLength, size_t position);
-static void minheap_smallestChild(HeapNode *restrict *restrict minHeapNodes, size_t heapLength, size_t position,
-    size_t *restrict childPosition);
-static void heaps_rebalance(MedianWindow *restrict window);
+#if defined(MEDIANWINDOW_FLOAT)
+#define HEAP_VALUE float
+#define HEAP_WINDOW MedianWindow_F32
+#define HEAP_FUNCTION(name) name##_f32
+#elif defined(MEDIANWINDOW_INT32)
+#define HEAP_INTEGER_VALUES
+#define HEAP_VALUE int32_t
+#define HEAP_WINDOW MedianWindow_I32
+#define HEAP_FUNCTION(name) name##_i32
+#elif defined(MEDIANWINDOW_INT64)
+#define HEAP_INTEGER_VALUES
+#define HEAP_VALUE int64_t
+#define HEAP_WINDOW MedianWindow_I64
+#define HEAP_FUNCTION(name) name##_i64
+#else
+#define HEAP_VALUE double
+#define HEAP_WINDOW MedianWindow
+#define HEAP_FUNCTION(name) name
+#endif
+
+#ifdef HEAP_INTEGER_VALUES
+#define HEAP_IS_NAN(value) false
+#else
+#define HEAP_IS_NAN(value) isnan(value)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+// A vector holds twice as many float or int32 children, so the same children need half the vectors.
+// AVX2_SPREAD(op, vector) moves the max/min of all lanes into every lane.
+#if defined(MEDIANWINDOW_FLOAT)
+#define AVX2_LANES 8
+#define AVX512_LANES 16
+#define AVX2_VECTOR __m256
+#define AVX512_VECTOR __m512
+#define AVX2(name) _mm256_##name##_ps
+#define AVX512(name) _mm512_##name##_ps
+#define AVX2_LOAD(pointer) _mm256_loadu_ps(pointer)
+#define AVX512_LOAD(pointer) _mm512_loadu_ps(pointer)
+#define AVX2_FIRST _mm256_cvtss_f32
+#define AVX2_EQUAL_MASK(a, b) _mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_EQ_OQ))
+#define AVX512_EQUAL_MASK(a, b) _mm512_cmp_ps_mask((a), _mm512_set1_ps(b), _CMP_EQ_OQ)
+#define AVX2_SPREAD(op, vector) \
+    vector = AVX2(op)(vector, _mm256_permute2f128_ps(vector, vector, 0x01)); \
+    vector = AVX2(op)(vector, _mm256_permute_ps(vector, 0x4E)); \
+    vector = AVX2(op)(vector, _mm256_permute_ps(vector, 0xB1))
+#elif defined(MEDIANWINDOW_INT32)
+#define AVX2_LANES 8
+#define AVX512_LANES 16
+#define AVX2_VECTOR __m256i
+#define AVX512_VECTOR __m512i
+#define AVX2(name) _mm256_##name##_epi32
+#define AVX512(name) _mm512_##name##_epi32
+#define AVX2_LOAD(pointer) _mm256_loadu_si256((const __m256i* ) (pointer))
+#define AVX512_LOAD(pointer) _mm512_loadu_si512(pointer)
+#define AVX2_FIRST _mm256_cvtsi256_si32
+#define AVX2_EQUAL_MASK(a, b) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32((a), (b))))
+#define AVX512_EQUAL_MASK(a, b) _mm512_cmpeq_epi32_mask((a), _mm512_set1_epi32(b))
+#define AVX2_SPREAD(op, vector) \
+    vector = AVX2(op)(vector, _mm256_permute2x128_si256(vector, vector, 0x01)); \
+    vector = AVX2(op)(vector, _mm256_shuffle_epi32(vector, 0x4E)); \
+    vector = AVX2(op)(vector, _mm256_shuffle_epi32(vector, 0xB1))
+#elif defined(MEDIANWINDOW_INT64)
+// AVX2 has no max/min of 64-bit integers, so only AVX-512 selects int64 children with vectors
+#define AVX512_LANES 8
+#define AVX512_VECTOR __m512i
+#define AVX512(name) _mm512_##name##_epi64
+#define AVX512_LOAD(pointer) _mm512_loadu_si512(pointer)
+#define AVX512_EQUAL_MASK(a, b) _mm512_cmpeq_epi64_mask((a), _mm512_set1_epi64(b))
+#else
+#define AVX2_LANES 4
+#define AVX512_LANES 8
+#define AVX2_VECTOR __m256d
+#define AVX512_VECTOR __m512d
+#define AVX2(name) _mm256_##name##_pd
+#define AVX512(name) _mm512_##name##_pd
+#define AVX2_LOAD(pointer) _mm256_loadu_pd(pointer)
+#define AVX512_LOAD(pointer) _mm512_loadu_pd(pointer)
+#define AVX2_FIRST _mm256_cvtsd_f64
+#define AVX2_EQUAL_MASK(a, b) _mm256_movemask_pd(_mm256_cmp_pd((a), (b), _CMP_EQ_OQ))
+#define AVX512_EQUAL_MASK(a, b) _mm512_cmp_pd_mask((a), _mm512_set1_pd(b), _CMP_EQ_OQ)
+#define AVX2_SPREAD(op, vector) \
+    vector = AVX2(op)(vector, _mm256_permute2f128_pd(vector, vector, 0x01)); \
+    vector = AVX2(op)(vector, _mm256_permute_pd(vector, 0x05))
+#endif
+
+// Nodes with fewer children than lanes compare them faster with scalar code
+#if defined(AVX2_LANES) && (K_ARY_HEAP_CHILDREN >= AVX2_LANES)
+#define MEDIANWINDOW_AVX2_CHILD_SELECTION
+#define AVX2_CHILD_VECTORS (K_ARY_HEAP_CHILDREN / AVX2_LANES)
+#endif
+#if K_ARY_HEAP_CHILDREN >= AVX512_LANES
+#define MEDIANWINDOW_AVX512_CHILD_SELECTION
+#define AVX512_CHILD_VECTORS (K_ARY_HEAP_CHILDREN / AVX512_LANES)
+#endif
+#endif
+
+static inline size_t maxheap_put(HEAP_WINDOW *restrict window, size_t nodeIndex, HEAP_VALUE value);
+static void maxheap_heapifyUp(HEAP_WINDOW *restrict window, size_t position);
+static inline __attribute__((always_inline)) void maxheap_heapifyDown_impl(HEAP_WINDOW *restrict window,
+    size_t position, size_t (*largestChild) (const HEAP_VALUE *restrict, size_t, size_t, HEAP_VALUE));
+static void maxheap_heapifyDown(HEAP_WINDOW *restrict window, size_t position);
+static inline size_t maxheap_largestChild(const HEAP_VALUE *restrict maxHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value);
+static inline size_t minheap_put(HEAP_WINDOW *restrict window, size_t nodeIndex, HEAP_VALUE value);
+static void minheap_heapifyUp(HEAP_WINDOW *restrict window, size_t position);
+static inline __attribute__((always_inline)) void minheap_heapifyDown_impl(HEAP_WINDOW *restrict window,
+    size_t position, size_t (*smallestChild) (const HEAP_VALUE *restrict, size_t, size_t, HEAP_VALUE));
+static void minheap_heapifyDown(HEAP_WINDOW *restrict window, size_t position);
+static inline size_t minheap_smallestChild(const HEAP_VALUE *restrict minHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value);
+static void heaps_set_heapify_down_functions(HEAP_WINDOW *restrict window);
+#ifdef MEDIANWINDOW_AVX2_CHILD_SELECTION
+static void maxheap_heapifyDown_avx2(HEAP_WINDOW *restrict window, size_t position);
+static void minheap_heapifyDown_avx2(HEAP_WINDOW *restrict window, size_t position);
+static inline size_t maxheap_largestChild_avx2(const HEAP_VALUE *restrict maxHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value);
+static inline size_t minheap_smallestChild_avx2(const HEAP_VALUE *restrict minHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value);
+#endif
+#ifdef MEDIANWINDOW_AVX512_CHILD_SELECTION
+static void maxheap_heapifyDown_avx512(HEAP_WINDOW *restrict window, size_t position);
+static void minheap_heapifyDown_avx512(HEAP_WINDOW *restrict window, size_t position);
+static inline size_t maxheap_largestChild_avx512(const HEAP_VALUE *restrict maxHeap, size_t heapLength,
+    size_t position, HEAP_VALUE value);
+static inline size_t minheap_smallestChild_avx512(const HEAP_VALUE *restrict minHeap, size_t heapLength,
+    size_t position, HEAP_VALUE value);
+#endif
+static void heaps_initialize(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows, double quantile,
+    size_t rank, bool countSplit, HEAP_WINDOW **window);
+static inline size_t heaps_est_mem(size_t windowSize, bool countSplit);
+static inline size_t heaps_split(const HEAP_WINDOW *restrict window, size_t values);
+static inline bool heaps_maxheap_full(const HEAP_WINDOW *restrict window);
+static void heaps_rebalance(HEAP_WINDOW *restrict window);
 static inline size_t heap_calculate_children(size_t heapLength, size_t position);
-static inline bool heaps_can_rebalance(MedianWindow *restrict window);
+static inline bool heaps_can_rebalance(HEAP_WINDOW *restrict window);
 
-static inline void medianwindow_maxheap_root_to_minheap_root(MedianWindow *restrict window);
-static inline void medianwindow_minheap_root_to_maxheap_root(MedianWindow *restrict window);
-static inline void medianwindow_put_spc_number(MedianWindow *restrict window, HeapNode *restrict targetNode);
+static inline void medianwindow_maxheap_root_to_minheap_root(HEAP_WINDOW *restrict window);
+static inline void medianwindow_minheap_root_to_maxheap_root(HEAP_WINDOW *restrict window);
+static inline void medianwindow_put_spc_number(HEAP_WINDOW *restrict window, HeapNode *restrict targetNode);
 
-void medianwindow_initialize(char **memory, size_t windowSize, size_t steps,
-    bool ignoreNaNWindows, MedianWindow **window) {
-    MedianWindow *resultWindow = (MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
-    *memory += SIZE_OF_MEDIANWINDOW;
+void HEAP_FUNCTION(medianwindow_initialize)(char **memory, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, HEAP_WINDOW **window) {
+    heaps_initialize(memory, windowSize, steps, ignoreNaNWindows, 0.5, 0, false, window);
+}
 
-    const bool evenWindow = ((windowSize % 2) == 0);
-    const size_t heapLength = (windowSize / 2);
-    const size_t maxHeapLength = (evenWindow) ? heapLength : (heapLength + 1);
-    const size_t maxHeapMem = (maxHeapLength * SIZE_OF_HEAPNODE_PTR);
-    HeapNode **maxHeapStartingNode = (HeapNode** ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
-    *memory += maxHeapMem;
+#ifndef HEAP_INTEGER_VALUES
+void HEAP_FUNCTION(medianwindow_initialize_quantile)(char **memory, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, size_t rank, HEAP_WINDOW **window) {
+    heaps_initialize(memory, windowSize, steps, ignoreNaNWindows, quantile, rank, false, window);
+}
+#endif
 
-    const size_t minHeapLength = (heapLength);
-    const size_t minHeapMem = (minHeapLength * SIZE_OF_HEAPNODE_PTR);
-    HeapNode **minHeapStartingNode = (HeapNode** ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
-    *memory += minHeapMem;
+// Movable splits are only needed by the MAD of double values (see mad_medianwindow.c)
+#if !defined(HEAP_INTEGER_VALUES) && !defined(MEDIANWINDOW_FLOAT)
+void medianwindow_initialize_split(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    size_t split, MedianWindow **window) {
+    heaps_initialize(memory, windowSize, steps, ignoreNaNWindows, 0.5, split, true, window);
+}
 
-    const size_t neededNodeMem = (windowSize * SIZE_OF_HEAPNODE);
-    HeapNode *nodeDataStartingNode = (HeapNode* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
-    *memory += neededNodeMem;
+void medianwindow_move_split(MedianWindow *restrict window, bool up) {
+    // The max-heap holds min(rank, n) values, so it only changes while the split lies inside the valid values
+    const size_t values = (window->maxHeapLength + window->minHeapLength);
+    if(up) {
+        if(window->rank < values)
+            medianwindow_minheap_root_to_maxheap_root(window);
+        window->rank += 1;
+    } else {
+        if(window->rank <= values)
+            medianwindow_maxheap_root_to_minheap_root(window);
+        window->rank -= 1;
+    }
+}
 
-    resultWindow->windowSize = windowSize;
-    resultWindow->currentSize = 0;
-    resultWindow->steps = steps;
-    resultWindow->stepDistance = (steps - 1);
-    resultWindow->maxHeap = maxHeapStartingNode;
-    resultWindow->maxHeapLength = 0;
-    resultWindow->minHeap = minHeapStartingNode;
-    resultWindow->minHeapLength = 0;
-    resultWindow->head = NULL;
-    resultWindow->tail = NULL;
-    resultWindow->nodes = nodeDataStartingNode;
-    resultWindow->spcNumbers = 0;
-    resultWindow->ignoreNaNWindows = ignoreNaNWindows;
-    *window = resultWindow;
+size_t medianwindow_est_mem_split(size_t windowSize) {
+    return heaps_est_mem(windowSize, true);
+}
+
+double medianwindow_maxheap_second(const MedianWindow *restrict window) {
+    const size_t children = heap_calculate_children(window->maxHeapLength, 0);
+    double largest = (children == 0) ? NAN : window->maxHeap[1];
+    for(size_t i = 2; i <= children; i++)
+        largest = (window->maxHeap[i] > largest) ? window->maxHeap[i] : largest;
+    return largest;
+}
+
+double medianwindow_minheap_second(const MedianWindow *restrict window) {
+    const size_t children = heap_calculate_children(window->minHeapLength, 0);
+    double smallest = (children == 0) ? NAN : window->minHeap[1];
+    for(size_t i = 2; i <= children; i++)
+        smallest = (window->minHeap[i] < smallest) ? window->minHeap[i] : smallest;
+    return smallest;
 }
+#endif
 
-void medianwindow_addNew(MedianWindow *restrict window, double value) {
-    HeapNode *inputNode = &(window->nodes[window->currentSize]);
-    inputNode->value = value;
-    const bool isNaN = isnan(value);
+void HEAP_FUNCTION(medianwindow_addNew)(HEAP_WINDOW *restrict window, HEAP_VALUE value) {
+    const size_t inputNodeIndex = window->currentSize;
+    HeapNode *inputNode = &(window->nodes[inputNodeIndex]);
+    const bool isNaN = HEAP_IS_NAN(value);
 
 
     if((window->maxHeapLength == 0) &&
@@ -79,130 +229,146 @@ void medianwindow_addNew(MedianWindow *restrict window, double value) {
         if(isNaN)
             medianwindow_put_spc_number(window, inputNode);
         else
-            maxheap_put(window, inputNode);
-        window->tail = inputNode;
+            maxheap_put(window, inputNodeIndex, value);
     } else {
-        if(window->maxHeapLength > window->minHeapLength) {
+        if(heaps_maxheap_full(window)) {
             if(isNaN)
                 medianwindow_put_spc_number(window, inputNode);
             else {
-                const size_t inputPosition = minheap_put(window, inputNode);
-                minheap_heapifyUp(window->minHeap, inputPosition);
+                const size_t inputPosition = minheap_put(window, inputNodeIndex, value);
+                minheap_heapifyUp(window, inputPosition);
             }
         } else {
             if(isNaN)
                 medianwindow_put_spc_number(window, inputNode);
             else {
-                const size_t inputPosition = maxheap_put(window, inputNode);
-                maxheap_heapifyUp(window->maxHeap, inputPosition);
+                const size_t inputPosition = maxheap_put(window, inputNodeIndex, value);
+                maxheap_heapifyUp(window, inputPosition);
             }
         }
 
         if(heaps_can_rebalance(window))
             heaps_rebalance(window);
-
-        window->head->next = inputNode;
     }
 
-    window->head = inputNode;
     window->currentSize += 1;
 }
 
-void medianwindow_updateOld(MedianWindow *restrict window, double value) {
-    HeapNode *tailNode = window->tail;
-    window->tail = tailNode->next;
-    window->head->next = tailNode;
-    window->head = tailNode;
+void HEAP_FUNCTION(medianwindow_updateOld)(HEAP_WINDOW *restrict window, HEAP_VALUE value) {
+    const size_t tailNodeIndex = window->tail;
+    HeapNode *tailNode = &(window->nodes[tailNodeIndex]);
+    window->tail = ((tailNodeIndex + 1) == window->windowSize) ? 0 : (tailNodeIndex + 1);
 
-    if((tailNode->isNaN) && (isnan(value)))
+    const bool tailNodeIsNaN = (tailNode->type == SPC_NUMBER);
+    if((tailNodeIsNaN) && (HEAP_IS_NAN(value)))
         return;
-    else if(tailNode->isNaN) {
-        tailNode->value = value;
+    else if(tailNodeIsNaN) {
         window->spcNumbers -= 1;
 
-        if(window->maxHeapLength > window->minHeapLength) {
-            const size_t inputPosition = minheap_put(window, tailNode);
-            minheap_heapifyUp(window->minHeap, inputPosition);
+        if(heaps_maxheap_full(window)) {
+            const size_t inputPosition = minheap_put(window, tailNodeIndex, value);
+            minheap_heapifyUp(window, inputPosition);
         } else {
-            const size_t inputPosition = maxheap_put(window, tailNode);
-            maxheap_heapifyUp(window->maxHeap, inputPosition);
+            const size_t inputPosition = maxheap_put(window, tailNodeIndex, value);
+            maxheap_heapifyUp(window, inputPosition);
         }
 
         if(heaps_can_rebalance(window))
             heaps_rebalance(window);
 
     } else {
-        const double oldValue = tailNode->value;
         const size_t inputPosition = tailNode->position;
         const HeapType tailNodeHeapType = tailNode->type;
-        double newValue = value;
+        const HEAP_VALUE oldValue = (tailNodeHeapType == MAX_HEAP) ? window->maxHeap[inputPosition] :
+            window->minHeap[inputPosition];
+        HEAP_VALUE newValue = value;
         bool replaced = false;
         bool removed = false;
-        tailNode->value = value;
 
-        if(isnan(value)) {
-            if(tailNode->type == MAX_HEAP) {
-                HeapNode *lastNode = window->maxHeap[window->maxHeapLength - 1];
+        if(HEAP_IS_NAN(value)) {
+            if(tailNodeHeapType == MAX_HEAP) {
+                const size_t lastPosition = (window->maxHeapLength - 1);
                 window->maxHeapLength -= 1;
 
-                if(lastNode != tailNode) {
-                    lastNode->position = inputPosition;
-                    window->maxHeap[inputPosition] = lastNode;
-                    newValue = lastNode->value;
+                if(lastPosition != inputPosition) {
+                    const uint32_t lastNodeIndex = window->maxHeapNodes[lastPosition];
+                    newValue = window->maxHeap[lastPosition];
+                    window->nodes[lastNodeIndex].position = (uint32_t) inputPosition;
+                    window->maxHeap[inputPosition] = newValue;
+                    window->maxHeapNodes[inputPosition] = lastNodeIndex;
                     replaced = true;
                 }
 
                 medianwindow_put_spc_number(window, tailNode);
             } else {
-                HeapNode *lastNode = window->minHeap[window->minHeapLength - 1];
+                const size_t lastPosition = (window->minHeapLength - 1);
                 window->minHeapLength -= 1;
 
-                if(lastNode != tailNode) {
-                    lastNode->position = inputPosition;
-                    window->minHeap[inputPosition] = lastNode;
-                    newValue = lastNode->value;
+                if(lastPosition != inputPosition) {
+                    const uint32_t lastNodeIndex = window->minHeapNodes[lastPosition];
+                    newValue = window->minHeap[lastPosition];
+                    window->nodes[lastNodeIndex].position = (uint32_t) inputPosition;
+                    window->minHeap[inputPosition] = newValue;
+                    window->minHeapNodes[inputPosition] = lastNodeIndex;
                     replaced = true;
                 }
 
                 medianwindow_put_spc_number(window, tailNode);
             }
             removed = true;
-        } else
+        } else {
+            if(tailNodeHeapType == MAX_HEAP)
+                window->maxHeap[inputPosition] = value;
+            else
+                window->minHeap[inputPosition] = value;
             replaced = true;
+        }
 
         if(replaced) {
             if(tailNodeHeapType == MAX_HEAP) {
                 if(newValue > oldValue) {
-                    maxheap_heapifyUp(window->maxHeap, inputPosition);
+                    maxheap_heapifyUp(window, inputPosition);
 
                     if(heaps_can_rebalance(window))
                         heaps_rebalance(window);
                 } else {
-                    maxheap_heapifyDown(window->maxHeap, window->maxHeapLength, inputPosition);
+                    window->maxheap_heapifyDown(window, inputPosition);
                 }
             } else {
                 if(newValue < oldValue) {
-                    minheap_heapifyUp(window->minHeap, inputPosition);
+                    minheap_heapifyUp(window, inputPosition);
 
                     if(heaps_can_rebalance(window))
                         heaps_rebalance(window);
                 } else {
-                    minheap_heapifyDown(window->minHeap, window->minHeapLength, inputPosition);
+                    window->minheap_heapifyDown(window, inputPosition);
                 }
             }
         }
 
         if(removed) {
-            if(window->maxHeapLength > (window->minHeapLength + 1)) {
+            const size_t split = heaps_split(window, (window->maxHeapLength + window->minHeapLength));
+            if(window->maxHeapLength > split) {
                 medianwindow_maxheap_root_to_minheap_root(window);
-            } else if(window->minHeapLength > window->maxHeapLength) {
+            } else if(window->maxHeapLength < split) {
                 medianwindow_minheap_root_to_maxheap_root(window);
             }
         }
     }
 }
 
-void medianwindow_result(MedianWindow *restrict window, double *restrict resultDest) {
+#ifdef HEAP_INTEGER_VALUES
+void HEAP_FUNCTION(medianwindow_result)(HEAP_WINDOW *restrict window, MedianWindowAveraging averaging,
+    HEAP_VALUE *restrict resultDest) {
+    if(window->maxHeapLength != window->minHeapLength) {
+        *resultDest = window->maxHeap[0];
+        return;
+    }
+
+    *resultDest = MEDIANWINDOW_AVERAGE(window->maxHeap[0], window->minHeap[0], averaging);
+}
+#else
+void HEAP_FUNCTION(medianwindow_result)(HEAP_WINDOW *restrict window, HEAP_VALUE *restrict resultDest) {
     if(window->ignoreNaNWindows) {
         if(window->spcNumbers > 0) {
             *resultDest = NAN;
@@ -216,174 +382,530 @@ void medianwindow_result(MedianWindow *restrict window, double *restrict resultD
     }
 
     if(window->maxHeapLength != window->minHeapLength) {
-        *resultDest = window->maxHeap[0]->value;
+        *resultDest = window->maxHeap[0];
         return;
     }
 
-    *resultDest = (window->maxHeap[0]->value + window->minHeap[0]->value) / 2;
+    *resultDest = (window->maxHeap[0] + window->minHeap[0]) / 2;
 }
 
-size_t medianwindow_est_mem(size_t windowSize) {
-    const size_t neededNodesPtrMem = (windowSize * SIZE_OF_HEAPNODE_PTR);
-    const size_t neededNodesMem = (windowSize * SIZE_OF_HEAPNODE);
-    return (SIZE_OF_MEDIANWINDOW + neededNodesPtrMem + neededNodesMem);
+void HEAP_FUNCTION(medianwindow_quantile_result)(HEAP_WINDOW *restrict window, MedianWindowInterpolation interpolation,
+    HEAP_VALUE *restrict resultDest) {
+    if(((window->ignoreNaNWindows) && (window->spcNumbers > 0)) || (window->maxHeapLength == 0)) {
+        *resultDest = NAN;
+        return;
+    }
+
+    // The max-heap root is the value at the position floor(h) of the sorted window, the min-heap root the next one
+    const HEAP_VALUE lower = window->maxHeap[0];
+    const size_t values = (window->maxHeapLength + window->minHeapLength);
+    const double position = (window->rank > 0) ? 0.0 : ((double) (values - 1) * window->quantile);
+    const double fraction = position - floor(position);
+    if((fraction == 0.0) || (window->minHeapLength == 0)) {
+        *resultDest = lower;
+        return;
+    }
+
+    *resultDest = (HEAP_VALUE) medianwindow_interpolate(lower, window->minHeap[0], fraction,
+        (window->maxHeapLength - 1), interpolation);
+}
+#endif
+
+// The window state only consists of values and ring/heap indices, so a copy is a plain memory copy
+// whose array pointers are moved to the new memory (medianwindow_est_mem(windowSize) bytes).
+void HEAP_FUNCTION(medianwindow_copy)(char **memory, const HEAP_WINDOW *restrict source, HEAP_WINDOW **window) {
+    const size_t neededMemory = heaps_est_mem(source->windowSize, source->countSplit);
+    char *targetMemory = (char* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    const char *sourceMemory = (const char* ) source;
+    memcpy(targetMemory, sourceMemory, neededMemory);
+    *memory += neededMemory;
+
+    HEAP_WINDOW *resultWindow = (HEAP_WINDOW* ) targetMemory;
+    resultWindow->maxHeap = (HEAP_VALUE* ) (targetMemory + ((const char* ) source->maxHeap - sourceMemory));
+    resultWindow->maxHeapNodes = (uint32_t* ) (targetMemory + ((const char* ) source->maxHeapNodes - sourceMemory));
+    resultWindow->minHeap = (HEAP_VALUE* ) (targetMemory + ((const char* ) source->minHeap - sourceMemory));
+    resultWindow->minHeapNodes = (uint32_t* ) (targetMemory + ((const char* ) source->minHeapNodes - sourceMemory));
+    resultWindow->nodes = (HeapNode* ) (targetMemory + ((const char* ) source->nodes - sourceMemory));
+    *window = resultWindow;
+}
+
+size_t HEAP_FUNCTION(medianwindow_est_mem)(size_t windowSize) {
+    return heaps_est_mem(windowSize, false);
 }
 
-static inline size_t maxheap_put(MedianWindow *restrict window, HeapNode *restrict targetNode) {
+static inline size_t maxheap_put(HEAP_WINDOW *restrict window, size_t nodeIndex, HEAP_VALUE value) {
     const size_t inputPosition = window->maxHeapLength;
-    targetNode->position = inputPosition;
+    HeapNode *targetNode = &(window->nodes[nodeIndex]);
+    targetNode->position = (uint32_t) inputPosition;
     targetNode->type = MAX_HEAP;
-    targetNode->isNaN = false;
-    window->maxHeap[inputPosition] = targetNode;
+    window->maxHeap[inputPosition] = value;
+    window->maxHeapNodes[inputPosition] = (uint32_t) nodeIndex;
     window->maxHeapLength += 1;
     return inputPosition;
 }
 
-static void maxheap_heapifyUp(HeapNode *restrict *restrict maxHeapNodes, size_t position) {
-    HeapNode *targetNode = maxHeapNodes[position];
+static void maxheap_heapifyUp(HEAP_WINDOW *restrict window, size_t position) {
+    HEAP_VALUE *restrict maxHeap = window->maxHeap;
+    uint32_t *restrict maxHeapNodes = window->maxHeapNodes;
+    HeapNode *restrict nodes = window->nodes;
+    const HEAP_VALUE targetValue = maxHeap[position];
+    const uint32_t targetNodeIndex = maxHeapNodes[position];
     while (position > 0) {
         const size_t parentPosition = HEAP_PARENT_FORMULAR(position);
-        HeapNode *parentNode = maxHeapNodes[parentPosition];
-        if(targetNode->value <= parentNode->value)
+        if(targetValue <= maxHeap[parentPosition])
             break;
 
-        parentNode->position = position;
-        maxHeapNodes[position] = parentNode;
+        const uint32_t parentNodeIndex = maxHeapNodes[parentPosition];
+        nodes[parentNodeIndex].position = (uint32_t) position;
+        maxHeap[position] = maxHeap[parentPosition];
+        maxHeapNodes[position] = parentNodeIndex;
         position = parentPosition;
     }
 
-    targetNode->position = position;
-    maxHeapNodes[position] = targetNode;
+    nodes[targetNodeIndex].position = (uint32_t) position;
+    maxHeap[position] = targetValue;
+    maxHeapNodes[position] = targetNodeIndex;
 }
 
-static void maxheap_heapifyDown(HeapNode *restrict *restrict maxHeapNodes, size_t heapLength, size_t position) {
-    size_t target;
-    maxheap_largestChild(maxHeapNodes, heapLength, position, &target);
+static inline __attribute__((always_inline)) void maxheap_heapifyDown_impl(HEAP_WINDOW *restrict window,
+    size_t position, size_t (*largestChild) (const HEAP_VALUE *restrict, size_t, size_t, HEAP_VALUE)) {
+    HEAP_VALUE *restrict maxHeap = window->maxHeap;
+    uint32_t *restrict maxHeapNodes = window->maxHeapNodes;
+    HeapNode *restrict nodes = window->nodes;
+    const size_t heapLength = window->maxHeapLength;
+    const HEAP_VALUE targetValue = maxHeap[position];
+    const uint32_t targetNodeIndex = maxHeapNodes[position];
+    size_t target = largestChild(maxHeap, heapLength, position, targetValue);
 
     while (target != position) {
-        HeapNode *positionNode = maxHeapNodes[position];
-        HeapNode *childNode = maxHeapNodes[target];
-        positionNode->position = target;
-        maxHeapNodes[target] = positionNode;
-        childNode->position = position;
-        maxHeapNodes[position] = childNode;
+        const uint32_t childNodeIndex = maxHeapNodes[target];
+        nodes[childNodeIndex].position = (uint32_t) position;
+        maxHeap[position] = maxHeap[target];
+        maxHeapNodes[position] = childNodeIndex;
         position = target;
-        maxheap_largestChild(maxHeapNodes, heapLength, position, &target);
+        target = largestChild(maxHeap, heapLength, position, targetValue);
     }
+
+    nodes[targetNodeIndex].position = (uint32_t) position;
+    maxHeap[position] = targetValue;
+    maxHeapNodes[position] = targetNodeIndex;
+}
+
+static void maxheap_heapifyDown(HEAP_WINDOW *restrict window, size_t position) {
+    maxheap_heapifyDown_impl(window, position, &maxheap_largestChild);
 }
 
-static void maxheap_largestChild(HeapNode *restrict *restrict maxHeapNodes, size_t heapLength, size_t position,
-    size_t *restrict childPosition) {
+static inline size_t maxheap_largestChild(const HEAP_VALUE *restrict maxHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value) {
     const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
     const size_t numChildren = heap_calculate_children(heapLength, position);
 
     switch (numChildren) {
-        case 8: if(maxHeapNodes[minChildPosition + 7]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 7);
-        case 7: if(maxHeapNodes[minChildPosition + 6]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 6);
-        case 6: if(maxHeapNodes[minChildPosition + 5]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 5);
-        case 5: if(maxHeapNodes[minChildPosition + 4]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 4);
-        case 4: if(maxHeapNodes[minChildPosition + 3]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 3);
-        case 3: if(maxHeapNodes[minChildPosition + 2]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 2);
-        case 2: if(maxHeapNodes[minChildPosition + 1]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition + 1);
-        case 1: if(maxHeapNodes[minChildPosition]->value > maxHeapNodes[position]->value)
-            position = (minChildPosition);
+#if K_ARY_HEAP_CHILDREN >= 16
+        case 16: if(maxHeap[minChildPosition + 15] > value)
+            { position = (minChildPosition + 15); value = maxHeap[position]; }
+        case 15: if(maxHeap[minChildPosition + 14] > value)
+            { position = (minChildPosition + 14); value = maxHeap[position]; }
+        case 14: if(maxHeap[minChildPosition + 13] > value)
+            { position = (minChildPosition + 13); value = maxHeap[position]; }
+        case 13: if(maxHeap[minChildPosition + 12] > value)
+            { position = (minChildPosition + 12); value = maxHeap[position]; }
+        case 12: if(maxHeap[minChildPosition + 11] > value)
+            { position = (minChildPosition + 11); value = maxHeap[position]; }
+        case 11: if(maxHeap[minChildPosition + 10] > value)
+            { position = (minChildPosition + 10); value = maxHeap[position]; }
+        case 10: if(maxHeap[minChildPosition + 9] > value)
+            { position = (minChildPosition + 9); value = maxHeap[position]; }
+        case 9: if(maxHeap[minChildPosition + 8] > value)
+            { position = (minChildPosition + 8); value = maxHeap[position]; }
+#endif
+#if K_ARY_HEAP_CHILDREN >= 8
+        case 8: if(maxHeap[minChildPosition + 7] > value)
+            { position = (minChildPosition + 7); value = maxHeap[position]; }
+        case 7: if(maxHeap[minChildPosition + 6] > value)
+            { position = (minChildPosition + 6); value = maxHeap[position]; }
+        case 6: if(maxHeap[minChildPosition + 5] > value)
+            { position = (minChildPosition + 5); value = maxHeap[position]; }
+        case 5: if(maxHeap[minChildPosition + 4] > value)
+            { position = (minChildPosition + 4); value = maxHeap[position]; }
+#endif
+#if K_ARY_HEAP_CHILDREN >= 4
+        case 4: if(maxHeap[minChildPosition + 3] > value)
+            { position = (minChildPosition + 3); value = maxHeap[position]; }
+        case 3: if(maxHeap[minChildPosition + 2] > value)
+            { position = (minChildPosition + 2); value = maxHeap[position]; }
+#endif
+        case 2: if(maxHeap[minChildPosition + 1] > value)
+            { position = (minChildPosition + 1); value = maxHeap[position]; }
+        case 1: if(maxHeap[minChildPosition] > value)
+            { position = (minChildPosition); }
         case 0: break;
     }
 
-    *childPosition = position;
+    return position;
 }
 
-static inline size_t minheap_put(MedianWindow *restrict window, HeapNode *restrict targetNode) {
+static inline size_t minheap_put(HEAP_WINDOW *restrict window, size_t nodeIndex, HEAP_VALUE value) {
     const size_t inputPosition = window->minHeapLength;
-    targetNode->position = inputPosition;
+    HeapNode *targetNode = &(window->nodes[nodeIndex]);
+    targetNode->position = (uint32_t) inputPosition;
     targetNode->type = MIN_HEAP;
-    targetNode->isNaN = false;
-    window->minHeap[inputPosition] = targetNode;
+    window->minHeap[inputPosition] = value;
+    window->minHeapNodes[inputPosition] = (uint32_t) nodeIndex;
     window->minHeapLength += 1;
     return inputPosition;
 }
 
-static void minheap_heapifyUp(HeapNode *restrict *restrict minHeapNodes, size_t position) {
-    HeapNode *targetNode = minHeapNodes[position];
+static void minheap_heapifyUp(HEAP_WINDOW *restrict window, size_t position) {
+    HEAP_VALUE *restrict minHeap = window->minHeap;
+    uint32_t *restrict minHeapNodes = window->minHeapNodes;
+    HeapNode *restrict nodes = window->nodes;
+    const HEAP_VALUE targetValue = minHeap[position];
+    const uint32_t targetNodeIndex = minHeapNodes[position];
     while (position > 0) {
         const size_t parentPosition = HEAP_PARENT_FORMULAR(position);
-        HeapNode *parentNode = minHeapNodes[parentPosition];
-        if(targetNode->value >= parentNode->value)
+        if(targetValue >= minHeap[parentPosition])
             break;
 
-        parentNode->position = position;
-        minHeapNodes[position] = parentNode;
+        const uint32_t parentNodeIndex = minHeapNodes[parentPosition];
+        nodes[parentNodeIndex].position = (uint32_t) position;
+        minHeap[position] = minHeap[parentPosition];
+        minHeapNodes[position] = parentNodeIndex;
         position = parentPosition;
     }
 
-    targetNode->position = position;
-    minHeapNodes[position] = targetNode;
+    nodes[targetNodeIndex].position = (uint32_t) position;
+    minHeap[position] = targetValue;
+    minHeapNodes[position] = targetNodeIndex;
 }
 
-static void minheap_heapifyDown(HeapNode *restrict *restrict minHeapNodes, size_t heapLength, size_t position) {
-    size_t target;
-    minheap_smallestChild(minHeapNodes, heapLength, position, &target);
+static inline __attribute__((always_inline)) void minheap_heapifyDown_impl(HEAP_WINDOW *restrict window,
+    size_t position, size_t (*smallestChild) (const HEAP_VALUE *restrict, size_t, size_t, HEAP_VALUE)) {
+    HEAP_VALUE *restrict minHeap = window->minHeap;
+    uint32_t *restrict minHeapNodes = window->minHeapNodes;
+    HeapNode *restrict nodes = window->nodes;
+    const size_t heapLength = window->minHeapLength;
+    const HEAP_VALUE targetValue = minHeap[position];
+    const uint32_t targetNodeIndex = minHeapNodes[position];
+    size_t target = smallestChild(minHeap, heapLength, position, targetValue);
 
     while (target != position) {
-        HeapNode *positionNode = minHeapNodes[position];
-        HeapNode *childNode = minHeapNodes[target];
-        positionNode->position = target;
-        minHeapNodes[target] = positionNode;
-        childNode->position = position;
-        minHeapNodes[position] = childNode;
+        const uint32_t childNodeIndex = minHeapNodes[target];
+        nodes[childNodeIndex].position = (uint32_t) position;
+        minHeap[position] = minHeap[target];
+        minHeapNodes[position] = childNodeIndex;
         position = target;
-        minheap_smallestChild(minHeapNodes, heapLength, position, &target);
+        target = smallestChild(minHeap, heapLength, position, targetValue);
     }
+
+    nodes[targetNodeIndex].position = (uint32_t) position;
+    minHeap[position] = targetValue;
+    minHeapNodes[position] = targetNodeIndex;
+}
+
+static void minheap_heapifyDown(HEAP_WINDOW *restrict window, size_t position) {
+    minheap_heapifyDown_impl(window, position, &minheap_smallestChild);
 }
 
-static void minheap_smallestChild(HeapNode *restrict *restrict minHeapNodes, size_t heapLength, size_t position,
-    size_t *restrict childPosition) {
+static inline size_t minheap_smallestChild(const HEAP_VALUE *restrict minHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value) {
     const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
     const size_t numChildren = heap_calculate_children(heapLength, position);
 
     switch (numChildren) {
-        case 8: if(minHeapNodes[minChildPosition + 7]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 7);
-        case 7: if(minHeapNodes[minChildPosition + 6]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 6);
-        case 6: if(minHeapNodes[minChildPosition + 5]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 5);
-        case 5: if(minHeapNodes[minChildPosition + 4]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 4);
-        case 4: if(minHeapNodes[minChildPosition + 3]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 3);
-        case 3: if(minHeapNodes[minChildPosition + 2]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 2);
-        case 2: if(minHeapNodes[minChildPosition + 1]->value < minHeapNodes[position]->value)
-            position = (minChildPosition + 1);
-        case 1: if(minHeapNodes[minChildPosition]->value < minHeapNodes[position]->value)
-            position = (minChildPosition);
+#if K_ARY_HEAP_CHILDREN >= 16
+        case 16: if(minHeap[minChildPosition + 15] < value)
+            { position = (minChildPosition + 15); value = minHeap[position]; }
+        case 15: if(minHeap[minChildPosition + 14] < value)
+            { position = (minChildPosition + 14); value = minHeap[position]; }
+        case 14: if(minHeap[minChildPosition + 13] < value)
+            { position = (minChildPosition + 13); value = minHeap[position]; }
+        case 13: if(minHeap[minChildPosition + 12] < value)
+            { position = (minChildPosition + 12); value = minHeap[position]; }
+        case 12: if(minHeap[minChildPosition + 11] < value)
+            { position = (minChildPosition + 11); value = minHeap[position]; }
+        case 11: if(minHeap[minChildPosition + 10] < value)
+            { position = (minChildPosition + 10); value = minHeap[position]; }
+        case 10: if(minHeap[minChildPosition + 9] < value)
+            { position = (minChildPosition + 9); value = minHeap[position]; }
+        case 9: if(minHeap[minChildPosition + 8] < value)
+            { position = (minChildPosition + 8); value = minHeap[position]; }
+#endif
+#if K_ARY_HEAP_CHILDREN >= 8
+        case 8: if(minHeap[minChildPosition + 7] < value)
+            { position = (minChildPosition + 7); value = minHeap[position]; }
+        case 7: if(minHeap[minChildPosition + 6] < value)
+            { position = (minChildPosition + 6); value = minHeap[position]; }
+        case 6: if(minHeap[minChildPosition + 5] < value)
+            { position = (minChildPosition + 5); value = minHeap[position]; }
+        case 5: if(minHeap[minChildPosition + 4] < value)
+            { position = (minChildPosition + 4); value = minHeap[position]; }
+#endif
+#if K_ARY_HEAP_CHILDREN >= 4
+        case 4: if(minHeap[minChildPosition + 3] < value)
+            { position = (minChildPosition + 3); value = minHeap[position]; }
+        case 3: if(minHeap[minChildPosition + 2] < value)
+            { position = (minChildPosition + 2); value = minHeap[position]; }
+#endif
+        case 2: if(minHeap[minChildPosition + 1] < value)
+            { position = (minChildPosition + 1); value = minHeap[position]; }
+        case 1: if(minHeap[minChildPosition] < value)
+            { position = (minChildPosition); }
         case 0: break;
     }
 
-    *childPosition = position;
+    return position;
+}
+
+static void heaps_set_heapify_down_functions(HEAP_WINDOW *restrict window) {
+    if(!HEAP_FUNCTION(medianwindow_use_child_selection)(window, MEDIANWINDOW_CHILD_SELECTION_AVX512)
+        && !HEAP_FUNCTION(medianwindow_use_child_selection)(window, MEDIANWINDOW_CHILD_SELECTION_AVX2))
+        HEAP_FUNCTION(medianwindow_use_child_selection)(window, MEDIANWINDOW_CHILD_SELECTION_SCALAR);
+}
+
+bool HEAP_FUNCTION(medianwindow_use_child_selection)(HEAP_WINDOW *restrict window,
+    MedianWindowChildSelection selection) {
+    switch (selection) {
+        case MEDIANWINDOW_CHILD_SELECTION_SCALAR:
+            window->maxheap_heapifyDown = &maxheap_heapifyDown;
+            window->minheap_heapifyDown = &minheap_heapifyDown;
+            return true;
+#ifdef MEDIANWINDOW_AVX2_CHILD_SELECTION
+        case MEDIANWINDOW_CHILD_SELECTION_AVX2:
+            if(!__builtin_cpu_supports("avx2"))
+                return false;
+            window->maxheap_heapifyDown = &maxheap_heapifyDown_avx2;
+            window->minheap_heapifyDown = &minheap_heapifyDown_avx2;
+            return true;
+#endif
+#ifdef MEDIANWINDOW_AVX512_CHILD_SELECTION
+        case MEDIANWINDOW_CHILD_SELECTION_AVX512:
+            if(!__builtin_cpu_supports("avx512f"))
+                return false;
+            window->maxheap_heapifyDown = &maxheap_heapifyDown_avx512;
+            window->minheap_heapifyDown = &minheap_heapifyDown_avx512;
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+#ifdef MEDIANWINDOW_AVX2_CHILD_SELECTION
+// The following kernels select the child of a node with all K_ARY_HEAP_CHILDREN children present
+// by a vectorized max/min reduction followed by a mask lookup. Nodes with fewer children use the scalar scan.
+__attribute__((target("avx2")))
+static void maxheap_heapifyDown_avx2(HEAP_WINDOW *restrict window, size_t position) {
+    maxheap_heapifyDown_impl(window, position, &maxheap_largestChild_avx2);
+}
+
+__attribute__((target("avx2")))
+static void minheap_heapifyDown_avx2(HEAP_WINDOW *restrict window, size_t position) {
+    minheap_heapifyDown_impl(window, position, &minheap_smallestChild_avx2);
+}
+
+__attribute__((target("avx2")))
+static inline size_t maxheap_largestChild_avx2(const HEAP_VALUE *restrict maxHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value) {
+    const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
+    if((minChildPosition + K_ARY_HEAP_CHILDREN) > heapLength)
+        return maxheap_largestChild(maxHeap, heapLength, position, value);
+
+    AVX2_VECTOR children[AVX2_CHILD_VECTORS];
+    for(size_t i = 0; i < AVX2_CHILD_VECTORS; i++)
+        children[i] = AVX2_LOAD(&maxHeap[minChildPosition + (i * AVX2_LANES)]);
+
+    AVX2_VECTOR largest = children[0];
+    for(size_t i = 1; i < AVX2_CHILD_VECTORS; i++)
+        largest = AVX2(max)(largest, children[i]);
+    AVX2_SPREAD(max, largest);
+    if(AVX2_FIRST(largest) <= value)
+        return position;
+
+    unsigned int mask = 0;
+    for(size_t i = 0; i < AVX2_CHILD_VECTORS; i++)
+        mask |= ((unsigned int) AVX2_EQUAL_MASK(children[i], largest)) << (i * AVX2_LANES);
+    return (minChildPosition + (size_t) __builtin_ctz(mask));
+}
+
+__attribute__((target("avx2")))
+static inline size_t minheap_smallestChild_avx2(const HEAP_VALUE *restrict minHeap, size_t heapLength, size_t position,
+    HEAP_VALUE value) {
+    const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
+    if((minChildPosition + K_ARY_HEAP_CHILDREN) > heapLength)
+        return minheap_smallestChild(minHeap, heapLength, position, value);
+
+    AVX2_VECTOR children[AVX2_CHILD_VECTORS];
+    for(size_t i = 0; i < AVX2_CHILD_VECTORS; i++)
+        children[i] = AVX2_LOAD(&minHeap[minChildPosition + (i * AVX2_LANES)]);
+
+    AVX2_VECTOR smallest = children[0];
+    for(size_t i = 1; i < AVX2_CHILD_VECTORS; i++)
+        smallest = AVX2(min)(smallest, children[i]);
+    AVX2_SPREAD(min, smallest);
+    if(AVX2_FIRST(smallest) >= value)
+        return position;
+
+    unsigned int mask = 0;
+    for(size_t i = 0; i < AVX2_CHILD_VECTORS; i++)
+        mask |= ((unsigned int) AVX2_EQUAL_MASK(children[i], smallest)) << (i * AVX2_LANES);
+    return (minChildPosition + (size_t) __builtin_ctz(mask));
 }
+#endif
 
-static void heaps_rebalance(MedianWindow *restrict window) {
-    HeapNode *restrict maxHeapRoot = window->maxHeap[0];
-    HeapNode *restrict minHeapRoot = window->minHeap[0];
-    if(maxHeapRoot->value < minHeapRoot->value) {
+#ifdef MEDIANWINDOW_AVX512_CHILD_SELECTION
+__attribute__((target("avx512f")))
+static void maxheap_heapifyDown_avx512(HEAP_WINDOW *restrict window, size_t position) {
+    maxheap_heapifyDown_impl(window, position, &maxheap_largestChild_avx512);
+}
+
+__attribute__((target("avx512f")))
+static void minheap_heapifyDown_avx512(HEAP_WINDOW *restrict window, size_t position) {
+    minheap_heapifyDown_impl(window, position, &minheap_smallestChild_avx512);
+}
+
+__attribute__((target("avx512f")))
+static inline size_t maxheap_largestChild_avx512(const HEAP_VALUE *restrict maxHeap, size_t heapLength,
+    size_t position, HEAP_VALUE value) {
+    const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
+    if((minChildPosition + K_ARY_HEAP_CHILDREN) > heapLength)
+        return maxheap_largestChild(maxHeap, heapLength, position, value);
+
+    AVX512_VECTOR children[AVX512_CHILD_VECTORS];
+    for(size_t i = 0; i < AVX512_CHILD_VECTORS; i++)
+        children[i] = AVX512_LOAD(&maxHeap[minChildPosition + (i * AVX512_LANES)]);
+
+    AVX512_VECTOR largestVector = children[0];
+    for(size_t i = 1; i < AVX512_CHILD_VECTORS; i++)
+        largestVector = AVX512(max)(largestVector, children[i]);
+    const HEAP_VALUE largest = AVX512(reduce_max)(largestVector);
+    if(largest <= value)
+        return position;
+
+    unsigned int mask = 0;
+    for(size_t i = 0; i < AVX512_CHILD_VECTORS; i++)
+        mask |= ((unsigned int) AVX512_EQUAL_MASK(children[i], largest)) << (i * AVX512_LANES);
+    return (minChildPosition + (size_t) __builtin_ctz(mask));
+}
+
+__attribute__((target("avx512f")))
+static inline size_t minheap_smallestChild_avx512(const HEAP_VALUE *restrict minHeap, size_t heapLength,
+    size_t position, HEAP_VALUE value) {
+    const size_t minChildPosition = HEAP_CHILDREN_FORMULAR(position, 1);
+    if((minChildPosition + K_ARY_HEAP_CHILDREN) > heapLength)
+        return minheap_smallestChild(minHeap, heapLength, position, value);
+
+    AVX512_VECTOR children[AVX512_CHILD_VECTORS];
+    for(size_t i = 0; i < AVX512_CHILD_VECTORS; i++)
+        children[i] = AVX512_LOAD(&minHeap[minChildPosition + (i * AVX512_LANES)]);
+
+    AVX512_VECTOR smallestVector = children[0];
+    for(size_t i = 1; i < AVX512_CHILD_VECTORS; i++)
+        smallestVector = AVX512(min)(smallestVector, children[i]);
+    const HEAP_VALUE smallest = AVX512(reduce_min)(smallestVector);
+    if(smallest >= value)
+        return position;
+
+    unsigned int mask = 0;
+    for(size_t i = 0; i < AVX512_CHILD_VECTORS; i++)
+        mask |= ((unsigned int) AVX512_EQUAL_MASK(children[i], smallest)) << (i * AVX512_LANES);
+    return (minChildPosition + (size_t) __builtin_ctz(mask));
+}
+#endif
+
+// Both heaps only grow while the window fills or NaN values leave it, and split(n) as well as n - split(n) never
+// decrease with n, so the heaps never hold more than split(windowSize) and windowSize - split(windowSize) values.
+static void heaps_initialize(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows, double quantile,
+    size_t rank, bool countSplit, HEAP_WINDOW **window) {
+    char *startingMemory = *memory;
+    HEAP_WINDOW *resultWindow = (HEAP_WINDOW* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += sizeof(HEAP_WINDOW);
+
+    resultWindow->windowSize = windowSize;
+    resultWindow->quantile = quantile;
+    resultWindow->rank = rank;
+    resultWindow->countSplit = countSplit;
+    // A movable split can leave any number of values in either heap
+    const size_t maxHeapLength = countSplit ? windowSize : heaps_split(resultWindow, windowSize);
+    const size_t minHeapLength = countSplit ? windowSize : (windowSize - maxHeapLength);
+    // Values narrower than STD_ALIGNMENT would misalign the min-heap after an odd number of max-heap values
+    HEAP_VALUE *maxHeapStartingValue = (HEAP_VALUE* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += aligned_size(maxHeapLength * sizeof(HEAP_VALUE));
+    HEAP_VALUE *minHeapStartingValue = (HEAP_VALUE* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (minHeapLength * sizeof(HEAP_VALUE));
+
+    uint32_t *maxHeapStartingNodeIndex = (uint32_t* ) *memory;
+    *memory += (maxHeapLength * SIZE_OF_HEAP_NODE_INDEX);
+    uint32_t *minHeapStartingNodeIndex = (uint32_t* ) *memory;
+    *memory += (minHeapLength * SIZE_OF_HEAP_NODE_INDEX);
+
+    HeapNode *nodeDataStartingNode = (HeapNode* ) *memory;
+    // Every window takes the aligned heaps_est_mem bytes, so windows packed one after another stay aligned
+    *memory = (startingMemory + heaps_est_mem(windowSize, countSplit));
+
+    resultWindow->currentSize = 0;
+    resultWindow->steps = steps;
+    resultWindow->stepDistance = (steps - 1);
+    resultWindow->maxHeap = maxHeapStartingValue;
+    resultWindow->maxHeapNodes = maxHeapStartingNodeIndex;
+    resultWindow->maxHeapLength = 0;
+    resultWindow->minHeap = minHeapStartingValue;
+    resultWindow->minHeapNodes = minHeapStartingNodeIndex;
+    resultWindow->minHeapLength = 0;
+    resultWindow->tail = 0;
+    resultWindow->nodes = nodeDataStartingNode;
+    resultWindow->spcNumbers = 0;
+    resultWindow->ignoreNaNWindows = ignoreNaNWindows;
+    heaps_set_heapify_down_functions(resultWindow);
+    *window = resultWindow;
+}
+
+static inline size_t heaps_est_mem(size_t windowSize, bool countSplit) {
+    // Both heaps of a movable split have room for the whole window
+    const size_t heapValues = countSplit ? (2 * windowSize) : windowSize;
+    const size_t neededHeapMem = (heapValues * (sizeof(HEAP_VALUE) + SIZE_OF_HEAP_NODE_INDEX));
+    // The padding of the max-heap values is a multiple of sizeof(HEAP_VALUE) below STD_ALIGNMENT
+    const size_t neededPaddingMem = (STD_ALIGNMENT - sizeof(HEAP_VALUE));
+    const size_t neededNodesMem = (windowSize * SIZE_OF_HEAPNODE);
+    return aligned_size(sizeof(HEAP_WINDOW) + neededHeapMem + neededPaddingMem + neededNodesMem);
+}
+
+static inline size_t heaps_split(const HEAP_WINDOW *restrict window, size_t values) {
+    if(values == 0)
+        return 0;
+
+    if(window->countSplit)
+        return (window->rank < values) ? window->rank : values;
+
+    if(window->rank > 0)
+        return ((((values - 1) * (window->rank - 1)) / (window->windowSize - 1)) + 1);
+
+    const size_t split = ((size_t) ((double) (values - 1) * window->quantile) + 1);
+    return (split > values) ? values : split;
+}
+
+// Whether a new valid value belongs into the min-heap (unless it is smaller than the root of the max-heap)
+static inline bool heaps_maxheap_full(const HEAP_WINDOW *restrict window) {
+    return (window->maxHeapLength >= heaps_split(window, (window->maxHeapLength + window->minHeapLength + 1)));
+}
+
+static void heaps_rebalance(HEAP_WINDOW *restrict window) {
+    const HEAP_VALUE maxHeapRoot = window->maxHeap[0];
+    const HEAP_VALUE minHeapRoot = window->minHeap[0];
+    if(maxHeapRoot < minHeapRoot) {
         return;
     }
 
+    const uint32_t maxHeapRootNodeIndex = window->maxHeapNodes[0];
+    const uint32_t minHeapRootNodeIndex = window->minHeapNodes[0];
     window->maxHeap[0] = minHeapRoot;
-    minHeapRoot->type = MAX_HEAP;
+    window->maxHeapNodes[0] = minHeapRootNodeIndex;
+    window->nodes[minHeapRootNodeIndex].type = MAX_HEAP;
     window->minHeap[0] = maxHeapRoot;
-    maxHeapRoot->type = MIN_HEAP;
-    maxheap_heapifyDown(window->maxHeap, window->maxHeapLength, 0);
-    minheap_heapifyDown(window->minHeap, window->minHeapLength, 0);
+    window->minHeapNodes[0] = maxHeapRootNodeIndex;
+    window->nodes[maxHeapRootNodeIndex].type = MIN_HEAP;
+    window->maxheap_heapifyDown(window, 0);
+    window->minheap_heapifyDown(window, 0);
 }
 
 static inline size_t heap_calculate_children(size_t heapLength, size_t position) {
@@ -393,47 +915,52 @@ static inline size_t heap_calculate_children(size_t heapLength, size_t position)
         (heapLength - minChildPosition) : ((maxChildPosition - minChildPosition) + 1);
 }
 
-static inline bool heaps_can_rebalance(MedianWindow *restrict window) {
+static inline bool heaps_can_rebalance(HEAP_WINDOW *restrict window) {
     return ((window->maxHeapLength > 0) && (window->minHeapLength > 0));
 }
 
-static inline void medianwindow_maxheap_root_to_minheap_root(MedianWindow *restrict window) {
-    HeapNode *lastNode = window->maxHeap[window->maxHeapLength - 1];
+static inline void medianwindow_maxheap_root_to_minheap_root(HEAP_WINDOW *restrict window) {
+    const size_t lastPosition = (window->maxHeapLength - 1);
     window->maxHeapLength -= 1;
-    HeapNode *rootNode = window->maxHeap[0];
-
-    if(lastNode != rootNode) {
-        lastNode->position = 0;
-        window->maxHeap[0] = lastNode;
-        maxheap_heapifyDown(window->maxHeap, window->maxHeapLength, 0);
+    const HEAP_VALUE rootValue = window->maxHeap[0];
+    const uint32_t rootNodeIndex = window->maxHeapNodes[0];
+
+    if(lastPosition != 0) {
+        const uint32_t lastNodeIndex = window->maxHeapNodes[lastPosition];
+        window->nodes[lastNodeIndex].position = 0;
+        window->maxHeap[0] = window->maxHeap[lastPosition];
+        window->maxHeapNodes[0] = lastNodeIndex;
+        window->maxheap_heapifyDown(window, 0);
     }
 
-    const size_t inputPosition = minheap_put(window, rootNode);
-    minheap_heapifyUp(window->minHeap, inputPosition);
+    const size_t inputPosition = minheap_put(window, rootNodeIndex, rootValue);
+    minheap_heapifyUp(window, inputPosition);
     if(heaps_can_rebalance(window))
         heaps_rebalance(window);
 }
 
-static inline void medianwindow_minheap_root_to_maxheap_root(MedianWindow *restrict window) {
-    HeapNode *lastNode = window->minHeap[window->minHeapLength - 1];
+static inline void medianwindow_minheap_root_to_maxheap_root(HEAP_WINDOW *restrict window) {
+    const size_t lastPosition = (window->minHeapLength - 1);
     window->minHeapLength -= 1;
-    HeapNode *rootNode = window->minHeap[0];
-
-    if(lastNode != rootNode) {
-        lastNode->position = 0;
-        window->minHeap[0] = lastNode;
-        minheap_heapifyDown(window->minHeap, window->minHeapLength, 0);
+    const HEAP_VALUE rootValue = window->minHeap[0];
+    const uint32_t rootNodeIndex = window->minHeapNodes[0];
+
+    if(lastPosition != 0) {
+        const uint32_t lastNodeIndex = window->minHeapNodes[lastPosition];
+        window->nodes[lastNodeIndex].position = 0;
+        window->minHeap[0] = window->minHeap[lastPosition];
+        window->minHeapNodes[0] = lastNodeIndex;
+        window->minheap_heapifyDown(window, 0);
     }
 
-    const size_t inputPosition = maxheap_put(window, rootNode);
-    maxheap_heapifyUp(window->maxHeap, inputPosition);
+    const size_t inputPosition = maxheap_put(window, rootNodeIndex, rootValue);
+    maxheap_heapifyUp(window, inputPosition);
     if(heaps_can_rebalance(window))
         heaps_rebalance(window);
 }
 
-static inline void medianwindow_put_spc_number(MedianWindow *restrict window, HeapNode *restrict targetNode) {
+static inline void medianwindow_put_spc_number(HEAP_WINDOW *restrict window, HeapNode *restrict targetNode) {
     targetNode->position = SPC_NUMBER_INPUT_POSITION;
     targetNode->type = SPC_NUMBER;
-    targetNode->isNaN = true;
     window->spcNumbers += 1;
 }
@@ -4,13 +4,28 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include "medianwindow_api.h"
 
 #define STD_ALIGNMENT 8
+// Rounds a size up to a multiple of STD_ALIGNMENT, so the memory behind it stays aligned
+static inline size_t aligned_size(size_t size) {
+    return (size + ((STD_ALIGNMENT - (size % STD_ALIGNMENT)) % STD_ALIGNMENT));
+}
+
+// The arity of both heaps can be selected at build time, e.g. -DK_ARY_HEAP_CHILDREN=4
+#ifndef K_ARY_HEAP_CHILDREN
 #define K_ARY_HEAP_CHILDREN 8
-#define HEAP_PARENT_FORMULAR(position) (position - 1) / K_ARY_HEAP_CHILDREN
-#define HEAP_CHILDREN_FORMULAR(position, num_child) (position * K_ARY_HEAP_CHILDREN) + num_child
-#define SPC_NUMBER_INPUT_POSITION SIZE_MAX
+#endif
+#if (K_ARY_HEAP_CHILDREN != 2) && (K_ARY_HEAP_CHILDREN != 4) && (K_ARY_HEAP_CHILDREN != 8) \
+    && (K_ARY_HEAP_CHILDREN != 16)
+#error "K_ARY_HEAP_CHILDREN must be 2, 4, 8 or 16"
+#endif
+#define HEAP_PARENT_FORMULAR(position) (((position) - 1) / K_ARY_HEAP_CHILDREN)
+#define HEAP_CHILDREN_FORMULAR(position, num_child) (((position) * K_ARY_HEAP_CHILDREN) + (num_child))
+#define SPC_NUMBER_INPUT_POSITION UINT32_MAX
+#define MEDIANWINDOW_MAX_WINDOWSIZE ((size_t) UINT32_MAX)
 
 typedef enum HeapType {
     MAX_HEAP,
@@ -18,28 +33,44 @@ typedef enum HeapType {
     SPC_NUMBER
 } HeapType;
 
+// The nodes form a ring inside MedianWindow.nodes, MedianWindow.tail is the ring index of the oldest node.
+// A node holding a NaN is of type SPC_NUMBER.
+// The max-heap holds the split(n) smallest of the n valid values and the min-heap the others, where
+// split(n) = floor((n - 1) * quantile) + 1, or ((n - 1) * (rank - 1)) / (windowSize - 1) + 1 if rank is not 0.
+// A median window splits at the quantile 0.5. A window with countSplit keeps min(rank, n) values in the max-heap,
+// its split can be moved by one value at a time.
 typedef struct HeapNode {
-    double value;
-    size_t position;
-    struct HeapNode *next;
+    uint32_t position;
     HeapType type;
-    bool isNaN;
 } HeapNode;
 
+// The child selection of the heapify-down loops. A window uses the widest one the host supports.
+typedef enum MedianWindowChildSelection {
+    MEDIANWINDOW_CHILD_SELECTION_SCALAR,
+    MEDIANWINDOW_CHILD_SELECTION_AVX2,
+    MEDIANWINDOW_CHILD_SELECTION_AVX512
+} MedianWindowChildSelection;
+
 typedef struct MedianWindow {
     size_t windowSize;
     size_t currentSize;
     size_t steps;
     size_t stepDistance;
-    HeapNode **maxHeap;
+    double *maxHeap;
+    uint32_t *maxHeapNodes;
     size_t maxHeapLength;
-    HeapNode **minHeap;
+    double *minHeap;
+    uint32_t *minHeapNodes;
     size_t minHeapLength;
-    HeapNode *tail;
-    HeapNode *head;
+    size_t tail;
     HeapNode *nodes;
     size_t spcNumbers;
     bool ignoreNaNWindows;
+    double quantile;
+    size_t rank;
+    bool countSplit;
+    void (*maxheap_heapifyDown) (struct MedianWindow *restrict, size_t);
+    void (*minheap_heapifyDown) (struct MedianWindow *restrict, size_t);
 } MedianWindow;
 
 void medianwindow_initialize(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
@@ -47,10 +78,156 @@ void medianwindow_initialize(char **memory, size_t windowSize, size_t steps, boo
 void medianwindow_addNew(MedianWindow *restrict window, double value);
 void medianwindow_updateOld(MedianWindow *restrict window, double value);
 void medianwindow_result(MedianWindow *restrict window, double *restrict resultDest);
+void medianwindow_copy(char **memory, const MedianWindow *restrict source, MedianWindow **window);
+// The memory the initialization moves past, a multiple of STD_ALIGNMENT (see medianwindow_pack_size)
 size_t medianwindow_est_mem(size_t windowSize);
+// Makes the window use another child selection, e.g. to compare the vector kernels with the scalar one. Returns false
+// (and keeps the current one) if the selection is not built for this value type and arity or the CPU lacks it.
+bool medianwindow_use_child_selection(MedianWindow *restrict window, MedianWindowChildSelection selection);
+
+// A window of the given quantile (0 <= quantile <= 1) or, if rank is not 0, of the rank-th smallest value
+// (1 <= rank <= windowSize). medianwindow_quantile_result interpolates between the values at both sides of the split.
+void medianwindow_initialize_quantile(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    double quantile, size_t rank, MedianWindow **window);
+void medianwindow_quantile_result(MedianWindow *restrict window, MedianWindowInterpolation interpolation,
+    double *restrict resultDest);
+
+// A window whose max-heap holds the split smallest valid values. medianwindow_move_split moves one more value into
+// the max-heap (up) or out of it. Both heaps can hold the whole window, see medianwindow_est_mem_split.
+void medianwindow_initialize_split(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    size_t split, MedianWindow **window);
+void medianwindow_move_split(MedianWindow *restrict window, bool up);
+size_t medianwindow_est_mem_split(size_t windowSize);
+// The memory of count windows packed one after another, as the quantiles, MAD and IQR windows and the streams take
+// them. Every window starts aligned behind the one before it.
+static inline size_t medianwindow_pack_size(size_t count, size_t windowSize) {
+    return (count * aligned_size(medianwindow_est_mem(windowSize)));
+}
+static inline size_t medianwindow_pack_size_split(size_t count, size_t windowSize) {
+    return (count * aligned_size(medianwindow_est_mem_split(windowSize)));
+}
+// The second largest value of the max-heap and the second smallest of the min-heap (NaN if there is none)
+double medianwindow_maxheap_second(const MedianWindow *restrict window);
+double medianwindow_minheap_second(const MedianWindow *restrict window);
+
+// Windows over other value types share the layout of MedianWindow. median_window_f32.c, median_window_i32.c and
+// median_window_i64.c implement them with the suffixes _f32, _i32 and _i64. A 64-byte cache line holds 16 float
+// or int32 heap values instead of 8, and a vector compares twice as many children.
+#define MEDIANWINDOW_TYPED_STRUCT(NAME, VALUE) \
+typedef struct NAME { \
+    size_t windowSize; \
+    size_t currentSize; \
+    size_t steps; \
+    size_t stepDistance; \
+    VALUE *maxHeap; \
+    uint32_t *maxHeapNodes; \
+    size_t maxHeapLength; \
+    VALUE *minHeap; \
+    uint32_t *minHeapNodes; \
+    size_t minHeapLength; \
+    size_t tail; \
+    HeapNode *nodes; \
+    size_t spcNumbers; \
+    bool ignoreNaNWindows; \
+    double quantile; \
+    size_t rank; \
+    bool countSplit; \
+    void (*maxheap_heapifyDown) (struct NAME *restrict, size_t); \
+    void (*minheap_heapifyDown) (struct NAME *restrict, size_t); \
+} NAME;
+
+MEDIANWINDOW_TYPED_STRUCT(MedianWindow_F32, float)
+MEDIANWINDOW_TYPED_STRUCT(MedianWindow_I32, int32_t)
+MEDIANWINDOW_TYPED_STRUCT(MedianWindow_I64, int64_t)
+
+// Whether a window holds windowSize values, and whether the current move is one of every steps-th whose result is
+// written. The sliding loops of all value types share them, the suffix follows the one of the window functions.
+#define MEDIANWINDOW_STEPPING_HELPERS(NAME, SUFFIX) \
+static inline bool median_window_full##SUFFIX(NAME *window) { \
+    return (window->currentSize == window->windowSize); \
+} \
+\
+static inline bool median_window_steps_reached##SUFFIX(NAME *window) { \
+    if(window->stepDistance == 0) { \
+        window->stepDistance = window->steps - 1; \
+        return true; \
+    } \
+\
+    window->stepDistance -= 1; \
+    return false; \
+}
+
+MEDIANWINDOW_STEPPING_HELPERS(MedianWindow, )
+MEDIANWINDOW_STEPPING_HELPERS(MedianWindow_F32, _f32)
+MEDIANWINDOW_STEPPING_HELPERS(MedianWindow_I32, _i32)
+MEDIANWINDOW_STEPPING_HELPERS(MedianWindow_I64, _i64)
+
+void medianwindow_initialize_f32(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindow_F32 **window);
+void medianwindow_addNew_f32(MedianWindow_F32 *restrict window, float value);
+void medianwindow_updateOld_f32(MedianWindow_F32 *restrict window, float value);
+void medianwindow_result_f32(MedianWindow_F32 *restrict window, float *restrict resultDest);
+void medianwindow_copy_f32(char **memory, const MedianWindow_F32 *restrict source, MedianWindow_F32 **window);
+size_t medianwindow_est_mem_f32(size_t windowSize);
+bool medianwindow_use_child_selection_f32(MedianWindow_F32 *restrict window, MedianWindowChildSelection selection);
+void medianwindow_initialize_quantile_f32(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    double quantile, size_t rank, MedianWindow_F32 **window);
+void medianwindow_quantile_result_f32(MedianWindow_F32 *restrict window, MedianWindowInterpolation interpolation,
+    float *restrict resultDest);
+
+// The integer windows hold no NaN values, so ignoreNaNWindows has no effect on them
+void medianwindow_initialize_i32(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindow_I32 **window);
+void medianwindow_addNew_i32(MedianWindow_I32 *restrict window, int32_t value);
+void medianwindow_updateOld_i32(MedianWindow_I32 *restrict window, int32_t value);
+void medianwindow_result_i32(MedianWindow_I32 *restrict window, MedianWindowAveraging averaging,
+    int32_t *restrict resultDest);
+void medianwindow_copy_i32(char **memory, const MedianWindow_I32 *restrict source, MedianWindow_I32 **window);
+size_t medianwindow_est_mem_i32(size_t windowSize);
+bool medianwindow_use_child_selection_i32(MedianWindow_I32 *restrict window, MedianWindowChildSelection selection);
+
+void medianwindow_initialize_i64(char **memory, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindow_I64 **window);
+void medianwindow_addNew_i64(MedianWindow_I64 *restrict window, int64_t value);
+void medianwindow_updateOld_i64(MedianWindow_I64 *restrict window, int64_t value);
+void medianwindow_result_i64(MedianWindow_I64 *restrict window, MedianWindowAveraging averaging,
+    int64_t *restrict resultDest);
+void medianwindow_copy_i64(char **memory, const MedianWindow_I64 *restrict source, MedianWindow_I64 **window);
+size_t medianwindow_est_mem_i64(size_t windowSize);
+bool medianwindow_use_child_selection_i64(MedianWindow_I64 *restrict window, MedianWindowChildSelection selection);
+
+// The median of an even integer window: floor((lower + upper) / 2) without the overflow of lower + upper, or one of
+// both middle values. >> rounds negative values down with GCC and clang.
+#define MEDIANWINDOW_AVERAGE(lower, upper, averaging) \
+    (((averaging) == MEDIANWINDOW_AVERAGING_LOWER) ? (lower) : ((averaging) == MEDIANWINDOW_AVERAGING_UPPER) ? \
+    (upper) : (((lower) & (upper)) + (((lower) ^ (upper)) >> 1)))
+
+// The value of a quantile between the values lower <= upper at the positions lowerPosition and lowerPosition + 1 of
+// the sorted window, where fraction is the part of the position of the quantile behind lowerPosition
+static inline double medianwindow_interpolate(double lower, double upper, double fraction, size_t lowerPosition,
+    MedianWindowInterpolation interpolation) {
+    if(fraction == 0.0)
+        return lower;
+
+    switch (interpolation) {
+        case MEDIANWINDOW_INTERPOLATION_LOWER:
+            return lower;
+        case MEDIANWINDOW_INTERPOLATION_HIGHER:
+            return upper;
+        case MEDIANWINDOW_INTERPOLATION_NEAREST:
+            if(fraction == 0.5)
+                return ((lowerPosition % 2) == 0) ? lower : upper;
+            return (fraction < 0.5) ? lower : upper;
+        case MEDIANWINDOW_INTERPOLATION_MIDPOINT:
+            return (lower + upper) / 2;
+        default:
+            return lower + ((upper - lower) * fraction);
+    }
+}
 
 #define SIZE_OF_HEAPNODE sizeof(HeapNode)
-#define SIZE_OF_HEAPNODE_PTR sizeof(HeapNode*)
+#define SIZE_OF_HEAP_VALUE sizeof(double)
+#define SIZE_OF_HEAP_NODE_INDEX sizeof(uint32_t)
 #define SIZE_OF_MEDIANWINDOW sizeof(MedianWindow)
 
 #endif
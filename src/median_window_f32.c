@@ -0,0 +1,14 @@
+/**
+ * @file median_window_f32.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file compiles the double-heap sliding median window of median_window.c for float values.
+ *        Its public functions carry the suffix _f32 and operate on a MedianWindow_F32.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define MEDIANWINDOW_FLOAT
+#include "median_window.c"
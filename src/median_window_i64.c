@@ -0,0 +1,14 @@
+/**
+ * @file median_window_i64.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file compiles the double-heap sliding median window of median_window.c for int64_t values.
+ *        Its public functions carry the suffix _i64 and operate on a MedianWindow_I64.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define MEDIANWINDOW_INT64
+#include "median_window.c"
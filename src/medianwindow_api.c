@@ -1,12 +1,341 @@
+#include <stdint.h>
+
 #include "medianwindow_api.h"
 #include "median.h"
 
-#define TINY_MEDIANWINDOW_THRESHOLD 8
+#include "medianwindow_cost_model.h"
+#include "parallel_medianwindow.h"
+
+struct MedianWindowStream {
+    MedianWindow *window;
+};
+
+#define SIZE_OF_MEDIANWINDOW_STREAM sizeof(MedianWindowStream)
+
+// Calibrating or loading copies the new model into costModel while costModelGeneration is odd. A call copies the
+// model and copies it again if the generation was odd or changed meanwhile, so it always chooses by a complete model.
+// The model never leaves this static storage, so publishing allocates nothing that could outlive a call.
+static MedianWindowCostModel costModel = MEDIANWINDOW_COST_MODEL_DEFAULT;
+static uint64_t costModelGeneration = 0;
+
+#define COST_MODEL_VALUES (sizeof(MedianWindowCostModel) / sizeof(double))
+
+static inline void medianwindow_cost_model(MedianWindowCostModel *model);
+static void medianwindow_publish_cost_model(const MedianWindowCostModel *model);
 
 bool sliding_medianwindow(double *inputArray, size_t length, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, double *outputArray) {
+    return sliding_medianwindow_with_engine(inputArray, length, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_AUTO, outputArray);
+}
+
+bool sliding_medianwindow_with_engine(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowEngine engine, double *outputArray) {
+    if(engine == MEDIANWINDOW_ENGINE_AUTO) {
+        MedianWindowCostModel model;
+        medianwindow_cost_model(&model);
+        engine = medianwindow_cost_model_choose_offline(&model, inputArray, length, windowSize, steps);
+
+        // The samples of the cost model may have missed a value the histogram cannot count, which the histogram
+        // engine finds while it scans the input for its range. Then the best engine without a histogram takes over.
+        if(engine == MEDIANWINDOW_ENGINE_HISTOGRAM) {
+            if(sliding_histogram_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray))
+                return true;
+            engine = medianwindow_cost_model_choose(&model, inputArray, length, windowSize, steps);
+        }
+    }
+
+    switch (engine) {
+        case MEDIANWINDOW_ENGINE_TINY:
+            if(windowSize > TINY_MEDIANWINDOW_THRESHOLD)
+                return false;
+            return sliding_tiny_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+        case MEDIANWINDOW_ENGINE_HEAP:
+            return sliding_heap_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+        case MEDIANWINDOW_ENGINE_SELECT:
+            return sliding_select_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray);
+        case MEDIANWINDOW_ENGINE_SORTED:
+            return sliding_sorted_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray);
+        case MEDIANWINDOW_ENGINE_FENWICK:
+            return sliding_fenwick_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray);
+        case MEDIANWINDOW_ENGINE_HISTOGRAM:
+            return sliding_histogram_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray);
+        default:
+            return false;
+    }
+}
+
+bool sliding_medianwindow_u8(const uint8_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    double *outputArray) {
+    return sliding_histogram_medianwindow_u8(inputArray, length, windowSize, steps, outputArray);
+}
+
+bool sliding_medianwindow_u16(const uint16_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    double *outputArray) {
+    return sliding_histogram_medianwindow_u16(inputArray, length, windowSize, steps, outputArray);
+}
+
+bool sliding_medianwindow_f32(float *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, float *outputArray) {
+    // The other engines only exist for double values
+    if(windowSize <= TINY_MEDIANWINDOW_THRESHOLD)
+        return sliding_tiny_medianwindow_f32(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+
+    return sliding_heap_medianwindow_f32(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+}
+
+bool sliding_medianwindow_quantile(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double quantile, MedianWindowInterpolation interpolation, double *outputArray) {
+    if(!((quantile >= 0.0) && (quantile <= 1.0)) || (interpolation > MEDIANWINDOW_INTERPOLATION_MIDPOINT))
+        return false;
+
+    return sliding_heap_quantilewindow(inputArray, length, windowSize, steps, ignoreNaNWindows, quantile, 0,
+        interpolation, outputArray);
+}
+
+bool sliding_medianwindow_quantiles(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    double *outputArray) {
+    if((quantiles == NULL) || (interpolation > MEDIANWINDOW_INTERPOLATION_MIDPOINT))
+        return false;
+
+    for(size_t i = 0; i < numQuantiles; i++) {
+        if(!((quantiles[i] >= 0.0) && (quantiles[i] <= 1.0)))
+            return false;
+    }
+
+    return sliding_quantiles_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, quantiles,
+        numQuantiles, interpolation, outputArray);
+}
+
+bool sliding_medianwindow_rank(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, size_t rank, double *outputArray) {
+    if((rank == 0) || (rank > windowSize))
+        return false;
+
+    return sliding_heap_quantilewindow(inputArray, length, windowSize, steps, ignoreNaNWindows, 0.0, rank,
+        MEDIANWINDOW_INTERPOLATION_LOWER, outputArray);
+}
+
+bool sliding_medianwindow_mad(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *medianArray, double *madArray) {
+    return sliding_mad_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, medianArray, madArray);
+}
+
+bool sliding_medianwindow_iqr(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowInterpolation interpolation, double *outputArray) {
+    if(interpolation > MEDIANWINDOW_INTERPOLATION_MIDPOINT)
+        return false;
+
+    return sliding_iqr_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, interpolation,
+        outputArray);
+}
+
+bool sliding_medianwindow_hampel(const double *inputArray, size_t length, size_t halfWindow, double threshold,
+    bool ignoreNaNWindows, double *outputArray, uint8_t *outlierMask) {
+    return sliding_hampel_medianwindow(inputArray, length, halfWindow, threshold, ignoreNaNWindows, outputArray,
+        outlierMask);
+}
+
+bool sliding_medianwindow_i32(const int32_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int32_t *outputArray) {
+    if(averaging > MEDIANWINDOW_AVERAGING_UPPER)
+        return false;
+
     if(windowSize <= TINY_MEDIANWINDOW_THRESHOLD)
-        return sliding_tiny_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+        return sliding_tiny_medianwindow_i32(inputArray, length, windowSize, steps, averaging, outputArray);
+
+    return sliding_heap_medianwindow_i32(inputArray, length, windowSize, steps, averaging, outputArray);
+}
+
+bool sliding_medianwindow_i64(const int64_t *inputArray, size_t length, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, int64_t *outputArray) {
+    if(averaging > MEDIANWINDOW_AVERAGING_UPPER)
+        return false;
+
+    if(windowSize <= TINY_MEDIANWINDOW_THRESHOLD)
+        return sliding_tiny_medianwindow_i64(inputArray, length, windowSize, steps, averaging, outputArray);
+
+    return sliding_heap_medianwindow_i64(inputArray, length, windowSize, steps, averaging, outputArray);
+}
+
+bool sliding_medianwindow_parallel(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *outputArray, size_t numThreads) {
+    if(!medianwindow_valid_input(inputArray, length, windowSize, steps, outputArray))
+        return false;
+
+    MedianWindowCostModel model;
+    medianwindow_cost_model(&model);
+    const MedianWindowEngine engine = medianwindow_cost_model_choose(&model, inputArray, length, windowSize, steps);
+    return parallel_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, engine, outputArray,
+        numThreads);
+}
+
+bool sliding_medianwindow_batch(double *inputMatrix, size_t numSeries, size_t maxLength, const size_t *lengths,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout, double *outputMatrix,
+    size_t numThreads) {
+    if((numSeries == 0) || ((layout != MEDIANWINDOW_ROW_MAJOR) && (layout != MEDIANWINDOW_COLUMN_MAJOR)))
+        return false;
+
+    for(size_t i = 0; i < numSeries; i++) {
+        const size_t length = (lengths != NULL) ? lengths[i] : maxLength;
+        if((length > maxLength)
+            || (!medianwindow_valid_input(inputMatrix, length, windowSize, steps, outputMatrix)))
+            return false;
+    }
+
+    MedianWindowCostModel model;
+    medianwindow_cost_model(&model);
+    return parallel_medianwindow_batch(inputMatrix, numSeries, maxLength, lengths, windowSize, steps,
+        ignoreNaNWindows, layout, outputMatrix, &model, numThreads);
+}
+
+bool medianwindow_calibrate(const char *path) {
+    MedianWindowCostModel fittedModel;
+    if(!medianwindow_cost_model_fit(&fittedModel))
+        return false;
+
+    if((path != NULL) && (!medianwindow_cost_model_save(&fittedModel, path)))
+        return false;
+
+    medianwindow_publish_cost_model(&fittedModel);
+    return true;
+}
+
+bool medianwindow_load_calibration(const char *path) {
+    MedianWindowCostModel loadedModel;
+    if(!medianwindow_cost_model_load(&loadedModel, path))
+        return false;
+
+    medianwindow_publish_cost_model(&loadedModel);
+    return true;
+}
+
+static inline void medianwindow_cost_model(MedianWindowCostModel *model) {
+    const double *source = (const double* ) &costModel;
+    double *target = (double* ) model;
+    uint64_t generation;
+    do {
+        generation = __atomic_load_n(&costModelGeneration, __ATOMIC_ACQUIRE);
+        for(size_t i = 0; i < COST_MODEL_VALUES; i++)
+            __atomic_load(&source[i], &target[i], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (((generation % 2) != 0) || (generation != __atomic_load_n(&costModelGeneration, __ATOMIC_RELAXED)));
+}
+
+static void medianwindow_publish_cost_model(const MedianWindowCostModel *model) {
+    const double *source = (const double* ) model;
+    double *target = (double* ) &costModel;
+    // Only one calibration at a time makes the generation odd, the others wait until it is even again
+    uint64_t generation = __atomic_load_n(&costModelGeneration, __ATOMIC_RELAXED);
+    do {
+        generation &= ~((uint64_t) 1);
+    } while (!__atomic_compare_exchange_n(&costModelGeneration, &generation, (generation + 1), false,
+        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for(size_t i = 0; i < COST_MODEL_VALUES; i++)
+        __atomic_store(&target[i], &source[i], __ATOMIC_RELAXED);
+    __atomic_store_n(&costModelGeneration, (generation + 2), __ATOMIC_RELEASE);
+}
+
+size_t sliding_medianwindow_ws_size(size_t windowSize) {
+    // The workspace must fit every engine the cost model may choose
+    return medianwindow_engines_est_mem(windowSize);
+}
+
+bool sliding_medianwindow_ws(double *inputArray, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, double *outputArray, void *workspace, size_t workspaceSize) {
+    if((workspace == NULL) || (((uintptr_t) workspace % STD_ALIGNMENT) != 0)
+        || (workspaceSize < sliding_medianwindow_ws_size(windowSize)))
+        return false;
+
+    MedianWindowCostModel model;
+    medianwindow_cost_model(&model);
+    switch (medianwindow_cost_model_choose(&model, inputArray, length, windowSize, steps)) {
+        case MEDIANWINDOW_ENGINE_TINY:
+            return sliding_tiny_medianwindow_ws(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray, (char* ) workspace);
+        case MEDIANWINDOW_ENGINE_SELECT:
+            return sliding_select_medianwindow_ws(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray, (char* ) workspace);
+        case MEDIANWINDOW_ENGINE_SORTED:
+            return sliding_sorted_medianwindow_ws(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray, (char* ) workspace);
+        default:
+            return sliding_heap_medianwindow_ws(inputArray, length, windowSize, steps, ignoreNaNWindows,
+                outputArray, (char* ) workspace);
+    }
+}
+
+MedianWindowStream *medianwindow_stream_create(size_t windowSize, bool ignoreNaNWindows) {
+    if((windowSize <= 1) || (windowSize > MEDIANWINDOW_MAX_WINDOWSIZE))
+        return NULL;
+
+    const size_t neededMemory = (SIZE_OF_MEDIANWINDOW_STREAM + medianwindow_pack_size(1, windowSize));
+    char *memory = (char* ) malloc(neededMemory);
+    if(memory == NULL)
+        return NULL;
+
+    MedianWindowStream *stream = (MedianWindowStream* ) memory;
+    memory += SIZE_OF_MEDIANWINDOW_STREAM;
+    medianwindow_initialize(&memory, windowSize, 1, ignoreNaNWindows, &stream->window);
+    return stream;
+}
+
+bool medianwindow_stream_push(MedianWindowStream *stream, double value) {
+    if(stream == NULL)
+        return false;
+
+    MedianWindow *window = stream->window;
+    if(window->currentSize == window->windowSize)
+        medianwindow_updateOld(window, value);
+    else
+        medianwindow_addNew(window, value);
+    return true;
+}
+
+bool medianwindow_stream_push_many(MedianWindowStream *stream, const double *values, size_t length,
+    double *outputArray) {
+    if((stream == NULL) || ((values == NULL) && (length > 0)))
+        return false;
+
+    for(size_t i = 0; i < length; i++) {
+        medianwindow_stream_push(stream, values[i]);
+        if(outputArray != NULL)
+            medianwindow_result(stream->window, &outputArray[i]);
+    }
+
+    return true;
+}
+
+bool medianwindow_stream_median(MedianWindowStream *stream, double *result) {
+    if((stream == NULL) || (result == NULL) || (stream->window->currentSize == 0))
+        return false;
+
+    medianwindow_result(stream->window, result);
+    return true;
+}
+
+MedianWindowStream *medianwindow_stream_clone(const MedianWindowStream *stream) {
+    if(stream == NULL)
+        return NULL;
+
+    const size_t neededMemory = (SIZE_OF_MEDIANWINDOW_STREAM + medianwindow_pack_size(1, stream->window->windowSize));
+    char *memory = (char* ) malloc(neededMemory);
+    if(memory == NULL)
+        return NULL;
+
+    MedianWindowStream *clonedStream = (MedianWindowStream* ) memory;
+    memory += SIZE_OF_MEDIANWINDOW_STREAM;
+    medianwindow_copy(&memory, stream->window, &clonedStream->window);
+    return clonedStream;
+}
 
-    return sliding_heap_medianwindow(inputArray, length, windowSize, steps, ignoreNaNWindows, outputArray);
+void medianwindow_stream_destroy(MedianWindowStream *stream) {
+    free(stream);
 }
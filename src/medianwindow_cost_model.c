@@ -0,0 +1,394 @@
+/**
+ * @file medianwindow_cost_model.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements the cost model which decides by the window size, the step size, the input length
+ *        and the share of NaN values in a sample of the input which engine processes a sliding median window.
+ *        The coefficients of the model can be fitted to the host by timing the engines on synthetic input and
+ *        stored in a small text file, so the crossover points match the hardware the library runs on.
+ * @version 0.2
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "medianwindow_cost_model.h"
+#include "median.h"
+
+#define COST_MODEL_INPUT_SAMPLES 64
+#define COST_MODEL_FILE_HEADER "medianwindow-cost-model-v6"
+// Number of consecutive windows processed by one AVX-512 network evaluation minus one
+#define COST_MODEL_CONSECUTIVE_SPAN 7
+#define COST_MODEL_COEFFICIENTS 11
+#define COST_MODEL_MAX_NAME_LENGTH 63
+
+#define CALIBRATION_INPUT_LENGTH (1 << 18)
+#define CALIBRATION_MIN_SECONDS 0.05
+#define CALIBRATION_TINY_WINDOWSIZE 16
+#define CALIBRATION_TINY_STEPS 2
+#define CALIBRATION_HEAP_SMALL_WINDOWSIZE 16
+#define CALIBRATION_HEAP_BIG_WINDOWSIZE 4096
+#define CALIBRATION_SELECT_WINDOWSIZE 1024
+#define CALIBRATION_SORTED_SMALL_WINDOWSIZE 16
+#define CALIBRATION_SORTED_BIG_WINDOWSIZE 128
+#define CALIBRATION_FENWICK_SMALL_WINDOWSIZE 256
+#define CALIBRATION_FENWICK_BIG_WINDOWSIZE 65536
+#define CALIBRATION_HISTOGRAM_WINDOWSIZE 1024
+#define CALIBRATION_HISTOGRAM_RANGE 4096
+#define CALIBRATION_NAN_RATIO 0.5
+#define CALIBRATION_SEED 0x9E3779B97F4A7C15ULL
+
+typedef bool (*engine_function)(double *restrict, size_t, size_t, size_t, bool, double *restrict);
+
+typedef struct CalibrationSample
+{
+    double firstTerm;
+    double secondTerm;
+    double seconds;
+} CalibrationSample;
+
+static double sample_input(const double *array, size_t length, size_t *binCount);
+static inline size_t number_of_medians(size_t length, size_t windowSize, size_t steps);
+static inline double network_comparators(size_t windowSize);
+static inline double fenwick_gap_levels(size_t length, size_t windowSize);
+static MedianWindowEngine cost_model_choose(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps, bool offline);
+
+static bool calibration_measure(engine_function engine, double *array, size_t windowSize, size_t steps,
+    double *result, double *seconds);
+static bool calibration_solve(const CalibrationSample *first, const CalibrationSample *second,
+    double *firstCoefficient, double *secondCoefficient);
+static void calibration_array_init(double *array, double nanRatio);
+static inline void cost_model_coefficients(MedianWindowCostModel *model, double **coefficients);
+
+static const char *costModelNames[COST_MODEL_COEFFICIENTS] = {
+    "tinyPerComparator", "tinyConsecutivePerComparator", "heapPerElement", "heapPerLevel",
+    "selectPerWindowValue", "selectPerValidValue", "sortedPerElement", "sortedPerValidValue",
+    "fenwickPerElement", "fenwickPerGapLevel", "histogramPerElement"
+};
+
+MedianWindowEngine medianwindow_cost_model_choose(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps) {
+    return cost_model_choose(model, array, length, windowSize, steps, false);
+}
+
+MedianWindowEngine medianwindow_cost_model_choose_offline(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps) {
+    return cost_model_choose(model, array, length, windowSize, steps, true);
+}
+
+static MedianWindowEngine cost_model_choose(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps, bool offline) {
+    // Invalid windows are rejected by the engine itself
+    if((array == NULL) || (windowSize <= 1) || (windowSize > length) || (steps == 0))
+        return MEDIANWINDOW_ENGINE_HEAP;
+
+    size_t binCount = 0;
+    const double validRatio = (1 - sample_input(array, length, &binCount));
+    const double elements = (double) length;
+    const double medians = (double) number_of_medians(length, windowSize, steps);
+    const double windowValues = (medians * (double) windowSize);
+
+    MedianWindowEngine engine = MEDIANWINDOW_ENGINE_HEAP;
+    double lowestCost = elements * (model->heapPerElement
+        + (validRatio * log2((double) windowSize) * model->heapPerLevel));
+
+    const double selectCost = windowValues * (model->selectPerWindowValue
+        + (validRatio * model->selectPerValidValue));
+    if(selectCost < lowestCost) {
+        engine = MEDIANWINDOW_ENGINE_SELECT;
+        lowestCost = selectCost;
+    }
+
+    const double sortedCost = elements * (model->sortedPerElement
+        + (validRatio * (double) windowSize * model->sortedPerValidValue));
+    if(sortedCost < lowestCost) {
+        engine = MEDIANWINDOW_ENGINE_SORTED;
+        lowestCost = sortedCost;
+    }
+
+    // The Fenwick engine needs the whole input up front and memory proportional to its length
+    if((offline) && (fenwick_medianwindow_fits(length))) {
+        const double fenwickCost = elements * (model->fenwickPerElement
+            + (fenwick_gap_levels(length, windowSize) * model->fenwickPerGapLevel));
+        if(fenwickCost < lowestCost) {
+            engine = MEDIANWINDOW_ENGINE_FENWICK;
+            lowestCost = fenwickCost;
+        }
+    }
+
+    // The histogram needs the whole input up front to find its range, and as many bins as the range holds integers,
+    // which must not outnumber the values of the input. The range of the samples may be smaller than the one of the
+    // input, or a value between the samples may not be an integer, which the histogram engine itself finds out.
+    if((offline) && (binCount > 0) && (binCount <= length)) {
+        const double histogramCost = (elements * model->histogramPerElement);
+        if(histogramCost < lowestCost) {
+            engine = MEDIANWINDOW_ENGINE_HISTOGRAM;
+            lowestCost = histogramCost;
+        }
+    }
+
+    if(windowSize <= TINY_MEDIANWINDOW_THRESHOLD) {
+        double perComparator = model->tinyPerComparator;
+        if(steps == 1) {
+            const double nanProbability = (1 - pow(validRatio, (double) (windowSize + COST_MODEL_CONSECUTIVE_SPAN)));
+            perComparator = (model->tinyConsecutivePerComparator + (nanProbability * model->tinyPerComparator));
+        }
+
+        const double tinyCost = (medians * network_comparators(windowSize) * perComparator);
+        if(tinyCost <= lowestCost)
+            engine = MEDIANWINDOW_ENGINE_TINY;
+    }
+
+    return engine;
+}
+
+bool medianwindow_cost_model_fit(MedianWindowCostModel *model) {
+    if(model == NULL)
+        return false;
+
+    double *array = (double* ) malloc(CALIBRATION_INPUT_LENGTH * sizeof(double));
+    double *result = (double* ) malloc(CALIBRATION_INPUT_LENGTH * sizeof(double));
+    if((array == NULL) || (result == NULL)) {
+        free(array);
+        free(result);
+        return false;
+    }
+
+    const double n = (double) CALIBRATION_INPUT_LENGTH;
+    CalibrationSample samples[2];
+    MedianWindowCostModel fittedModel;
+    bool success = true;
+
+    // Tiny: scalar networks (steps > 1) vs. networks over consecutive windows
+    calibration_array_init(array, 0);
+    const double tinyComparators = network_comparators(CALIBRATION_TINY_WINDOWSIZE);
+    double tinySeconds = 0;
+    success = calibration_measure(sliding_tiny_medianwindow, array, CALIBRATION_TINY_WINDOWSIZE,
+        CALIBRATION_TINY_STEPS, result, &tinySeconds);
+    fittedModel.tinyPerComparator = (tinySeconds / ((double) number_of_medians(CALIBRATION_INPUT_LENGTH,
+        CALIBRATION_TINY_WINDOWSIZE, CALIBRATION_TINY_STEPS) * tinyComparators));
+    success = success && calibration_measure(sliding_tiny_medianwindow, array, CALIBRATION_TINY_WINDOWSIZE, 1,
+        result, &tinySeconds);
+    fittedModel.tinyConsecutivePerComparator = (tinySeconds / ((double) number_of_medians(CALIBRATION_INPUT_LENGTH,
+        CALIBRATION_TINY_WINDOWSIZE, 1) * tinyComparators));
+
+    // Heap: a shallow vs. a deep heap
+    const size_t heapWindowSizes[2] = { CALIBRATION_HEAP_SMALL_WINDOWSIZE, CALIBRATION_HEAP_BIG_WINDOWSIZE };
+    for(size_t i = 0; (i < 2) && success; i++) {
+        samples[i].firstTerm = n;
+        samples[i].secondTerm = (n * log2((double) heapWindowSizes[i]));
+        success = calibration_measure(sliding_heap_medianwindow, array, heapWindowSizes[i], 1, result,
+            &samples[i].seconds);
+    }
+    success = success && calibration_solve(&samples[0], &samples[1], &fittedModel.heapPerElement,
+        &fittedModel.heapPerLevel);
+
+    // Sorted: a small vs. a medium window
+    const size_t sortedWindowSizes[2] = { CALIBRATION_SORTED_SMALL_WINDOWSIZE, CALIBRATION_SORTED_BIG_WINDOWSIZE };
+    for(size_t i = 0; (i < 2) && success; i++) {
+        samples[i].firstTerm = n;
+        samples[i].secondTerm = (n * (double) sortedWindowSizes[i]);
+        success = calibration_measure(sliding_sorted_medianwindow, array, sortedWindowSizes[i], 1, result,
+            &samples[i].seconds);
+    }
+    success = success && calibration_solve(&samples[0], &samples[1], &fittedModel.sortedPerElement,
+        &fittedModel.sortedPerValidValue);
+
+    // Fenwick: close vs. distant neighbours of the median among the ranks of the whole input
+    const size_t fenwickWindowSizes[2] = { CALIBRATION_FENWICK_BIG_WINDOWSIZE, CALIBRATION_FENWICK_SMALL_WINDOWSIZE };
+    for(size_t i = 0; (i < 2) && success; i++) {
+        samples[i].firstTerm = n;
+        samples[i].secondTerm = (n * fenwick_gap_levels(CALIBRATION_INPUT_LENGTH, fenwickWindowSizes[i]));
+        success = calibration_measure(sliding_fenwick_medianwindow, array, fenwickWindowSizes[i], 1, result,
+            &samples[i].seconds);
+    }
+    success = success && calibration_solve(&samples[0], &samples[1], &fittedModel.fenwickPerElement,
+        &fittedModel.fenwickPerGapLevel);
+
+    // Histogram: a window move costs the same for every window size and range of integers
+    for(size_t i = 0; i < CALIBRATION_INPUT_LENGTH; i++)
+        array[i] = floor(array[i] * CALIBRATION_HISTOGRAM_RANGE);
+    double histogramSeconds = 0;
+    success = success && calibration_measure(sliding_histogram_medianwindow, array, CALIBRATION_HISTOGRAM_WINDOWSIZE,
+        1, result, &histogramSeconds);
+    fittedModel.histogramPerElement = (histogramSeconds / n);
+
+    // Select: windows without NaN vs. windows where half of the values are NaN
+    const double nanRatios[2] = { 0, CALIBRATION_NAN_RATIO };
+    const double windowValues = ((double) number_of_medians(CALIBRATION_INPUT_LENGTH,
+        CALIBRATION_SELECT_WINDOWSIZE, CALIBRATION_SELECT_WINDOWSIZE) * CALIBRATION_SELECT_WINDOWSIZE);
+    for(size_t i = 0; (i < 2) && success; i++) {
+        calibration_array_init(array, nanRatios[i]);
+        samples[i].firstTerm = windowValues;
+        samples[i].secondTerm = (windowValues * (1 - nanRatios[i]));
+        success = calibration_measure(sliding_select_medianwindow, array, CALIBRATION_SELECT_WINDOWSIZE,
+            CALIBRATION_SELECT_WINDOWSIZE, result, &samples[i].seconds);
+    }
+    success = success && calibration_solve(&samples[0], &samples[1], &fittedModel.selectPerWindowValue,
+        &fittedModel.selectPerValidValue);
+
+    free(array);
+    array = NULL;
+    free(result);
+    result = NULL;
+
+    if(success)
+        *model = fittedModel;
+    return success;
+}
+
+bool medianwindow_cost_model_save(const MedianWindowCostModel *model, const char *path) {
+    if((model == NULL) || (path == NULL))
+        return false;
+
+    FILE *file = fopen(path, "w");
+    if(file == NULL)
+        return false;
+
+    MedianWindowCostModel copiedModel = *model;
+    double *coefficients[COST_MODEL_COEFFICIENTS];
+    cost_model_coefficients(&copiedModel, coefficients);
+
+    bool success = (fprintf(file, "%s\n", COST_MODEL_FILE_HEADER) > 0);
+    for(size_t i = 0; (i < COST_MODEL_COEFFICIENTS) && success; i++)
+        success = (fprintf(file, "%s %.17g\n", costModelNames[i], *coefficients[i]) > 0);
+
+    success = (fclose(file) == 0) && success;
+    return success;
+}
+
+bool medianwindow_cost_model_load(MedianWindowCostModel *model, const char *path) {
+    if((model == NULL) || (path == NULL))
+        return false;
+
+    FILE *file = fopen(path, "r");
+    if(file == NULL)
+        return false;
+
+    MedianWindowCostModel loadedModel = { 0 };
+    double *coefficients[COST_MODEL_COEFFICIENTS];
+    cost_model_coefficients(&loadedModel, coefficients);
+
+    char name[COST_MODEL_MAX_NAME_LENGTH + 1];
+    bool found[COST_MODEL_COEFFICIENTS] = { false };
+    bool success = ((fscanf(file, "%63s", name) == 1) && (strcmp(name, COST_MODEL_FILE_HEADER) == 0));
+
+    double value;
+    while (success && (fscanf(file, "%63s %lf", name, &value) == 2)) {
+        success = ((isfinite(value)) && (value >= 0));
+        for(size_t i = 0; i < COST_MODEL_COEFFICIENTS; i++) {
+            if(strcmp(name, costModelNames[i]) == 0) {
+                *coefficients[i] = value;
+                found[i] = true;
+            }
+        }
+    }
+
+    fclose(file);
+    for(size_t i = 0; i < COST_MODEL_COEFFICIENTS; i++)
+        success = success && found[i];
+
+    if(success)
+        *model = loadedModel;
+    return success;
+}
+
+// Returns the share of NaN values among evenly spaced samples of the input. binCount is the number of integers
+// between the smallest and the largest valid sample if all valid samples are integers a histogram can count, else 0.
+static double sample_input(const double *array, size_t length, size_t *binCount) {
+    const size_t numSamples = (length < COST_MODEL_INPUT_SAMPLES) ? length : COST_MODEL_INPUT_SAMPLES;
+    const size_t distance = (length / numSamples);
+    double samples[COST_MODEL_INPUT_SAMPLES];
+    size_t nanCount = 0;
+    for(size_t i = 0; i < numSamples; i++) {
+        samples[i] = array[i * distance];
+        nanCount += (isnan(samples[i]) != 0);
+    }
+
+    if(!histogram_medianwindow_detect(samples, numSamples, NULL, binCount))
+        *binCount = 0;
+    return ((double) nanCount / (double) numSamples);
+}
+
+static inline size_t number_of_medians(size_t length, size_t windowSize, size_t steps) {
+    return (((length - windowSize) / steps) + 1);
+}
+
+static inline double network_comparators(size_t windowSize) {
+    // A median network of a window needs about w * log2(w) comparators
+    return ((double) windowSize * log2((double) windowSize));
+}
+
+static inline double fenwick_gap_levels(size_t length, size_t windowSize) {
+    // The ranks of a window are about length / windowSize apart, the neighbour search grows with the gap
+    return log2((double) length / (double) windowSize);
+}
+
+static bool calibration_measure(engine_function engine, double *array, size_t windowSize, size_t steps,
+    double *result, double *seconds) {
+    // Repeat short runs until the clock resolution no longer matters
+    size_t runs = 0;
+    const clock_t start = clock();
+    clock_t end = start;
+    do {
+        if(!engine(array, CALIBRATION_INPUT_LENGTH, windowSize, steps, false, result))
+            return false;
+        runs++;
+        end = clock();
+    } while ((end != (clock_t) -1) && (((double) (end - start) / CLOCKS_PER_SEC) < CALIBRATION_MIN_SECONDS));
+
+    if(end == (clock_t) -1)
+        return false;
+
+    *seconds = (((double) (end - start) / CLOCKS_PER_SEC) / (double) runs);
+    return true;
+}
+
+static bool calibration_solve(const CalibrationSample *first, const CalibrationSample *second,
+    double *firstCoefficient, double *secondCoefficient) {
+    // seconds = firstTerm * firstCoefficient + secondTerm * secondCoefficient
+    const double determinant = ((first->firstTerm * second->secondTerm) - (first->secondTerm * second->firstTerm));
+    if(determinant == 0)
+        return false;
+
+    const double a = (((first->seconds * second->secondTerm) - (first->secondTerm * second->seconds)) / determinant);
+    const double b = (((first->firstTerm * second->seconds) - (first->seconds * second->firstTerm)) / determinant);
+
+    // Measurement noise can push a small coefficient below zero
+    *firstCoefficient = (a > 0) ? a : 0;
+    *secondCoefficient = (b > 0) ? b : 0;
+    return true;
+}
+
+static void calibration_array_init(double *array, double nanRatio) {
+    // A local xorshift generator, so the calibration does not change the rand() sequence of the caller
+    uint64_t state = CALIBRATION_SEED;
+    for(size_t i = 0; i < CALIBRATION_INPUT_LENGTH; i++) {
+        state ^= (state << 13);
+        state ^= (state >> 7);
+        state ^= (state << 17);
+        const double value = ((double) (state >> 11) / (double) (1ULL << 53));
+        array[i] = (value < nanRatio) ? NAN : value;
+    }
+}
+
+static inline void cost_model_coefficients(MedianWindowCostModel *model, double **coefficients) {
+    coefficients[0] = &model->tinyPerComparator;
+    coefficients[1] = &model->tinyConsecutivePerComparator;
+    coefficients[2] = &model->heapPerElement;
+    coefficients[3] = &model->heapPerLevel;
+    coefficients[4] = &model->selectPerWindowValue;
+    coefficients[5] = &model->selectPerValidValue;
+    coefficients[6] = &model->sortedPerElement;
+    coefficients[7] = &model->sortedPerValidValue;
+    coefficients[8] = &model->fenwickPerElement;
+    coefficients[9] = &model->fenwickPerGapLevel;
+    coefficients[10] = &model->histogramPerElement;
+}
@@ -0,0 +1,61 @@
+#ifndef MEDIANWINDOW_COST_MODEL_H
+#define MEDIANWINDOW_COST_MODEL_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "medianwindow_api.h"
+
+/*
+ * Estimated runtime (in seconds) of the engines, where n is the input length, w the window size,
+ * o the number of obtained medians, r the share of NaN values and c = w * log2(w) approximates the
+ * number of comparators of the median network:
+ *   tiny:   o * c * tinyPerComparator
+ *           (steps = 1: o * c * (tinyConsecutivePerComparator + p * tinyPerComparator), where
+ *            p = 1 - (1 - r)^(w + 7) is the probability that a vector of consecutive windows contains a NaN value)
+ *   heap:   n * (heapPerElement + (1 - r) * log2(w) * heapPerLevel)
+ *   select: o * w * (selectPerWindowValue + (1 - r) * selectPerValidValue)
+ *   sorted: n * (sortedPerElement + (1 - r) * w * sortedPerValidValue)
+ *   fenwick (offline only): n * (fenwickPerElement + log2(n / w) * fenwickPerGapLevel)
+ *   histogram (offline only, if the samples of the input are integers of a range of at most n values):
+ *           n * histogramPerElement
+ */
+typedef struct MedianWindowCostModel
+{
+    double tinyPerComparator;
+    double tinyConsecutivePerComparator;
+    double heapPerElement;
+    double heapPerLevel;
+    double selectPerWindowValue;
+    double selectPerValidValue;
+    double sortedPerElement;
+    double sortedPerValidValue;
+    double fenwickPerElement;
+    double fenwickPerGapLevel;
+    double histogramPerElement;
+} MedianWindowCostModel;
+
+// Fitted by medianwindow_calibrate on a x86-64 host with AVX-512 (gcc -O3 -march=native)
+#define MEDIANWINDOW_COST_MODEL_DEFAULT { \
+    .tinyPerComparator = 9.0e-10, \
+    .tinyConsecutivePerComparator = 5.8e-11, \
+    .heapPerElement = 4.0e-8, \
+    .heapPerLevel = 4.3e-9, \
+    .selectPerWindowValue = 1.6e-9, \
+    .selectPerValidValue = 1.9e-8, \
+    .sortedPerElement = 1.4e-8, \
+    .sortedPerValidValue = 8.0e-10, \
+    .fenwickPerElement = 1.4e-7, \
+    .fenwickPerGapLevel = 1.0e-8, \
+    .histogramPerElement = 3.3e-8 \
+}
+
+MedianWindowEngine medianwindow_cost_model_choose(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps);
+// Also considers the engines that need the whole input up front
+MedianWindowEngine medianwindow_cost_model_choose_offline(const MedianWindowCostModel *model, const double *array,
+    size_t length, size_t windowSize, size_t steps);
+bool medianwindow_cost_model_fit(MedianWindowCostModel *model);
+bool medianwindow_cost_model_save(const MedianWindowCostModel *model, const char *path);
+bool medianwindow_cost_model_load(MedianWindowCostModel *model, const char *path);
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file parallel_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements the sliding median window on several threads.
+ *        For a single long input sequence, the medians to obtain are split into contiguous ranges, one per thread.
+ *        Every thread processes the part of the input covered by its range (overlapping the previous part by
+ *        windowSize - 1 elements), so it warms up its own window and writes a disjoint slice of the output.
+ *        Since each median only depends on the values inside its window, the result matches the serial one bit
+ *        for bit.
+ *        For many independent input sequences (batch), the threads form a pool that claims a few sequences at a
+ *        time from a shared counter, and every thread reuses one workspace for all of its sequences.
+ * @version 0.2
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "parallel_medianwindow.h"
+
+typedef struct MedianWindowChunk
+{
+    double *array;
+    size_t length;
+    size_t windowSize;
+    size_t steps;
+    bool ignoreNaNWindows;
+    MedianWindowEngine engine;
+    double *result;
+    char *memory;
+} MedianWindowChunk;
+
+#define BATCH_SERIES_PER_CLAIM 8
+
+typedef struct MedianWindowBatch
+{
+    double *inputMatrix;
+    size_t numSeries;
+    size_t maxLength;
+    const size_t *lengths;
+    size_t windowSize;
+    size_t steps;
+    bool ignoreNaNWindows;
+    MedianWindowLayout layout;
+    double *outputMatrix;
+    size_t outputStride;
+    const MedianWindowCostModel *model;
+    size_t nextSeries;
+    pthread_mutex_t lock;
+} MedianWindowBatch;
+
+typedef struct MedianWindowBatchWorker
+{
+    MedianWindowBatch *batch;
+    char *memory;
+    double *input;
+    double *output;
+} MedianWindowBatchWorker;
+
+static void *chunk_process(void *argument);
+static void *batch_worker_process(void *argument);
+static bool batch_claim_series(MedianWindowBatch *batch, size_t *firstSeries, size_t *lastSeries);
+static void batch_series_process(MedianWindowBatch *restrict batch, MedianWindowBatchWorker *restrict worker,
+    size_t series);
+static void threads_run(void *(*function)(void* ), char *arguments, size_t argumentSize, size_t numThreads);
+static size_t online_processors(void);
+
+bool parallel_medianwindow(double *array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowEngine engine, double *result, size_t numThreads) {
+    const size_t numMedians = (((length - windowSize) / steps) + 1);
+    if(numThreads == 0)
+        numThreads = online_processors();
+    if(numThreads > numMedians)
+        numThreads = numMedians;
+
+    // Every chunk gets its own aligned part of one allocation
+    const size_t chunkMemory = aligned_size(medianwindow_engine_est_mem(engine, windowSize));
+    char *memory = (char* ) malloc(numThreads * chunkMemory);
+    MedianWindowChunk *chunks = (MedianWindowChunk* ) malloc(numThreads * sizeof(MedianWindowChunk));
+    if((memory == NULL) || (chunks == NULL)) {
+        free(memory);
+        free(chunks);
+        return false;
+    }
+
+    for(size_t i = 0; i < numThreads; i++) {
+        const size_t firstMedian = ((numMedians * i) / numThreads);
+        const size_t lastMedian = (((numMedians * (i + 1)) / numThreads) - 1);
+        chunks[i].array = &array[firstMedian * steps];
+        chunks[i].length = (((lastMedian - firstMedian) * steps) + windowSize);
+        chunks[i].windowSize = windowSize;
+        chunks[i].steps = steps;
+        chunks[i].ignoreNaNWindows = ignoreNaNWindows;
+        chunks[i].engine = engine;
+        chunks[i].result = &result[firstMedian];
+        chunks[i].memory = &memory[i * chunkMemory];
+    }
+
+    threads_run(chunk_process, (char* ) chunks, sizeof(MedianWindowChunk), numThreads);
+    free(memory);
+    memory = NULL;
+    free(chunks);
+    chunks = NULL;
+    return true;
+}
+
+bool parallel_medianwindow_batch(double *inputMatrix, size_t numSeries, size_t maxLength, const size_t *lengths,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout, double *outputMatrix,
+    const MedianWindowCostModel *model, size_t numThreads) {
+    if(numThreads == 0)
+        numThreads = online_processors();
+    if(numThreads > numSeries)
+        numThreads = numSeries;
+
+    MedianWindowBatch batch = {
+        .inputMatrix = inputMatrix,
+        .numSeries = numSeries,
+        .maxLength = maxLength,
+        .lengths = lengths,
+        .windowSize = windowSize,
+        .steps = steps,
+        .ignoreNaNWindows = ignoreNaNWindows,
+        .layout = layout,
+        .outputMatrix = outputMatrix,
+        .outputStride = (((maxLength - windowSize) / steps) + 1),
+        .model = model,
+        .nextSeries = 0
+    };
+
+    // The workspace must fit every engine the cost model may choose for a sequence. Column-major sequences
+    // are additionally gathered into (and scattered from) contiguous scratch arrays.
+    const size_t workspaceMemory = aligned_size(medianwindow_engines_est_mem(windowSize));
+    const size_t scratchMemory = (layout == MEDIANWINDOW_COLUMN_MAJOR)
+        ? ((maxLength + batch.outputStride) * sizeof(double)) : 0;
+    const size_t workerMemory = (workspaceMemory + scratchMemory);
+
+    char *memory = (char* ) malloc(numThreads * workerMemory);
+    MedianWindowBatchWorker *workers = (MedianWindowBatchWorker* ) malloc(
+        numThreads * sizeof(MedianWindowBatchWorker));
+    if((memory == NULL) || (workers == NULL) || (pthread_mutex_init(&batch.lock, NULL) != 0)) {
+        free(memory);
+        free(workers);
+        return false;
+    }
+
+    for(size_t i = 0; i < numThreads; i++) {
+        char *workerStart = &memory[i * workerMemory];
+        workers[i].batch = &batch;
+        workers[i].memory = workerStart;
+        workers[i].input = (double* ) (workerStart + workspaceMemory);
+        workers[i].output = (workers[i].input + maxLength);
+    }
+
+    threads_run(batch_worker_process, (char* ) workers, sizeof(MedianWindowBatchWorker), numThreads);
+    pthread_mutex_destroy(&batch.lock);
+    free(memory);
+    memory = NULL;
+    free(workers);
+    workers = NULL;
+    return true;
+}
+
+static void *chunk_process(void *argument) {
+    MedianWindowChunk *chunk = (MedianWindowChunk* ) argument;
+    medianwindow_engine_process(chunk->engine, chunk->array, chunk->length, chunk->windowSize, chunk->steps,
+        chunk->ignoreNaNWindows, chunk->result, chunk->memory);
+    return NULL;
+}
+
+static void *batch_worker_process(void *argument) {
+    MedianWindowBatchWorker *worker = (MedianWindowBatchWorker* ) argument;
+    size_t firstSeries;
+    size_t lastSeries;
+    while (batch_claim_series(worker->batch, &firstSeries, &lastSeries)) {
+        for(size_t i = firstSeries; i < lastSeries; i++)
+            batch_series_process(worker->batch, worker, i);
+    }
+
+    return NULL;
+}
+
+static bool batch_claim_series(MedianWindowBatch *batch, size_t *firstSeries, size_t *lastSeries) {
+    pthread_mutex_lock(&batch->lock);
+    *firstSeries = batch->nextSeries;
+    *lastSeries = ((batch->numSeries - *firstSeries) > BATCH_SERIES_PER_CLAIM)
+        ? (*firstSeries + BATCH_SERIES_PER_CLAIM) : batch->numSeries;
+    batch->nextSeries = *lastSeries;
+    pthread_mutex_unlock(&batch->lock);
+    return (*firstSeries < *lastSeries);
+}
+
+static void batch_series_process(MedianWindowBatch *restrict batch, MedianWindowBatchWorker *restrict worker,
+    size_t series) {
+    const size_t length = (batch->lengths != NULL) ? batch->lengths[series] : batch->maxLength;
+    const size_t numMedians = (((length - batch->windowSize) / batch->steps) + 1);
+    double *input = &batch->inputMatrix[series * batch->maxLength];
+    double *output = &batch->outputMatrix[series * batch->outputStride];
+    if(batch->layout == MEDIANWINDOW_COLUMN_MAJOR) {
+        for(size_t i = 0; i < length; i++)
+            worker->input[i] = batch->inputMatrix[(i * batch->numSeries) + series];
+        input = worker->input;
+        output = worker->output;
+    }
+
+    const MedianWindowEngine engine = medianwindow_cost_model_choose(batch->model, input, length,
+        batch->windowSize, batch->steps);
+    medianwindow_engine_process(engine, input, length, batch->windowSize, batch->steps, batch->ignoreNaNWindows,
+        output, worker->memory);
+
+    if(batch->layout == MEDIANWINDOW_COLUMN_MAJOR) {
+        for(size_t i = 0; i < numMedians; i++)
+            batch->outputMatrix[(i * batch->numSeries) + series] = worker->output[i];
+    }
+}
+
+static void threads_run(void *(*function)(void* ), char *arguments, size_t argumentSize, size_t numThreads) {
+    pthread_t *threads = (pthread_t* ) malloc(numThreads * sizeof(pthread_t));
+    bool *threadStarted = (bool* ) calloc(numThreads, sizeof(bool));
+
+    // The calling thread processes the first argument. If a thread cannot be started (or there is no memory
+    // to manage the threads), its argument is processed by the calling thread as well.
+    if((threads != NULL) && (threadStarted != NULL)) {
+        for(size_t i = 1; i < numThreads; i++)
+            threadStarted[i] = (pthread_create(&threads[i], NULL, function, &arguments[i * argumentSize]) == 0);
+    }
+
+    function(arguments);
+    for(size_t i = 1; i < numThreads; i++) {
+        if((threadStarted != NULL) && (threadStarted[i]))
+            pthread_join(threads[i], NULL);
+        else
+            function(&arguments[i * argumentSize]);
+    }
+
+    free(threads);
+    threads = NULL;
+    free(threadStarted);
+    threadStarted = NULL;
+}
+
+static size_t online_processors(void) {
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (processors > 0) ? (size_t) processors : 1;
+}
@@ -0,0 +1,16 @@
+#ifndef PARALLEL_MEDIANWINDOW_H
+#define PARALLEL_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "median.h"
+#include "medianwindow_cost_model.h"
+
+bool parallel_medianwindow(double *array, size_t length, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, MedianWindowEngine engine, double *result, size_t numThreads);
+
+bool parallel_medianwindow_batch(double *inputMatrix, size_t numSeries, size_t maxLength, const size_t *lengths,
+    size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout, double *outputMatrix,
+    const MedianWindowCostModel *model, size_t numThreads);
+
+#endif
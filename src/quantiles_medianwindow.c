@@ -0,0 +1,102 @@
+/**
+ * @file quantiles_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a window that yields several quantiles (e.g. p10/p50/p90 bands) per position.
+ *        All quantiles are taken from a single order-statistic B+-tree (see tree_medianwindow.c), so every
+ *        window move updates one structure whatever the number K of quantiles is. The quantiles are sorted once,
+ *        which makes the positions around them ascending, and all of them are selected by one descent of the
+ *        tree that enters every node at most once. A window therefore costs O(log windowSize + K) instead of the
+ *        O(K log windowSize) of K separate windows.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "quantiles_medianwindow.h"
+
+void quantiles_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    Quantiles_MedianWindow **window) {
+    Quantiles_MedianWindow *targetWindow = (Quantiles_MedianWindow* ) __builtin_assume_aligned(*memory,
+        STD_ALIGNMENT);
+    *memory += SIZE_OF_QUANTILES_MEDIAN_WINDOW;
+
+    targetWindow->quantiles = (double* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (numQuantiles * sizeof(double));
+    targetWindow->order = (size_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (numQuantiles * sizeof(size_t));
+    targetWindow->ranks = (size_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (2 * numQuantiles * sizeof(size_t));
+    targetWindow->values = (double* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (2 * numQuantiles * sizeof(double));
+    targetWindow->slots = (size_t* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (numQuantiles * sizeof(size_t));
+    tree_medianwindow_initialize(memory, windowSize, ignoreNaNWindows, &targetWindow->tree);
+
+    // Insertion sort, as only a few quantiles are expected
+    for(size_t i = 0; i < numQuantiles; i++) {
+        size_t position = i;
+        while ((position > 0) && (targetWindow->quantiles[position - 1] > quantiles[i])) {
+            targetWindow->quantiles[position] = targetWindow->quantiles[position - 1];
+            targetWindow->order[position] = targetWindow->order[position - 1];
+            position--;
+        }
+        targetWindow->quantiles[position] = quantiles[i];
+        targetWindow->order[position] = i;
+    }
+
+    targetWindow->numQuantiles = numQuantiles;
+    targetWindow->interpolation = interpolation;
+    *window = targetWindow;
+}
+
+void quantiles_medianwindow_add(Quantiles_MedianWindow *window, double value) {
+    tree_medianwindow_add(window->tree, value);
+}
+
+void quantiles_medianwindow_replace(Quantiles_MedianWindow *window, double oldValue, double newValue) {
+    tree_medianwindow_replace(window->tree, oldValue, newValue);
+}
+
+void quantiles_medianwindow_result(const Quantiles_MedianWindow *restrict window, double *restrict output) {
+    const Tree_MedianWindow *tree = window->tree;
+    const size_t numQuantiles = window->numQuantiles;
+    const size_t validCount = tree->validCount;
+    if((validCount == 0) || ((tree->ignoreNaNWindows) && (tree->nanCount > 0))) {
+        for(size_t i = 0; i < numQuantiles; i++)
+            output[i] = NAN;
+        return;
+    }
+
+    // A quantile q lies between the positions floor((validCount - 1) * q) and the next one. Both are ascending
+    // with the quantiles, and a position shared by neighbouring quantiles is only selected once.
+    size_t *ranks = window->ranks;
+    size_t numRanks = 0;
+    for(size_t i = 0; i < numQuantiles; i++) {
+        const size_t lowerPosition = (size_t) ((double) (validCount - 1) * window->quantiles[i]);
+        if((numRanks == 0) || (ranks[numRanks - 1] < lowerPosition))
+            ranks[numRanks++] = lowerPosition;
+        window->slots[i] = (ranks[numRanks - 1] == lowerPosition) ? (numRanks - 1) : (numRanks - 2);
+        if(((lowerPosition + 1) < validCount) && (ranks[numRanks - 1] == lowerPosition))
+            ranks[numRanks++] = (lowerPosition + 1);
+    }
+
+    tree_medianwindow_select(tree, ranks, numRanks, window->values);
+
+    for(size_t i = 0; i < numQuantiles; i++) {
+        const double position = ((double) (validCount - 1) * window->quantiles[i]);
+        const size_t slot = window->slots[i];
+        const double lower = window->values[slot];
+        const double upper = (ranks[slot] < (validCount - 1)) ? window->values[slot + 1] : lower;
+        output[window->order[i]] = medianwindow_interpolate(lower, upper, (position - floor(position)), ranks[slot],
+            window->interpolation);
+    }
+}
+
+size_t quantiles_medianwindow_est_mem(size_t windowSize, size_t numQuantiles) {
+    // quantiles and order, twice as many ranks and values, and slots
+    return (SIZE_OF_QUANTILES_MEDIAN_WINDOW + (numQuantiles * ((3 * sizeof(double)) + (4 * sizeof(size_t))))
+        + tree_medianwindow_est_mem(windowSize));
+}
@@ -0,0 +1,43 @@
+#ifndef QUANTILES_MEDIANWINDOW_H
+#define QUANTILES_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "tree_medianwindow.h"
+#include "median_window.h"
+
+// Fewer quantiles are faster with a double-heap per quantile (see sliding_quantiles_medianwindow). The tree was
+// faster from 2 quantiles on for a window of 9, from 3 on for 101 and from 4 on for 1001 and 100001.
+#define QUANTILES_MEDIANWINDOW_TREE_THRESHOLD 4
+// Input values each of these double-heaps takes in turn
+#define QUANTILES_MEDIANWINDOW_BLOCK_SIZE 4096
+
+// Several quantiles of the same window taken from one order-statistic B+-tree. quantiles holds them in ascending
+// order and order the output slot of each of them. ranks holds the distinct positions around all quantiles in
+// ascending order, values their values and slots the index of the lower position of each quantile in ranks.
+typedef struct Quantiles_MedianWindow
+{
+    Tree_MedianWindow *tree;
+    size_t numQuantiles;
+    MedianWindowInterpolation interpolation;
+    double *quantiles;
+    size_t *order;
+    size_t *ranks;
+    double *values;
+    size_t *slots;
+} Quantiles_MedianWindow;
+
+void quantiles_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    const double *quantiles, size_t numQuantiles, MedianWindowInterpolation interpolation,
+    Quantiles_MedianWindow **window);
+void quantiles_medianwindow_add(Quantiles_MedianWindow *window, double value);
+void quantiles_medianwindow_replace(Quantiles_MedianWindow *window, double oldValue, double newValue);
+void quantiles_medianwindow_result(const Quantiles_MedianWindow *restrict window, double *restrict output);
+size_t quantiles_medianwindow_est_mem(size_t windowSize, size_t numQuantiles);
+
+#define SIZE_OF_QUANTILES_MEDIAN_WINDOW sizeof(Quantiles_MedianWindow)
+
+#endif
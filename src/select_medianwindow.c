@@ -0,0 +1,134 @@
+/**
+ * @file select_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a median window that computes every window independently by a selection algorithm
+ *        (Floyd-Rivest). It is applied when the step size is a large fraction of the window size, so that
+ *        sliding the double heap over all skipped elements would cost more than selecting the median anew.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "select_medianwindow.h"
+
+#define FLOYD_RIVEST_SAMPLE_THRESHOLD 600
+
+static inline void values_copy_nan_free(const double *restrict input, size_t length, double *restrict output,
+    size_t *nanCount);
+static void floyd_rivest_select(double *values, ptrdiff_t left, ptrdiff_t right, ptrdiff_t k);
+static inline void values_swap(double *a, double *b);
+static inline double values_max(const double *values, size_t length);
+
+void select_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Select_MedianWindow **window) {
+    Select_MedianWindow *targetWindow = (Select_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_SELECT_MEDIAN_WINDOW;
+
+    double *values = (double* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (windowSize * sizeof(double));
+
+    targetWindow->windowSize = windowSize;
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->values = values;
+    *window = targetWindow;
+}
+
+void select_medianwindow_result(Select_MedianWindow *restrict window, const double *restrict input,
+    double *restrict output) {
+    double *values = window->values;
+    size_t nanCount = 0;
+    values_copy_nan_free(input, window->windowSize, values, &nanCount);
+
+    const size_t validNum = (window->windowSize - nanCount);
+    if((validNum == 0) || ((window->ignoreNaNWindows) && (nanCount > 0))) {
+        *output = NAN;
+        return;
+    }
+
+    const size_t middle = (validNum / 2);
+    floyd_rivest_select(values, 0, (ptrdiff_t) (validNum - 1), (ptrdiff_t) middle);
+    if((validNum % 2) != 0) {
+        *output = values[middle];
+        return;
+    }
+
+    // After the selection all values in front of the middle are less than or equal to it
+    *output = (values_max(values, middle) + values[middle]) / 2;
+}
+
+size_t select_medianwindow_est_mem(size_t windowSize) {
+    return (SIZE_OF_SELECT_MEDIAN_WINDOW + (windowSize * sizeof(double)));
+}
+
+static inline void values_copy_nan_free(const double *restrict input, size_t length, double *restrict output,
+    size_t *nanCount) {
+    size_t outputPosition = 0;
+    for(size_t i = 0; i < length; i++) {
+        const double v = input[i];
+        const bool isNaN = isnan(v);
+        output[outputPosition] = v;
+        outputPosition += (!isNaN);
+        *nanCount += isNaN;
+    }
+}
+
+static void floyd_rivest_select(double *values, ptrdiff_t left, ptrdiff_t right, ptrdiff_t k) {
+    while (right > left) {
+        if((right - left) > FLOYD_RIVEST_SAMPLE_THRESHOLD) {
+            // Select from a sample first, so that values[k] is a pivot close to the k-th value
+            const double n = (double) (right - left + 1);
+            const double i = (double) (k - left + 1);
+            const double z = log(n);
+            const double s = 0.5 * exp(2 * z / 3);
+            const double sd = 0.5 * sqrt(z * s * (n - s) / n) * ((i < (n / 2)) ? -1 : 1);
+            const ptrdiff_t sampleLeft = (ptrdiff_t) ((double) k - (i * s / n) + sd);
+            const ptrdiff_t sampleRight = (ptrdiff_t) ((double) k + ((n - i) * s / n) + sd);
+            floyd_rivest_select(values, (sampleLeft > left) ? sampleLeft : left,
+                (sampleRight < right) ? sampleRight : right, k);
+        }
+
+        const double pivot = values[k];
+        ptrdiff_t i = left;
+        ptrdiff_t j = right;
+        values_swap(&values[left], &values[k]);
+        if(values[right] > pivot)
+            values_swap(&values[right], &values[left]);
+
+        while (i < j) {
+            values_swap(&values[i], &values[j]);
+            i++;
+            j--;
+            while (values[i] < pivot)
+                i++;
+            while (values[j] > pivot)
+                j--;
+        }
+
+        if(values[left] == pivot) {
+            values_swap(&values[left], &values[j]);
+        } else {
+            j++;
+            values_swap(&values[j], &values[right]);
+        }
+
+        if(j <= k)
+            left = j + 1;
+        if(k <= j)
+            right = j - 1;
+    }
+}
+
+static inline void values_swap(double *a, double *b) {
+    const double tempValue = *b;
+    *b = *a;
+    *a = tempValue;
+}
+
+static inline double values_max(const double *values, size_t length) {
+    double maxValue = values[0];
+    for(size_t i = 1; i < length; i++)
+        maxValue = (values[i] > maxValue) ? values[i] : maxValue;
+    return maxValue;
+}
@@ -0,0 +1,27 @@
+#ifndef SELECT_MEDIANWINDOW_H
+#define SELECT_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+#define STD_ALIGNMENT 8
+
+typedef struct Select_MedianWindow
+{
+    size_t windowSize;
+    bool ignoreNaNWindows;
+    double *values;
+} Select_MedianWindow;
+
+void select_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Select_MedianWindow **window);
+void select_medianwindow_result(Select_MedianWindow *restrict window, const double *restrict input,
+    double *restrict output);
+size_t select_medianwindow_est_mem(size_t windowSize);
+
+#define SIZE_OF_SELECT_MEDIAN_WINDOW sizeof(Select_MedianWindow)
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file sorted_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a median window that keeps the valid values of the window in a sorted array.
+ *        Every step replaces the outgoing value by the incoming one: the values between both positions are
+ *        shifted by one. Since the array is sorted, whether a value moves follows from comparing it and its
+ *        neighbours with both values, so a single pass over the whole array without data dependent branches
+ *        does the replacement. The compiler vectorizes this pass and, unlike memmove with a random length, it
+ *        causes no branch mispredictions. The median is then just an index into the array.
+ *        For small to medium windows this beats the double heap, whose sift operations branch unpredictably,
+ *        while the median networks would have to process every window from scratch.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "sorted_medianwindow.h"
+
+#define SORTED_PADDING_VALUES 2
+
+static inline size_t values_count_less(const double *restrict values, size_t length, double value);
+static inline void values_remove(Sorted_MedianWindow *window, double value);
+static inline double *values_initialize(char **memory, size_t windowSize);
+
+void sorted_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Sorted_MedianWindow **window) {
+    Sorted_MedianWindow *targetWindow = (Sorted_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_SORTED_MEDIAN_WINDOW;
+
+    targetWindow->windowSize = windowSize;
+    targetWindow->validCount = 0;
+    targetWindow->nanCount = 0;
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->values = values_initialize(memory, windowSize);
+    targetWindow->spareValues = values_initialize(memory, windowSize);
+    *window = targetWindow;
+}
+
+void sorted_medianwindow_add(Sorted_MedianWindow *window, double value) {
+    if(isnan(value)) {
+        window->nanCount++;
+        return;
+    }
+
+    double *values = window->values;
+    const size_t position = values_count_less(values, window->validCount, value);
+    memmove(&values[position + 1], &values[position], ((window->validCount - position) * sizeof(double)));
+    values[position] = value;
+    window->validCount++;
+    values[window->validCount] = NAN;
+}
+
+void sorted_medianwindow_replace(Sorted_MedianWindow *window, double oldValue, double newValue) {
+    if(isnan(oldValue)) {
+        window->nanCount--;
+        sorted_medianwindow_add(window, newValue);
+        return;
+    }
+
+    if(isnan(newValue)) {
+        values_remove(window, oldValue);
+        window->nanCount++;
+        return;
+    }
+
+    // With p(x) as the number of values less than x, the values from p(old) up to the position of the new value
+    // move one position down and the values from it up to p(old) move one position up. The NaN padding values
+    // never satisfy a comparison, so the first and the last value need no special case.
+    const size_t validCount = window->validCount;
+    const double *restrict values = window->values;
+    double *restrict updatedValues = window->spareValues;
+    size_t newPosition = 0;
+    for(size_t i = 0; i < validCount; i++) {
+        const double belowValue = (values - 1)[i];
+        const double currentValue = values[i];
+        const double aboveValue = values[i + 1];
+        const bool fromAbove = ((currentValue >= oldValue) && (aboveValue < newValue));
+        const bool fromBelow = ((belowValue >= newValue) && (belowValue < oldValue));
+        updatedValues[i] = fromAbove ? aboveValue : (fromBelow ? belowValue : currentValue);
+        newPosition += (currentValue < newValue);
+    }
+
+    // The old value is no longer counted once it is removed
+    updatedValues[newPosition - (oldValue < newValue)] = newValue;
+    updatedValues[validCount] = NAN;
+
+    window->spareValues = window->values;
+    window->values = updatedValues;
+}
+
+void sorted_medianwindow_result(const Sorted_MedianWindow *restrict window, double *restrict output) {
+    const size_t validCount = window->validCount;
+    if((validCount == 0) || ((window->ignoreNaNWindows) && (window->nanCount > 0))) {
+        *output = NAN;
+        return;
+    }
+
+    const size_t middle = (validCount / 2);
+    if((validCount % 2) != 0) {
+        *output = window->values[middle];
+        return;
+    }
+
+    *output = (window->values[middle - 1] + window->values[middle]) / 2;
+}
+
+size_t sorted_medianwindow_est_mem(size_t windowSize) {
+    return (SIZE_OF_SORTED_MEDIAN_WINDOW + (2 * (windowSize + SORTED_PADDING_VALUES) * sizeof(double)));
+}
+
+static inline size_t values_count_less(const double *restrict values, size_t length, double value) {
+    // Faster than a binary search for the window sizes this engine is chosen for
+    size_t count = 0;
+    for(size_t i = 0; i < length; i++)
+        count += (values[i] < value);
+    return count;
+}
+
+static inline void values_remove(Sorted_MedianWindow *window, double value) {
+    double *values = window->values;
+    const size_t position = values_count_less(values, window->validCount, value);
+    window->validCount--;
+    memmove(&values[position], &values[position + 1], ((window->validCount - position) * sizeof(double)));
+    values[window->validCount] = NAN;
+}
+
+static inline double *values_initialize(char **memory, size_t windowSize) {
+    // The value behind the last valid value is kept NaN as well
+    double *values = (double* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += ((windowSize + SORTED_PADDING_VALUES) * sizeof(double));
+    for(size_t i = 0; i < (windowSize + SORTED_PADDING_VALUES); i++)
+        values[i] = NAN;
+    return (values + 1);
+}
@@ -0,0 +1,35 @@
+#ifndef SORTED_MEDIANWINDOW_H
+#define SORTED_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#define STD_ALIGNMENT 8
+
+// The valid (non-NaN) values of the window are kept sorted in values[0 .. validCount - 1],
+// NaN values are only counted. A replacement writes the updated array into spareValues and swaps both arrays.
+// Both arrays have one NaN padding value in front of and behind them, so values[-1] and values[windowSize]
+// can be read.
+typedef struct Sorted_MedianWindow
+{
+    size_t windowSize;
+    size_t validCount;
+    size_t nanCount;
+    bool ignoreNaNWindows;
+    double *values;
+    double *spareValues;
+} Sorted_MedianWindow;
+
+void sorted_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Sorted_MedianWindow **window);
+void sorted_medianwindow_add(Sorted_MedianWindow *window, double value);
+void sorted_medianwindow_replace(Sorted_MedianWindow *window, double oldValue, double newValue);
+void sorted_medianwindow_result(const Sorted_MedianWindow *restrict window, double *restrict output);
+size_t sorted_medianwindow_est_mem(size_t windowSize);
+
+#define SIZE_OF_SORTED_MEDIAN_WINDOW sizeof(Sorted_MedianWindow)
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file tiny_integer_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements the median networks of tiny_medianwindow.c for integer windows of size 2 to 25.
+ *        Integer windows hold no NaN values, so every window runs the network of its size as it is, and the
+ *        median of an even window is taken from its two middle values as selected by MedianWindowAveraging.
+ *        Every window size and averaging has its own generated loop, which is chosen once per input sequence.
+ *        For consecutive windows (steps = 1), int32 networks run on AVX2/AVX-512 vectors (8 or 16 windows per
+ *        evaluation) and int64 networks on AVX-512 vectors (8 windows), as AVX2 has no 64-bit integer min/max.
+ *        The file is compiled as is for int32_t values, and tiny_integer_medianwindow_i64.c compiles it again
+ *        with TINY_INTEGER_MEDIANWINDOW_INT64 defined for int64_t values.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "tiny_integer_medianwindow.h"
+#include "median_networks.h"
+
+#ifdef TINY_INTEGER_MEDIANWINDOW_INT64
+#define TINY_VALUE int64_t
+#define TINY_WINDOW Tiny_MedianWindow_I64
+#define TINY_FUNCTION(name) name##_i64
+#else
+#define TINY_VALUE int32_t
+#define TINY_WINDOW Tiny_MedianWindow_I32
+#define TINY_FUNCTION(name) name##_i32
+#endif
+
+#define NUMBER_OF_AVERAGINGS 3
+
+#define SCALAR_COMPARATOR(a, b) { \
+    const TINY_VALUE firstValue = values[a]; \
+    const TINY_VALUE secondValue = values[b]; \
+    values[a] = (firstValue > secondValue) ? secondValue : firstValue; \
+    values[b] = (firstValue > secondValue) ? firstValue : secondValue; \
+}
+
+// The median networks of even window sizes leave both middle values unordered, so the lower median is the smaller
+// one of them. Both are the same for odd window sizes, so every averaging returns the median.
+#define SCALAR_AVERAGE_FLOOR(first, second) (((first) & (second)) + (((first) ^ (second)) >> 1))
+#define SCALAR_AVERAGE_LOWER(first, second) (((first) > (second)) ? (second) : (first))
+#define SCALAR_AVERAGE_UPPER(first, second) (((first) > (second)) ? (first) : (second))
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TINY_INTEGER_VECTOR_NETWORKS
+#ifdef TINY_INTEGER_MEDIANWINDOW_INT64
+#define AVX512_LANES 8
+#define AVX512(name) _mm512_##name##_epi64
+#else
+#define TINY_INTEGER_AVX2_NETWORKS
+#define AVX2_LANES 8
+#define AVX512_LANES 16
+#define AVX2(name) _mm256_##name##_epi32
+#define AVX512(name) _mm512_##name##_epi32
+#endif
+
+// Lane j of vectors[i] holds the value at position i of the window j
+#define AVX2_COMPARATOR(a, b) { \
+    const __m256i lowValues = AVX2(min)(vectors[a], vectors[b]); \
+    vectors[b] = AVX2(max)(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+
+#define AVX512_COMPARATOR(a, b) { \
+    const __m512i lowValues = AVX512(min)(vectors[a], vectors[b]); \
+    vectors[b] = AVX512(max)(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+
+#define AVX2_AVERAGE_FLOOR(first, second) \
+    AVX2(add)(_mm256_and_si256((first), (second)), AVX2(srai)(_mm256_xor_si256((first), (second)), 1))
+#define AVX2_AVERAGE_LOWER(first, second) AVX2(min)((first), (second))
+#define AVX2_AVERAGE_UPPER(first, second) AVX2(max)((first), (second))
+
+#define AVX512_AVERAGE_FLOOR(first, second) \
+    AVX512(add)(_mm512_and_si512((first), (second)), AVX512(srai)(_mm512_xor_si512((first), (second)), 1))
+#define AVX512_AVERAGE_LOWER(first, second) AVX512(min)((first), (second))
+#define AVX512_AVERAGE_UPPER(first, second) AVX512(max)((first), (second))
+#endif
+
+typedef void (*tiny_integer_medians_function)(const TINY_VALUE *restrict, size_t, size_t, TINY_VALUE *restrict);
+
+static void set_medians_function(TINY_WINDOW *window, MedianWindowAveraging averaging);
+
+void TINY_FUNCTION(tiny_medianwindow_initialize)(char **memory, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, TINY_WINDOW **window) {
+    TINY_WINDOW *targetWindow = (TINY_WINDOW* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    targetWindow->windowSize = windowSize;
+    targetWindow->steps = steps;
+    set_medians_function(targetWindow, averaging);
+    *window = targetWindow;
+}
+
+void TINY_FUNCTION(tiny_medianwindow_results)(TINY_WINDOW *restrict window, const TINY_VALUE *restrict input,
+    size_t length, TINY_VALUE *restrict output) {
+    window->medians(input, length, window->steps, output);
+}
+
+#define NETWORK_MEDIAN(windowSize, AVERAGING) \
+static inline TINY_VALUE network_median##windowSize##_##AVERAGING(const TINY_VALUE *restrict input) { \
+    TINY_VALUE values[windowSize]; \
+    memcpy(values, input, sizeof(values)); \
+    MEDIAN_NETWORK_##windowSize(SCALAR_COMPARATOR) \
+    return SCALAR_AVERAGE_##AVERAGING(values[(windowSize - 1) / 2], values[windowSize / 2]); \
+}
+
+#define TINY_MEDIANS(windowSize, AVERAGING) \
+static void tiny_medians##windowSize##_##AVERAGING(const TINY_VALUE *restrict input, size_t length, size_t steps, \
+    TINY_VALUE *restrict output) { \
+    for(size_t start = 0; (start + windowSize) <= length; start += steps) \
+        *(output++) = network_median##windowSize##_##AVERAGING(&input[start]); \
+}
+
+TINY_MEDIANS_ALL_SIZES(NETWORK_MEDIAN, FLOOR)
+TINY_MEDIANS_ALL_SIZES(NETWORK_MEDIAN, LOWER)
+TINY_MEDIANS_ALL_SIZES(NETWORK_MEDIAN, UPPER)
+TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS, FLOOR)
+TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS, LOWER)
+TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS, UPPER)
+
+static const tiny_integer_medians_function tinyMedians[NUMBER_OF_AVERAGINGS][TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    [MEDIANWINDOW_AVERAGING_FLOOR] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, tiny_medians, _FLOOR) },
+    [MEDIANWINDOW_AVERAGING_LOWER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, tiny_medians, _LOWER) },
+    [MEDIANWINDOW_AVERAGING_UPPER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, tiny_medians, _UPPER) }
+};
+
+#ifdef TINY_INTEGER_VECTOR_NETWORKS
+// Consecutive windows (steps = 1) run the network on vectors, where lane j holds the window start + j.
+// Without NaN values every vector is valid, only the last windows that do not fill all lanes run the scalar network.
+#define CONSECUTIVE_TINY_MEDIANS(windowSize, AVERAGING, ISA, TARGET, LANES, VECTOR, LOAD, STORE) \
+__attribute__((target(TARGET))) \
+static void consecutive_tiny_medians##windowSize##_##AVERAGING##_##ISA(const TINY_VALUE *restrict input, \
+    size_t length, size_t steps, TINY_VALUE *restrict output) { \
+    (void) steps; \
+    const size_t numMedians = ((length - windowSize) + 1); \
+    size_t i = 0; \
+    for(; (i + LANES) <= numMedians; i += LANES) { \
+        VECTOR vectors[windowSize]; \
+        for(size_t j = 0; j < windowSize; j++) \
+            vectors[j] = LOAD((const VECTOR* ) &input[i + j]); \
+        MEDIAN_NETWORK_##windowSize(ISA##_COMPARATOR) \
+        STORE((VECTOR* ) &output[i], \
+            ISA##_AVERAGE_##AVERAGING(vectors[(windowSize - 1) / 2], vectors[windowSize / 2])); \
+    } \
+    for(; i < numMedians; i++) \
+        output[i] = network_median##windowSize##_##AVERAGING(&input[i]); \
+}
+
+#define AVX512_MEDIANS(windowSize, AVERAGING) CONSECUTIVE_TINY_MEDIANS(windowSize, AVERAGING, AVX512, "avx512f", \
+    AVX512_LANES, __m512i, _mm512_loadu_si512, _mm512_storeu_si512)
+
+TINY_MEDIANS_ALL_SIZES(AVX512_MEDIANS, FLOOR)
+TINY_MEDIANS_ALL_SIZES(AVX512_MEDIANS, LOWER)
+TINY_MEDIANS_ALL_SIZES(AVX512_MEDIANS, UPPER)
+
+static const tiny_integer_medians_function consecutiveTinyMediansAvx512[NUMBER_OF_AVERAGINGS]
+    [TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    [MEDIANWINDOW_AVERAGING_FLOOR] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _FLOOR_AVX512) },
+    [MEDIANWINDOW_AVERAGING_LOWER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _LOWER_AVX512) },
+    [MEDIANWINDOW_AVERAGING_UPPER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _UPPER_AVX512) }
+};
+
+#ifdef TINY_INTEGER_AVX2_NETWORKS
+#define AVX2_MEDIANS(windowSize, AVERAGING) CONSECUTIVE_TINY_MEDIANS(windowSize, AVERAGING, AVX2, "avx2", \
+    AVX2_LANES, __m256i, _mm256_loadu_si256, _mm256_storeu_si256)
+
+TINY_MEDIANS_ALL_SIZES(AVX2_MEDIANS, FLOOR)
+TINY_MEDIANS_ALL_SIZES(AVX2_MEDIANS, LOWER)
+TINY_MEDIANS_ALL_SIZES(AVX2_MEDIANS, UPPER)
+
+static const tiny_integer_medians_function consecutiveTinyMediansAvx2[NUMBER_OF_AVERAGINGS]
+    [TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    [MEDIANWINDOW_AVERAGING_FLOOR] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _FLOOR_AVX2) },
+    [MEDIANWINDOW_AVERAGING_LOWER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _LOWER_AVX2) },
+    [MEDIANWINDOW_AVERAGING_UPPER] = { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians,
+        _UPPER_AVX2) }
+};
+#endif
+#endif
+
+static void set_medians_function(TINY_WINDOW *window, MedianWindowAveraging averaging) {
+    window->medians = tinyMedians[averaging][window->windowSize];
+
+#ifdef TINY_INTEGER_VECTOR_NETWORKS
+    if(window->steps != 1)
+        return;
+
+    if(__builtin_cpu_supports("avx512f"))
+        window->medians = consecutiveTinyMediansAvx512[averaging][window->windowSize];
+#ifdef TINY_INTEGER_AVX2_NETWORKS
+    else if(__builtin_cpu_supports("avx2"))
+        window->medians = consecutiveTinyMediansAvx2[averaging][window->windowSize];
+#endif
+#endif
+}
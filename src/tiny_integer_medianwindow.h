@@ -0,0 +1,40 @@
+#ifndef TINY_INTEGER_MEDIANWINDOW_H
+#define TINY_INTEGER_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tiny_medianwindow.h"
+#include "median_window.h"
+
+// The median networks over integer values, implemented by tiny_integer_medianwindow.c (int32_t) and
+// tiny_integer_medianwindow_i64.c (int64_t). The median of an even window follows averaging.
+typedef struct Tiny_MedianWindow_I32
+{
+    size_t windowSize;
+    size_t steps;
+    void (*medians) (const int32_t *restrict, size_t, size_t, int32_t *restrict);
+} Tiny_MedianWindow_I32;
+
+typedef struct Tiny_MedianWindow_I64
+{
+    size_t windowSize;
+    size_t steps;
+    void (*medians) (const int64_t *restrict, size_t, size_t, int64_t *restrict);
+} Tiny_MedianWindow_I64;
+
+void tiny_medianwindow_initialize_i32(char **memory, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, Tiny_MedianWindow_I32 **window);
+void tiny_medianwindow_results_i32(Tiny_MedianWindow_I32 *restrict window, const int32_t *restrict input,
+    size_t length, int32_t *restrict output);
+
+void tiny_medianwindow_initialize_i64(char **memory, size_t windowSize, size_t steps,
+    MedianWindowAveraging averaging, Tiny_MedianWindow_I64 **window);
+void tiny_medianwindow_results_i64(Tiny_MedianWindow_I64 *restrict window, const int64_t *restrict input,
+    size_t length, int64_t *restrict output);
+
+#define SIZE_OF_TINY_MEDIAN_WINDOW_I32 sizeof(Tiny_MedianWindow_I32)
+#define SIZE_OF_TINY_MEDIAN_WINDOW_I64 sizeof(Tiny_MedianWindow_I64)
+
+#endif
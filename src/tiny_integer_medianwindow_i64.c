@@ -0,0 +1,14 @@
+/**
+ * @file tiny_integer_medianwindow_i64.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file compiles the integer median networks of tiny_integer_medianwindow.c for int64_t values.
+ *        Its public functions carry the suffix _i64 and operate on a Tiny_MedianWindow_I64.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define TINY_INTEGER_MEDIANWINDOW_INT64
+#include "tiny_integer_medianwindow.c"
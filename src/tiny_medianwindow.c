@@ -1,129 +1,131 @@
 /**
  * @file tiny_medianwindow.c
  * @author Jens Trappmann (jens.trappmann@icloud.com)
- * @brief This file implements median sorting networks for window sizes 2 to 8,
+ * @brief This file implements median sorting networks for window sizes 2 to 25,
  *        which are applied in sliding window operations where the window is small enough
  *        that sorting networks are more efficient than heap-based methods.
- * @version 0.2
- * @date 2025-12-30
+ *        For consecutive windows (steps = 1), the same networks run on AVX2/AVX-512 vectors, where every lane
+ *        holds another window, so 4 or 8 medians are obtained per network evaluation.
+ *        Every window size and NaN handling has its own generated loop, which is chosen once per input sequence.
+ *        The file is compiled as is for double values, and tiny_medianwindow_f32.c compiles it again with
+ *        TINY_MEDIANWINDOW_FLOAT defined for float values, whose vectors hold 8 or 16 windows.
+ *        The networks themselves are listed in median_networks.h, which tiny_integer_medianwindow.c shares.
+ * @version 0.5
+ * @date 2026-10-16
  *
  * @copyright Copyright (c) 2025
  *
  */
 
 #include "tiny_medianwindow.h"
-
-static void set_sort_and_calc_function(Tiny_MedianWindow *window, bool ignoreNaNWindows);
-static void sort_and_calc_median2(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median2_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median3(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median3_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median4(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median4_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median5(double *restrict inputArray, double *restrict result);
-static void sort_and_calc_median5_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median6(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median6_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median7(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median7_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median8(double *restrict inputStartPtr, double *restrict result);
-static void sort_and_calc_median8_nan_handle(double *restrict inputStartPtr, double *restrict result);
-static inline void values_swap(double *restrict a, double *restrict b);
-
-static inline void values_build_nan_free_array(double *restrict inputStartPtr, size_t length, size_t *nanCount,
-    double *output);
-static inline void values_build_nan_free_array_count_nan_inf(double *restrict inputStartPtr, size_t length,
-    size_t *nanCount, size_t *infCount, double *output);
-static inline void values_build_array_handle_nan(double *restrict inputStartPtr, size_t length, bool *nanInside,
-    double *output);
-
-static inline void median_network_2(double *restrict values);
-static inline void median_network_3(double *restrict values);
-static inline void median_network_4(double *restrict values);
-static inline void median_network_5(double *restrict values);
-static inline void median_network_6(double *restrict values);
-static inline void sorting_network_6(double *restrict values);
-static inline void median_network_7(double *restrict values);
-static inline void median_network_8(double *restrict values);
-static inline void sorting_network_8(double *restrict values);
-
-void tiny_medianwindow_initialize(char **memory, size_t windowSize,
-    size_t steps, bool ignoreNaNWindows, Tiny_MedianWindow **window) {
-    Tiny_MedianWindow *targetWindow = (Tiny_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+#include "median_networks.h"
+
+#ifdef TINY_MEDIANWINDOW_FLOAT
+#define TINY_VALUE float
+#define TINY_VALUE_MAX FLT_MAX
+#define TINY_WINDOW Tiny_MedianWindow_F32
+#define TINY_FUNCTION(name) name##_f32
+#else
+#define TINY_VALUE double
+#define TINY_VALUE_MAX DBL_MAX
+#define TINY_WINDOW Tiny_MedianWindow
+#define TINY_FUNCTION(name) name
+#endif
+
+// Written without a branch, so the compiler emits min/max instructions instead of unpredictable jumps
+#define SCALAR_COMPARATOR(a, b) { \
+    const TINY_VALUE firstValue = values[a]; \
+    const TINY_VALUE secondValue = values[b]; \
+    values[a] = (firstValue > secondValue) ? secondValue : firstValue; \
+    values[b] = (firstValue > secondValue) ? firstValue : secondValue; \
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TINY_MEDIANWINDOW_VECTOR_NETWORKS
+#ifdef TINY_MEDIANWINDOW_FLOAT
+#define AVX2_LANES 8
+#define AVX512_LANES 16
+#define AVX2_VECTOR __m256
+#define AVX512_VECTOR __m512
+#define AVX512_MASK __mmask16
+#define AVX2(name) _mm256_##name##_ps
+#define AVX512(name) _mm512_##name##_ps
+#define AVX512_CMP_MASK _mm512_cmp_ps_mask
+#else
+#define AVX2_LANES 4
+#define AVX512_LANES 8
+#define AVX2_VECTOR __m256d
+#define AVX512_VECTOR __m512d
+#define AVX512_MASK __mmask8
+#define AVX2(name) _mm256_##name##_pd
+#define AVX512(name) _mm512_##name##_pd
+#define AVX512_CMP_MASK _mm512_cmp_pd_mask
+#endif
+
+// Lane j of vectors[i] holds the value at position i of the window j. min(b, a) keeps a if both are equal,
+// so the vectors follow the scalar comparator exactly.
+#define AVX2_COMPARATOR(a, b) { \
+    const AVX2_VECTOR lowValues = AVX2(min)(vectors[b], vectors[a]); \
+    vectors[b] = AVX2(max)(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+
+#define AVX512_COMPARATOR(a, b) { \
+    const AVX512_VECTOR lowValues = AVX512(min)(vectors[b], vectors[a]); \
+    vectors[b] = AVX512(max)(vectors[a], vectors[b]); \
+    vectors[a] = lowValues; \
+}
+#endif
+
+typedef void (*tiny_medians_function)(TINY_VALUE *restrict, size_t, size_t, TINY_VALUE *restrict);
+
+static void set_medians_function(TINY_WINDOW *window, bool ignoreNaNWindows);
+static void sort_and_calc_median2(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median2_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median3(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median3_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median4(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median4_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median5(TINY_VALUE *restrict inputArray, TINY_VALUE *restrict result);
+static void sort_and_calc_median5_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median6(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median6_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median7(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median7_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median8(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static void sort_and_calc_median8_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result);
+static inline TINY_VALUE network_median(const TINY_VALUE *restrict values, size_t size);
+
+static inline void values_build_nan_free_array(TINY_VALUE *restrict inputStartPtr, size_t length, size_t *nanCount,
+    TINY_VALUE *output);
+static inline void values_build_nan_free_array_count_nan_inf(TINY_VALUE *restrict inputStartPtr, size_t length,
+    size_t *nanCount, size_t *infCount, TINY_VALUE *output);
+static inline void values_build_array_handle_nan(TINY_VALUE *restrict inputStartPtr, size_t length, bool *nanInside,
+    TINY_VALUE *output);
+
+static inline void median_network_2(TINY_VALUE *restrict values);
+static inline void median_network_3(TINY_VALUE *restrict values);
+static inline void median_network_4(TINY_VALUE *restrict values);
+static inline void median_network_5(TINY_VALUE *restrict values);
+static inline void median_network_6(TINY_VALUE *restrict values);
+static inline void sorting_network_6(TINY_VALUE *restrict values);
+static inline void median_network_7(TINY_VALUE *restrict values);
+static inline void median_network_8(TINY_VALUE *restrict values);
+static inline void sorting_network_8(TINY_VALUE *restrict values);
+
+void TINY_FUNCTION(tiny_medianwindow_initialize)(char **memory, size_t windowSize,
+    size_t steps, bool ignoreNaNWindows, TINY_WINDOW **window) {
+    TINY_WINDOW *targetWindow = (TINY_WINDOW* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
     targetWindow->windowSize = windowSize;
     targetWindow->steps = steps;
-    targetWindow->stepDistance = 0;
-    targetWindow->tailPtr = 0;
-    targetWindow->headPtr = 0;
-    set_sort_and_calc_function(targetWindow, ignoreNaNWindows);
+    set_medians_function(targetWindow, ignoreNaNWindows);
     *window = targetWindow;
 }
 
-void tiny_medianwindow_move_head(Tiny_MedianWindow *restrict window) {
-    window->headPtr += 1;
-}
-
-void tiny_medianwindow_move_tail(Tiny_MedianWindow *restrict window) {
-    window->tailPtr += 1;
-}
-
-void tiny_medianwindow_result(Tiny_MedianWindow *restrict window, double *restrict input, double *restrict output) {
-    window->sort_and_calc_median((input + window->tailPtr), output);
-}
-
-static void set_sort_and_calc_function(Tiny_MedianWindow *window, bool ignoreNaNWindows) {
-    const size_t windowSize = window->windowSize;
-    switch (windowSize) {
-        case 2: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median2_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median2;
-            break;
-        }
-        case 3: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median3_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median3;
-            break;
-        }
-        case 4: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median4_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median4;
-            break;
-        }
-        case 5: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median5_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median5;
-            break;
-        }
-        case 6: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median6_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median6;
-            break;
-        }
-        case 7: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median7_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median7;
-            break;
-        }
-        case 8: {
-            if(ignoreNaNWindows)
-                window->sort_and_calc_median = &sort_and_calc_median8_nan_handle;
-            else
-                window->sort_and_calc_median = &sort_and_calc_median8;
-            break;
-        }
-    }
+void TINY_FUNCTION(tiny_medianwindow_results)(TINY_WINDOW *restrict window, TINY_VALUE *restrict input, size_t length,
+    TINY_VALUE *restrict output) {
+    window->medians(input, length, window->steps, output);
 }
 
 #define WINDOW_SIZE_2 2
@@ -134,8 +136,8 @@ static void set_sort_and_calc_function(Tiny_MedianWindow *window, bool ignoreNaN
 #define WINDOW_SIZE_7 7
 #define WINDOW_SIZE_8 8
 
-static void sort_and_calc_median2(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_2];
+static void sort_and_calc_median2(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_2];
     values[0] = *(inputStartPtr++);
     values[1] = *(inputStartPtr++);
 
@@ -155,8 +157,8 @@ static void sort_and_calc_median2(double *restrict inputStartPtr, double *restri
     *result = (!nan0) ? values[0] : values[1];
 }
 
-static void sort_and_calc_median2_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_2];
+static void sort_and_calc_median2_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_2];
     values[0] = *(inputStartPtr++);
     values[1] = *(inputStartPtr++);
 
@@ -169,8 +171,8 @@ static void sort_and_calc_median2_nan_handle(double *restrict inputStartPtr, dou
     *result = ((values[0] + values[1]) / 2);
 }
 
-static void sort_and_calc_median3(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_3];
+static void sort_and_calc_median3(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_3];
     for(size_t i = 0; i < WINDOW_SIZE_3; i++)
         values[i] = *(inputStartPtr++);
 
@@ -194,8 +196,8 @@ static void sort_and_calc_median3(double *restrict inputStartPtr, double *restri
     *result = (!nan0) ? values[0] : (!nan1) ? values[1] : values[2];
 }
 
-static void sort_and_calc_median3_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_3];
+static void sort_and_calc_median3_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_3];
     for(size_t i = 0; i < WINDOW_SIZE_3; i++)
         values[i] = *(inputStartPtr++);
 
@@ -208,8 +210,8 @@ static void sort_and_calc_median3_nan_handle(double *restrict inputStartPtr, dou
     *result = values[1];
 }
 
-static void sort_and_calc_median4(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_4];
+static void sort_and_calc_median4(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_4];
     size_t nanCount = 0;
     values_build_nan_free_array(inputStartPtr, WINDOW_SIZE_4, &nanCount, values);
     if(nanCount == 0) {
@@ -235,8 +237,8 @@ static void sort_and_calc_median4(double *restrict inputStartPtr, double *restri
     *result = values[0];
 }
 
-static void sort_and_calc_median4_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_4];
+static void sort_and_calc_median4_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_4];
     for(size_t i = 0; i < WINDOW_SIZE_4; i++)
         values[i] = *(inputStartPtr++);
 
@@ -249,15 +251,15 @@ static void sort_and_calc_median4_nan_handle(double *restrict inputStartPtr, dou
     *result = ((values[1] + values[2]) / 2);
 }
 
-static void sort_and_calc_median5(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_5];
+static void sort_and_calc_median5(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_5];
     size_t nanCount = 0;
     size_t infCount = 0;
     values_build_nan_free_array_count_nan_inf(inputStartPtr, WINDOW_SIZE_5, &nanCount, &infCount, values);
     if((nanCount == 0) && (infCount == 0)) {
-        double validValues[WINDOW_SIZE_6];
-        memcpy(validValues, values, (WINDOW_SIZE_5 * sizeof(double)));
-        validValues[5] = DBL_MAX;
+        TINY_VALUE validValues[WINDOW_SIZE_6];
+        memcpy(validValues, values, (WINDOW_SIZE_5 * sizeof(TINY_VALUE)));
+        validValues[5] = TINY_VALUE_MAX;
         sorting_network_6(validValues);
         *result = validValues[2];
         return;
@@ -288,8 +290,8 @@ static void sort_and_calc_median5(double *restrict inputStartPtr, double *restri
     *result = values[0];
 }
 
-static void sort_and_calc_median5_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_5];
+static void sort_and_calc_median5_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_5];
     bool nanInside = false;
     values_build_array_handle_nan(inputStartPtr, WINDOW_SIZE_5, &nanInside, values);
 
@@ -302,8 +304,8 @@ static void sort_and_calc_median5_nan_handle(double *restrict inputStartPtr, dou
     *result = values[2];
 }
 
-static void sort_and_calc_median6(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_6];
+static void sort_and_calc_median6(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_6];
     size_t nanCount = 0;
     values_build_nan_free_array(inputStartPtr, WINDOW_SIZE_6, &nanCount, values);
     if(nanCount == 0) {
@@ -337,8 +339,8 @@ static void sort_and_calc_median6(double *restrict inputStartPtr, double *restri
     *result = values[0];
 }
 
-static void sort_and_calc_median6_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_6];
+static void sort_and_calc_median6_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_6];
     bool nanInside = false;
     values_build_array_handle_nan(inputStartPtr, WINDOW_SIZE_6, &nanInside, values);
 
@@ -351,15 +353,15 @@ static void sort_and_calc_median6_nan_handle(double *restrict inputStartPtr, dou
     *result = ((values[2] + values[3]) / 2);
 }
 
-static void sort_and_calc_median7(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_7];
+static void sort_and_calc_median7(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_7];
     size_t nanCount = 0;
     size_t infCount = 0;
     values_build_nan_free_array_count_nan_inf(inputStartPtr, WINDOW_SIZE_7, &nanCount, &infCount, values);
     if((nanCount == 0) && (infCount == 0)) {
-        double validValues[WINDOW_SIZE_8];
-        memcpy(validValues, values, (WINDOW_SIZE_7 * sizeof(double)));
-        validValues[WINDOW_SIZE_7] = DBL_MAX;
+        TINY_VALUE validValues[WINDOW_SIZE_8];
+        memcpy(validValues, values, (WINDOW_SIZE_7 * sizeof(TINY_VALUE)));
+        validValues[WINDOW_SIZE_7] = TINY_VALUE_MAX;
         sorting_network_8(validValues);
         *result = validValues[3];
         return;
@@ -398,8 +400,8 @@ static void sort_and_calc_median7(double *restrict inputStartPtr, double *restri
     *result = values[0];
 }
 
-static void sort_and_calc_median7_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_7];
+static void sort_and_calc_median7_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_7];
     bool nanInside = false;
     values_build_array_handle_nan(inputStartPtr, WINDOW_SIZE_7, &nanInside, values);
 
@@ -412,8 +414,8 @@ static void sort_and_calc_median7_nan_handle(double *restrict inputStartPtr, dou
     *result = values[3];
 }
 
-static void sort_and_calc_median8(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_8];
+static void sort_and_calc_median8(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_8];
     size_t nanCount = 0;
     values_build_nan_free_array(inputStartPtr, WINDOW_SIZE_8, &nanCount, values);
     if(nanCount == 0) {
@@ -455,8 +457,8 @@ static void sort_and_calc_median8(double *restrict inputStartPtr, double *restri
     *result = values[0];
 }
 
-static void sort_and_calc_median8_nan_handle(double *restrict inputStartPtr, double *restrict result) {
-    double values[WINDOW_SIZE_8];
+static void sort_and_calc_median8_nan_handle(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) {
+    TINY_VALUE values[WINDOW_SIZE_8];
     bool nanInside = false;
     values_build_array_handle_nan(inputStartPtr, WINDOW_SIZE_8, &nanInside, values);
 
@@ -469,17 +471,188 @@ static void sort_and_calc_median8_nan_handle(double *restrict inputStartPtr, dou
     *result = ((values[3] + values[4]) / 2);
 }
 
-static inline void values_swap(double *restrict a, double *restrict b) {
-    const double tempValue = *b;
-    *b = *a;
-    *a = tempValue;
-}
-
-static inline void values_build_nan_free_array(double *restrict inputStartPtr, size_t length, size_t *nanCount,
-    double *output) {
+// From window size 9 on, a window with NaN values is not sorted by a smaller network for every possible number of
+// valid values. Instead, the NaN values are replaced by the same number of -INFINITY and +INFINITY values, which
+// keeps the median in the middle. For an odd NaN count, one of them is dropped and the next smaller network is used.
+#define NETWORK_SORT_AND_CALC_MEDIAN(windowSize, smallerWindowSize) \
+static inline void median_network_##windowSize(TINY_VALUE *restrict values) { \
+    MEDIAN_NETWORK_##windowSize(SCALAR_COMPARATOR) \
+} \
+\
+static void sort_and_calc_median##windowSize(TINY_VALUE *restrict inputStartPtr, TINY_VALUE *restrict result) { \
+    TINY_VALUE values[windowSize]; \
+    size_t nanCount = 0; \
+    values_build_nan_free_array(inputStartPtr, windowSize, &nanCount, values); \
+    if(nanCount == windowSize) { \
+        *result = NAN; \
+        return; \
+    } \
+    const size_t validNum = (windowSize - nanCount); \
+    const size_t paddingNum = (nanCount / 2); \
+    for(size_t i = 0; i < paddingNum; i++) { \
+        values[validNum + i] = -INFINITY; \
+        values[validNum + paddingNum + i] = INFINITY; \
+    } \
+    if((nanCount % 2) == 0) { \
+        median_network_##windowSize(values); \
+        *result = network_median(values, windowSize); \
+        return; \
+    } \
+    median_network_##smallerWindowSize(values); \
+    *result = network_median(values, smallerWindowSize); \
+} \
+\
+static void sort_and_calc_median##windowSize##_nan_handle(TINY_VALUE *restrict inputStartPtr, \
+    TINY_VALUE *restrict result) { \
+    TINY_VALUE values[windowSize]; \
+    bool nanInside = false; \
+    values_build_array_handle_nan(inputStartPtr, windowSize, &nanInside, values); \
+    if(nanInside) { \
+        *result = NAN; \
+        return; \
+    } \
+    median_network_##windowSize(values); \
+    *result = network_median(values, windowSize); \
+}
+
+NETWORK_SORT_AND_CALC_MEDIAN(9, 8)
+NETWORK_SORT_AND_CALC_MEDIAN(10, 9)
+NETWORK_SORT_AND_CALC_MEDIAN(11, 10)
+NETWORK_SORT_AND_CALC_MEDIAN(12, 11)
+NETWORK_SORT_AND_CALC_MEDIAN(13, 12)
+NETWORK_SORT_AND_CALC_MEDIAN(14, 13)
+NETWORK_SORT_AND_CALC_MEDIAN(15, 14)
+NETWORK_SORT_AND_CALC_MEDIAN(16, 15)
+NETWORK_SORT_AND_CALC_MEDIAN(17, 16)
+NETWORK_SORT_AND_CALC_MEDIAN(18, 17)
+NETWORK_SORT_AND_CALC_MEDIAN(19, 18)
+NETWORK_SORT_AND_CALC_MEDIAN(20, 19)
+NETWORK_SORT_AND_CALC_MEDIAN(21, 20)
+NETWORK_SORT_AND_CALC_MEDIAN(22, 21)
+NETWORK_SORT_AND_CALC_MEDIAN(23, 22)
+NETWORK_SORT_AND_CALC_MEDIAN(24, 23)
+NETWORK_SORT_AND_CALC_MEDIAN(25, 24)
+
+static inline TINY_VALUE network_median(const TINY_VALUE *restrict values, size_t size) {
+    if((size % 2) != 0)
+        return values[size / 2];
+
+    return ((values[(size / 2) - 1] + values[size / 2]) / 2);
+}
+
+// Every (windowSize, ignoreNaNWindows) pair gets its own loop, so the network is inlined into it and the
+// function is only chosen once per input sequence.
+#define TINY_MEDIANS(windowSize, SUFFIX) \
+static void tiny_medians##windowSize##SUFFIX(TINY_VALUE *restrict input, size_t length, size_t steps, \
+    TINY_VALUE *restrict output) { \
+    for(size_t start = 0; (start + windowSize) <= length; start += steps) \
+        sort_and_calc_median##windowSize##SUFFIX(&input[start], output++); \
+}
+
+TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS, )
+TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS, _nan_handle)
+
+static const tiny_medians_function tinyMedians[2][TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, tiny_medians, ) },
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, tiny_medians, _nan_handle) }
+};
+
+#ifdef TINY_MEDIANWINDOW_VECTOR_NETWORKS
+// Consecutive windows (steps = 1) run the network on vectors, where lane j holds the window start + j.
+// Vectors containing NaN values and the last windows that do not fill all lanes fall back to the scalar network.
+#define VECTOR_NETWORK_MEDIANS(windowSize, ...) \
+static inline __attribute__((always_inline, target("avx2"))) bool network_medians##windowSize##_avx2( \
+    const TINY_VALUE *restrict input, TINY_VALUE *restrict output) { \
+    AVX2_VECTOR vectors[windowSize]; \
+    AVX2_VECTOR nanMask = AVX2(setzero)(); \
+    for(size_t i = 0; i < windowSize; i++) { \
+        vectors[i] = AVX2(loadu)(&input[i]); \
+        nanMask = AVX2(or)(nanMask, AVX2(cmp)(vectors[i], vectors[i], _CMP_UNORD_Q)); \
+    } \
+    if(AVX2(movemask)(nanMask) != 0) \
+        return false; \
+    MEDIAN_NETWORK_##windowSize(AVX2_COMPARATOR) \
+    if((windowSize % 2) != 0) \
+        AVX2(storeu)(output, vectors[windowSize / 2]); \
+    else \
+        AVX2(storeu)(output, AVX2(mul)(AVX2(add)(vectors[(windowSize / 2) - 1], \
+            vectors[windowSize / 2]), AVX2(set1)(0.5))); \
+    return true; \
+} \
+\
+static inline __attribute__((always_inline, target("avx512f"))) bool network_medians##windowSize##_avx512( \
+    const TINY_VALUE *restrict input, TINY_VALUE *restrict output) { \
+    AVX512_VECTOR vectors[windowSize]; \
+    AVX512_MASK nanMask = 0; \
+    for(size_t i = 0; i < windowSize; i++) { \
+        vectors[i] = AVX512(loadu)(&input[i]); \
+        nanMask |= AVX512_CMP_MASK(vectors[i], vectors[i], _CMP_UNORD_Q); \
+    } \
+    if(nanMask != 0) \
+        return false; \
+    MEDIAN_NETWORK_##windowSize(AVX512_COMPARATOR) \
+    if((windowSize % 2) != 0) \
+        AVX512(storeu)(output, vectors[windowSize / 2]); \
+    else \
+        AVX512(storeu)(output, AVX512(mul)(AVX512(add)(vectors[(windowSize / 2) - 1], \
+            vectors[windowSize / 2]), AVX512(set1)(0.5))); \
+    return true; \
+}
+
+#define CONSECUTIVE_TINY_MEDIANS(windowSize, SUFFIX, ISA, TARGET, LANES) \
+__attribute__((target(TARGET))) \
+static void consecutive_tiny_medians##windowSize##SUFFIX##_##ISA(TINY_VALUE *restrict input, size_t length, \
+    size_t steps, TINY_VALUE *restrict output) { \
+    (void) steps; \
+    const size_t numMedians = ((length - windowSize) + 1); \
+    size_t i = 0; \
+    for(; (i + LANES) <= numMedians; i += LANES) { \
+        if(network_medians##windowSize##_##ISA(&input[i], &output[i])) \
+            continue; \
+        for(size_t j = i; j < (i + LANES); j++) \
+            sort_and_calc_median##windowSize##SUFFIX(&input[j], &output[j]); \
+    } \
+    for(; i < numMedians; i++) \
+        sort_and_calc_median##windowSize##SUFFIX(&input[i], &output[i]); \
+}
+
+TINY_MEDIANS_ALL_SIZES(VECTOR_NETWORK_MEDIANS, )
+
+TINY_MEDIANS_ALL_SIZES(CONSECUTIVE_TINY_MEDIANS, , avx2, "avx2", AVX2_LANES)
+TINY_MEDIANS_ALL_SIZES(CONSECUTIVE_TINY_MEDIANS, _nan_handle, avx2, "avx2", AVX2_LANES)
+TINY_MEDIANS_ALL_SIZES(CONSECUTIVE_TINY_MEDIANS, , avx512, "avx512f", AVX512_LANES)
+TINY_MEDIANS_ALL_SIZES(CONSECUTIVE_TINY_MEDIANS, _nan_handle, avx512, "avx512f", AVX512_LANES)
+
+static const tiny_medians_function consecutiveTinyMediansAvx2[2][TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians, _avx2) },
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians, _nan_handle_avx2) }
+};
+
+static const tiny_medians_function consecutiveTinyMediansAvx512[2][TINY_MEDIANWINDOW_THRESHOLD + 1] = {
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians, _avx512) },
+    { TINY_MEDIANS_ALL_SIZES(TINY_MEDIANS_TABLE_ENTRY, consecutive_tiny_medians, _nan_handle_avx512) }
+};
+#endif
+
+static void set_medians_function(TINY_WINDOW *window, bool ignoreNaNWindows) {
+    window->medians = tinyMedians[ignoreNaNWindows][window->windowSize];
+
+#ifdef TINY_MEDIANWINDOW_VECTOR_NETWORKS
+    if(window->steps != 1)
+        return;
+
+    if(__builtin_cpu_supports("avx512f"))
+        window->medians = consecutiveTinyMediansAvx512[ignoreNaNWindows][window->windowSize];
+    else if(__builtin_cpu_supports("avx2"))
+        window->medians = consecutiveTinyMediansAvx2[ignoreNaNWindows][window->windowSize];
+#endif
+}
+
+static inline void values_build_nan_free_array(TINY_VALUE *restrict inputStartPtr, size_t length, size_t *nanCount,
+    TINY_VALUE *output) {
     size_t outputPosition = 0;
     for(size_t i = 0; i < length; i++) {
-        const double v = *(inputStartPtr++);
+        const TINY_VALUE v = *(inputStartPtr++);
         const bool isNaN = isnan(v);
         output[outputPosition] = v;
         outputPosition += (!isNaN);
@@ -487,11 +660,11 @@ static inline void values_build_nan_free_array(double *restrict inputStartPtr, s
     }
 }
 
-static inline void values_build_nan_free_array_count_nan_inf(double *restrict inputStartPtr, size_t length,
-    size_t *nanCount, size_t *infCount, double *output) {
+static inline void values_build_nan_free_array_count_nan_inf(TINY_VALUE *restrict inputStartPtr, size_t length,
+    size_t *nanCount, size_t *infCount, TINY_VALUE *output) {
     size_t outputPosition = 0;
     for(size_t i = 0; i < length; i++) {
-        const double v = *(inputStartPtr++);
+        const TINY_VALUE v = *(inputStartPtr++);
         const bool isNaN = isnan(v);
         output[outputPosition] = v;
         outputPosition += (!isNaN);
@@ -500,124 +673,48 @@ static inline void values_build_nan_free_array_count_nan_inf(double *restrict in
     }
 }
 
-static inline void values_build_array_handle_nan(double *restrict inputStartPtr, size_t length, bool *nanInside,
-    double *output) {
+static inline void values_build_array_handle_nan(TINY_VALUE *restrict inputStartPtr, size_t length, bool *nanInside,
+    TINY_VALUE *output) {
     for(size_t i = 0; i < length; i++) {
-        const double v = *(inputStartPtr++);
+        const TINY_VALUE v = *(inputStartPtr++);
         const bool isNaN = isnan(v);
         *nanInside |= isNaN;
         output[i] = v;
     }
 }
 
-static inline void median_network_2(double *restrict values) {
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-}
-
-static inline void median_network_3(double *restrict values) {
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-}
-
-static inline void median_network_4(double *restrict values) {
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-}
-
-static inline void median_network_5(double *restrict values) {
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-}
-
-static inline void median_network_6(double *restrict values) {
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[4] > values[5]) values_swap(&values[4], &values[5]);
-    if(values[0] > values[5]) values_swap(&values[0], &values[5]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[4]) values_swap(&values[1], &values[4]);
-    if(values[3] > values[5]) values_swap(&values[3], &values[5]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[3] > values[4]) values_swap(&values[3], &values[4]);
-}
-
-static inline void sorting_network_6(double *restrict values) {
-    if(values[0] > values[3]) values_swap(&values[0], &values[3]);
-    if(values[1] > values[4]) values_swap(&values[1], &values[4]);
-    if(values[2] > values[5]) values_swap(&values[2], &values[5]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[3] > values[5]) values_swap(&values[3], &values[5]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-    if(values[4] > values[5]) values_swap(&values[4], &values[5]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[3] > values[4]) values_swap(&values[3], &values[4]);
-}
-
-static inline void median_network_7(double *restrict values) {
-    if(values[0] > values[6]) values_swap(&values[0], &values[6]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[3] > values[4]) values_swap(&values[3], &values[4]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[4]) values_swap(&values[1], &values[4]);
-    if(values[3] > values[5]) values_swap(&values[3], &values[5]);
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[5]) values_swap(&values[2], &values[5]);
-    if(values[4] > values[6]) values_swap(&values[4], &values[6]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[3] > values[4]) values_swap(&values[3], &values[4]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-}
-
-static inline void median_network_8(double *restrict values) {
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[4] > values[6]) values_swap(&values[4], &values[6]);
-    if(values[5] > values[7]) values_swap(&values[5], &values[7]);
-    if(values[0] > values[4]) values_swap(&values[0], &values[4]);
-    if(values[1] > values[5]) values_swap(&values[1], &values[5]);
-    if(values[2] > values[6]) values_swap(&values[2], &values[6]);
-    if(values[3] > values[7]) values_swap(&values[3], &values[7]);
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[3] > values[5]) values_swap(&values[3], &values[5]);
-    if(values[6] > values[7]) values_swap(&values[6], &values[7]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-    if(values[4] > values[5]) values_swap(&values[4], &values[5]);
-    if(values[1] > values[4]) values_swap(&values[1], &values[4]);
-    if(values[3] > values[6]) values_swap(&values[3], &values[6]);
-}
-
-static inline void sorting_network_8(double *restrict values) {
-    if(values[0] > values[5]) values_swap(&values[0], &values[5]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[2] > values[7]) values_swap(&values[2], &values[7]);
-    if(values[4] > values[6]) values_swap(&values[4], &values[6]);
-    if(values[0] > values[2]) values_swap(&values[0], &values[2]);
-    if(values[1] > values[4]) values_swap(&values[1], &values[4]);
-    if(values[3] > values[6]) values_swap(&values[3], &values[6]);
-    if(values[5] > values[7]) values_swap(&values[5], &values[7]);
-    if(values[0] > values[1]) values_swap(&values[0], &values[1]);
-    if(values[2] > values[4]) values_swap(&values[2], &values[4]);
-    if(values[3] > values[5]) values_swap(&values[3], &values[5]);
-    if(values[6] > values[7]) values_swap(&values[6], &values[7]);
-    if(values[1] > values[3]) values_swap(&values[1], &values[3]);
-    if(values[4] > values[6]) values_swap(&values[4], &values[6]);
-    if(values[2] > values[3]) values_swap(&values[2], &values[3]);
-    if(values[4] > values[5]) values_swap(&values[4], &values[5]);
-    if(values[1] > values[2]) values_swap(&values[1], &values[2]);
-    if(values[3] > values[4]) values_swap(&values[3], &values[4]);
-    if(values[5] > values[6]) values_swap(&values[5], &values[6]);
+static inline void median_network_2(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_2(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_3(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_3(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_4(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_4(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_5(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_5(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_6(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_6(SCALAR_COMPARATOR)
+}
+
+static inline void sorting_network_6(TINY_VALUE *restrict values) {
+    SORTING_NETWORK_6(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_7(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_7(SCALAR_COMPARATOR)
+}
+
+static inline void median_network_8(TINY_VALUE *restrict values) {
+    MEDIAN_NETWORK_8(SCALAR_COMPARATOR)
+}
+
+static inline void sorting_network_8(TINY_VALUE *restrict values) {
+    SORTING_NETWORK_8(SCALAR_COMPARATOR)
 }
@@ -10,22 +10,35 @@
 
 #define STD_ALIGNMENT 8
 
+// The largest window size supported by the median networks
+#define TINY_MEDIANWINDOW_THRESHOLD 25
+
 typedef struct Tiny_MedianWindow
 {
     size_t windowSize;
     size_t steps;
-    size_t stepDistance;
-    size_t tailPtr;
-    size_t headPtr;
-    void (*sort_and_calc_median) (double *restrict, double *restrict);
+    void (*medians) (double *restrict, size_t, size_t, double *restrict);
 } Tiny_MedianWindow;
 
+// The same networks over float values, implemented by tiny_medianwindow_f32.c
+typedef struct Tiny_MedianWindow_F32
+{
+    size_t windowSize;
+    size_t steps;
+    void (*medians) (float *restrict, size_t, size_t, float *restrict);
+} Tiny_MedianWindow_F32;
+
 void tiny_medianwindow_initialize(char **memory, size_t windowSize, size_t steps,
     bool ignoreNaNWindows, Tiny_MedianWindow **window);
-void tiny_medianwindow_move_head(Tiny_MedianWindow *restrict window);
-void tiny_medianwindow_move_tail(Tiny_MedianWindow *restrict window);
-void tiny_medianwindow_result(Tiny_MedianWindow *restrict window, double *restrict input, double *restrict output);
+void tiny_medianwindow_results(Tiny_MedianWindow *restrict window, double *restrict input, size_t length,
+    double *restrict output);
+
+void tiny_medianwindow_initialize_f32(char **memory, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows, Tiny_MedianWindow_F32 **window);
+void tiny_medianwindow_results_f32(Tiny_MedianWindow_F32 *restrict window, float *restrict input, size_t length,
+    float *restrict output);
 
 #define SIZE_OF_TINY_MEDIAN_WINDOW sizeof(Tiny_MedianWindow)
+#define SIZE_OF_TINY_MEDIAN_WINDOW_F32 sizeof(Tiny_MedianWindow_F32)
 
 #endif
@@ -0,0 +1,14 @@
+/**
+ * @file tiny_medianwindow_f32.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file compiles the median sorting networks of tiny_medianwindow.c for float values.
+ *        Its public functions carry the suffix _f32 and operate on a Tiny_MedianWindow_F32.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define TINY_MEDIANWINDOW_FLOAT
+#include "tiny_medianwindow.c"
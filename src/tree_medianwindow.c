@@ -0,0 +1,500 @@
+/**
+ * @file tree_medianwindow.c
+ * @author Jens Trappmann (jens.trappmann@icloud.com)
+ * @brief This file implements a median window for very large windows based on an order-statistic B+-tree.
+ *        The leaves hold sorted runs of up to 16 values (2 cache lines), the inner nodes hold the minimum and the
+ *        number of values of each of their (up to 16) subtrees. Inserting or removing a value touches one path of
+ *        nodes, the median is found by descending along the subtree sizes. Unused slots are NaN, so all searches
+ *        and shifts inside a node process every slot without data dependent branches.
+ *        Compared to the double heap, whose sift operations jump across the whole window, the upper levels of
+ *        the tree stay in the cache and input values that are close to each other share leaves.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "tree_medianwindow.h"
+
+#define TREE_LEAF_HALF (TREE_LEAF_CAPACITY / 2)
+#define TREE_INNER_HALF (TREE_INNER_CAPACITY / 2)
+// A node underflows below a quarter of its capacity and two siblings are only merged if the merged node has room
+// for another quarter. Otherwise a node split into halves would be merged again by the next removal.
+#define TREE_LEAF_MIN (TREE_LEAF_CAPACITY / 4)
+#define TREE_LEAF_MERGE_MAX (TREE_LEAF_CAPACITY - TREE_LEAF_MIN)
+#define TREE_INNER_MIN (TREE_INNER_CAPACITY / 4)
+#define TREE_INNER_MERGE_MAX (TREE_INNER_CAPACITY - TREE_INNER_MIN)
+
+static inline size_t tree_max_leaves(size_t windowSize);
+static inline size_t tree_max_inners(size_t windowSize);
+static inline uint32_t tree_descend(Tree_MedianWindow *window, double value);
+static inline size_t tree_leaf_length(const Tree_MedianWindow *window);
+static void tree_insert(Tree_MedianWindow *window, double value);
+static void tree_remove(Tree_MedianWindow *window, double value);
+static double tree_select(const Tree_MedianWindow *window, size_t rank);
+static void tree_select_many(const Tree_MedianWindow *restrict window, uint32_t node, size_t level,
+    const size_t *restrict ranks, size_t count, size_t offset, double *restrict values);
+static void tree_split(Tree_MedianWindow *window, size_t level);
+static void tree_grow_root(Tree_MedianWindow *window);
+static void tree_split_leaf(Tree_MedianWindow *window);
+static void tree_split_inner(Tree_MedianWindow *window, size_t level);
+static void tree_rebalance_leaf(Tree_MedianWindow *window);
+static void tree_rebalance_inner(Tree_MedianWindow *window, size_t level);
+
+static inline void tree_update_path(Tree_MedianWindow *window, double minimum, int32_t sizeChange);
+
+static inline void leaf_insert(TreeLeaf *leaf, double value);
+static inline void leaf_remove(TreeLeaf *leaf, double value);
+static inline uint32_t leaf_allocate(Tree_MedianWindow *window);
+static inline uint32_t inner_child_index(const TreeInner *inner, double value);
+static inline uint32_t inner_allocate(Tree_MedianWindow *window);
+static inline uint32_t inner_entries_move(TreeInner *target, size_t targetPosition, TreeInner *source,
+    size_t sourcePosition, size_t count);
+static inline void inner_entries_clear(TreeInner *inner, size_t from, size_t to);
+static inline void inner_entry_insert(TreeInner *inner, size_t position, double key, uint32_t size, uint32_t child);
+static inline void inner_entry_remove(TreeInner *inner, size_t position);
+
+void tree_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Tree_MedianWindow **window) {
+    Tree_MedianWindow *targetWindow = (Tree_MedianWindow* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += SIZE_OF_TREE_MEDIAN_WINDOW;
+
+    // The nodes start at a cache line, tree_medianwindow_est_mem reserves the bytes to get there
+    const size_t maxLeaves = tree_max_leaves(windowSize);
+    const size_t maxInners = tree_max_inners(windowSize);
+    const size_t misalignment = ((uintptr_t) *memory % TREE_CACHE_LINE);
+    *memory += (misalignment == 0) ? 0 : (TREE_CACHE_LINE - misalignment);
+    targetWindow->leaves = (TreeLeaf* ) __builtin_assume_aligned(*memory, TREE_CACHE_LINE);
+    *memory += (maxLeaves * sizeof(TreeLeaf));
+    targetWindow->inners = (TreeInner* ) __builtin_assume_aligned(*memory, STD_ALIGNMENT);
+    *memory += (maxInners * sizeof(TreeInner));
+    targetWindow->freeLeaves = (uint32_t* ) *memory;
+    *memory += (maxLeaves * sizeof(uint32_t));
+    targetWindow->freeInners = (uint32_t* ) *memory;
+    *memory += (maxInners * sizeof(uint32_t));
+
+    // Both pools hand out their nodes in ascending order
+    for(size_t i = 0; i < maxLeaves; i++)
+        targetWindow->freeLeaves[i] = (uint32_t) (maxLeaves - 1 - i);
+    for(size_t i = 0; i < maxInners; i++)
+        targetWindow->freeInners[i] = (uint32_t) (maxInners - 1 - i);
+    targetWindow->freeLeavesLength = (uint32_t) maxLeaves;
+    targetWindow->freeInnersLength = (uint32_t) maxInners;
+
+    targetWindow->windowSize = windowSize;
+    targetWindow->validCount = 0;
+    targetWindow->nanCount = 0;
+    targetWindow->ignoreNaNWindows = ignoreNaNWindows;
+    targetWindow->height = 0;
+    targetWindow->root = leaf_allocate(targetWindow);
+    *window = targetWindow;
+}
+
+void tree_medianwindow_add(Tree_MedianWindow *window, double value) {
+    if(isnan(value)) {
+        window->nanCount++;
+        return;
+    }
+
+    tree_insert(window, value);
+}
+
+void tree_medianwindow_replace(Tree_MedianWindow *window, double oldValue, double newValue) {
+    // Removing first keeps the number of values, and with it the number of nodes, within the window size
+    if(isnan(oldValue))
+        window->nanCount--;
+    else
+        tree_remove(window, oldValue);
+
+    tree_medianwindow_add(window, newValue);
+}
+
+void tree_medianwindow_result(Tree_MedianWindow *restrict window, double *restrict output) {
+    const size_t validCount = window->validCount;
+    if((validCount == 0) || ((window->ignoreNaNWindows) && (window->nanCount > 0))) {
+        *output = NAN;
+        return;
+    }
+
+    const size_t middle = (validCount / 2);
+    if((validCount % 2) != 0) {
+        *output = tree_select(window, middle);
+        return;
+    }
+
+    *output = (tree_select(window, middle - 1) + tree_select(window, middle)) / 2;
+}
+
+void tree_medianwindow_select(const Tree_MedianWindow *restrict window, const size_t *restrict ranks, size_t count,
+    double *restrict values) {
+    tree_select_many(window, window->root, window->height, ranks, count, 0, values);
+}
+
+size_t tree_medianwindow_est_mem(size_t windowSize) {
+    return (SIZE_OF_TREE_MEDIAN_WINDOW + (TREE_CACHE_LINE - 1)
+        + (tree_max_leaves(windowSize) * (sizeof(TreeLeaf) + sizeof(uint32_t)))
+        + (tree_max_inners(windowSize) * (sizeof(TreeInner) + sizeof(uint32_t))));
+}
+
+static inline size_t tree_max_leaves(size_t windowSize) {
+    // Every leaf except a root leaf holds at least TREE_LEAF_MIN values, a split needs one more leaf for a moment
+    return ((windowSize / TREE_LEAF_MIN) + 2);
+}
+
+static inline size_t tree_max_inners(size_t windowSize) {
+    // Every level has at most 1 / TREE_INNER_MIN of the nodes of the level below, plus one root per level
+    return ((tree_max_leaves(windowSize) / (TREE_INNER_MIN - 1)) + TREE_MAX_HEIGHT + 1);
+}
+
+static inline uint32_t tree_descend(Tree_MedianWindow *window, double value) {
+    uint32_t node = window->root;
+    for(size_t level = window->height; level > 0; level--) {
+        const TreeInner *inner = &window->inners[node];
+        const uint32_t child = inner_child_index(inner, value);
+        window->pathNodes[level] = node;
+        window->pathChildren[level] = child;
+        node = inner->children[child];
+    }
+
+    return node;
+}
+
+static inline size_t tree_leaf_length(const Tree_MedianWindow *window) {
+    // Only valid directly after tree_descend
+    if(window->height == 0)
+        return window->validCount;
+
+    return window->inners[window->pathNodes[1]].sizes[window->pathChildren[1]];
+}
+
+static void tree_insert(Tree_MedianWindow *window, double value) {
+    uint32_t leafIndex = tree_descend(window, value);
+    size_t length = tree_leaf_length(window);
+
+    // A split changes the path, so the tree is descended again until the leaf has room
+    while (length == TREE_LEAF_CAPACITY) {
+        tree_split(window, 0);
+        leafIndex = tree_descend(window, value);
+        length = tree_leaf_length(window);
+    }
+
+    TreeLeaf *leaf = &window->leaves[leafIndex];
+    leaf_insert(leaf, value);
+    tree_update_path(window, leaf->values[0], 1);
+    window->validCount++;
+}
+
+static void tree_remove(Tree_MedianWindow *window, double value) {
+    // The keys are the exact minima of the subtrees, so the descent always reaches a leaf that holds the value
+    const uint32_t leafIndex = tree_descend(window, value);
+    const size_t length = tree_leaf_length(window);
+
+    TreeLeaf *leaf = &window->leaves[leafIndex];
+    leaf_remove(leaf, value);
+    tree_update_path(window, leaf->values[0], -1);
+    window->validCount--;
+    if((window->height > 0) && ((length - 1) < TREE_LEAF_MIN))
+        tree_rebalance_leaf(window);
+}
+
+static inline void tree_update_path(Tree_MedianWindow *window, double minimum, int32_t sizeChange) {
+    // Updates the sizes and the minima along the current path, the minimum of a subtree is the one of its first
+    // child. Overwriting every key on the path is cheaper than finding out which ones changed.
+    for(size_t level = 1; level <= window->height; level++) {
+        TreeInner *inner = &window->inners[window->pathNodes[level]];
+        const uint32_t child = window->pathChildren[level];
+        inner->sizes[child] += (uint32_t) sizeChange;
+        inner->keys[child] = minimum;
+        minimum = inner->keys[0];
+    }
+}
+
+static double tree_select(const Tree_MedianWindow *window, size_t rank) {
+    uint32_t node = window->root;
+    for(size_t level = window->height; level > 0; level--) {
+        const TreeInner *inner = &window->inners[node];
+        size_t child = 0;
+        while (rank >= inner->sizes[child]) {
+            rank -= inner->sizes[child];
+            child++;
+        }
+        node = inner->children[child];
+    }
+
+    return window->leaves[node].values[rank];
+}
+
+static void tree_select_many(const Tree_MedianWindow *restrict window, uint32_t node, size_t level,
+    const size_t *restrict ranks, size_t count, size_t offset, double *restrict values) {
+    // The ranks are ascending, so every child is entered once with all ranks inside it and the children are
+    // scanned once for all ranks. offset is the number of values left of the node.
+    if(level == 0) {
+        const TreeLeaf *leaf = &window->leaves[node];
+        for(size_t i = 0; i < count; i++)
+            values[i] = leaf->values[ranks[i] - offset];
+        return;
+    }
+
+    const TreeInner *inner = &window->inners[node];
+    size_t child = 0;
+    size_t i = 0;
+    while (i < count) {
+        while (ranks[i] >= (offset + inner->sizes[child])) {
+            offset += inner->sizes[child];
+            child++;
+        }
+
+        const size_t childEnd = (offset + inner->sizes[child]);
+        size_t j = (i + 1);
+        while ((j < count) && (ranks[j] < childEnd))
+            j++;
+
+        tree_select_many(window, inner->children[child], (level - 1), &ranks[i], (j - i), offset, &values[i]);
+        i = j;
+    }
+}
+
+static void tree_split(Tree_MedianWindow *window, size_t level) {
+    // Splits the full node at the given level of the current path, or first makes room in its parent
+    if(level == window->height) {
+        tree_grow_root(window);
+        return;
+    }
+
+    if(window->inners[window->pathNodes[level + 1]].count == TREE_INNER_CAPACITY) {
+        tree_split(window, level + 1);
+        return;
+    }
+
+    if(level == 0)
+        tree_split_leaf(window);
+    else
+        tree_split_inner(window, level);
+}
+
+static void tree_grow_root(Tree_MedianWindow *window) {
+    const uint32_t rootIndex = inner_allocate(window);
+    TreeInner *root = &window->inners[rootIndex];
+    root->keys[0] = (window->height == 0)
+        ? window->leaves[window->root].values[0] : window->inners[window->root].keys[0];
+    root->sizes[0] = (uint32_t) window->validCount;
+    root->children[0] = window->root;
+    root->count = 1;
+
+    window->root = rootIndex;
+    window->height++;
+}
+
+static void tree_split_leaf(Tree_MedianWindow *window) {
+    const uint32_t rightIndex = leaf_allocate(window);
+    TreeInner *parent = &window->inners[window->pathNodes[1]];
+    const uint32_t child = window->pathChildren[1];
+    TreeLeaf *left = &window->leaves[parent->children[child]];
+    TreeLeaf *right = &window->leaves[rightIndex];
+
+    memcpy(right->values, &left->values[TREE_LEAF_HALF], (TREE_LEAF_HALF * sizeof(double)));
+    for(size_t i = TREE_LEAF_HALF; i < TREE_LEAF_CAPACITY; i++)
+        left->values[i] = NAN;
+
+    parent->sizes[child] = TREE_LEAF_HALF;
+    inner_entry_insert(parent, (child + 1), right->values[0], TREE_LEAF_HALF, rightIndex);
+}
+
+static void tree_split_inner(Tree_MedianWindow *window, size_t level) {
+    const uint32_t rightIndex = inner_allocate(window);
+    TreeInner *parent = &window->inners[window->pathNodes[level + 1]];
+    const uint32_t child = window->pathChildren[level + 1];
+    TreeInner *left = &window->inners[window->pathNodes[level]];
+    TreeInner *right = &window->inners[rightIndex];
+
+    const uint32_t rightSize = inner_entries_move(right, 0, left, TREE_INNER_HALF, TREE_INNER_HALF);
+    inner_entries_clear(left, TREE_INNER_HALF, TREE_INNER_CAPACITY);
+    left->count = TREE_INNER_HALF;
+    right->count = TREE_INNER_HALF;
+
+    parent->sizes[child] -= rightSize;
+    inner_entry_insert(parent, (child + 1), right->keys[0], rightSize, rightIndex);
+}
+
+static void tree_rebalance_leaf(Tree_MedianWindow *window) {
+    // The leaf is merged with a sibling or takes values from it, the left leaf keeps its minimum in both cases
+    TreeInner *parent = &window->inners[window->pathNodes[1]];
+    const uint32_t child = window->pathChildren[1];
+    const uint32_t leftChild = (child > 0) ? (child - 1) : child;
+    const uint32_t rightChild = (leftChild + 1);
+    TreeLeaf *left = &window->leaves[parent->children[leftChild]];
+    TreeLeaf *right = &window->leaves[parent->children[rightChild]];
+    const size_t leftLength = parent->sizes[leftChild];
+    const size_t rightLength = parent->sizes[rightChild];
+
+    if((leftLength + rightLength) <= TREE_LEAF_MERGE_MAX) {
+        memcpy(&left->values[leftLength], right->values, (rightLength * sizeof(double)));
+        parent->sizes[leftChild] += (uint32_t) rightLength;
+        window->freeLeaves[window->freeLeavesLength++] = parent->children[rightChild];
+        inner_entry_remove(parent, rightChild);
+        tree_rebalance_inner(window, 1);
+        return;
+    }
+
+    const size_t newLeftLength = ((leftLength + rightLength) / 2);
+    const size_t newRightLength = ((leftLength + rightLength) - newLeftLength);
+    if(leftLength > newLeftLength) {
+        const size_t moved = (leftLength - newLeftLength);
+        memmove(&right->values[moved], right->values, (rightLength * sizeof(double)));
+        memcpy(right->values, &left->values[newLeftLength], (moved * sizeof(double)));
+        for(size_t i = newLeftLength; i < leftLength; i++)
+            left->values[i] = NAN;
+    } else {
+        const size_t moved = (newLeftLength - leftLength);
+        memcpy(&left->values[leftLength], right->values, (moved * sizeof(double)));
+        memmove(right->values, &right->values[moved], (newRightLength * sizeof(double)));
+        for(size_t i = newRightLength; i < rightLength; i++)
+            right->values[i] = NAN;
+    }
+
+    parent->sizes[leftChild] = (uint32_t) newLeftLength;
+    parent->sizes[rightChild] = (uint32_t) newRightLength;
+    parent->keys[rightChild] = right->values[0];
+}
+
+static void tree_rebalance_inner(Tree_MedianWindow *window, size_t level) {
+    for(; level <= window->height; level++) {
+        TreeInner *node = &window->inners[window->pathNodes[level]];
+        if(level == window->height) {
+            // The root only needs two children, a root with a single child is replaced by it
+            if(node->count == 1) {
+                window->freeInners[window->freeInnersLength++] = window->root;
+                window->root = node->children[0];
+                window->height--;
+            }
+            return;
+        }
+
+        if(node->count >= TREE_INNER_MIN)
+            return;
+
+        TreeInner *parent = &window->inners[window->pathNodes[level + 1]];
+        const uint32_t child = window->pathChildren[level + 1];
+        const uint32_t leftChild = (child > 0) ? (child - 1) : child;
+        const uint32_t rightChild = (leftChild + 1);
+        TreeInner *left = &window->inners[parent->children[leftChild]];
+        TreeInner *right = &window->inners[parent->children[rightChild]];
+        const size_t leftCount = left->count;
+        const size_t rightCount = right->count;
+
+        if((leftCount + rightCount) <= TREE_INNER_MERGE_MAX) {
+            inner_entries_move(left, leftCount, right, 0, rightCount);
+            left->count = (uint32_t) (leftCount + rightCount);
+            parent->sizes[leftChild] += parent->sizes[rightChild];
+            window->freeInners[window->freeInnersLength++] = parent->children[rightChild];
+            inner_entry_remove(parent, rightChild);
+            continue;
+        }
+
+        const size_t newLeftCount = ((leftCount + rightCount) / 2);
+        const size_t newRightCount = ((leftCount + rightCount) - newLeftCount);
+        if(leftCount > newLeftCount) {
+            const size_t moved = (leftCount - newLeftCount);
+            inner_entries_move(right, moved, right, 0, rightCount);
+            const uint32_t movedSize = inner_entries_move(right, 0, left, newLeftCount, moved);
+            inner_entries_clear(left, newLeftCount, leftCount);
+            parent->sizes[leftChild] -= movedSize;
+            parent->sizes[rightChild] += movedSize;
+        } else {
+            const size_t moved = (newLeftCount - leftCount);
+            const uint32_t movedSize = inner_entries_move(left, leftCount, right, 0, moved);
+            inner_entries_move(right, 0, right, moved, newRightCount);
+            inner_entries_clear(right, newRightCount, rightCount);
+            parent->sizes[leftChild] += movedSize;
+            parent->sizes[rightChild] -= movedSize;
+        }
+
+        left->count = (uint32_t) newLeftCount;
+        right->count = (uint32_t) newRightCount;
+        parent->keys[rightChild] = right->keys[0];
+        return;
+    }
+}
+
+static inline void leaf_insert(TreeLeaf *leaf, double value) {
+    // The values greater than the new value move one slot up and the new value goes into the first slot that is
+    // not less than or equal to it (NaN included). Comparing the values instead of computing the position keeps
+    // this fixed length pass free of data dependent branches. The copy has a -inf in front of the first value.
+    double previousValues[TREE_LEAF_CAPACITY + 1];
+    previousValues[0] = -INFINITY;
+    memcpy(&previousValues[1], leaf->values, sizeof(leaf->values));
+    for(size_t i = 0; i < TREE_LEAF_CAPACITY; i++) {
+        const double belowValue = previousValues[i];
+        const double currentValue = previousValues[i + 1];
+        const bool isPosition = ((belowValue <= value) && !(currentValue <= value));
+        leaf->values[i] = (belowValue > value) ? belowValue : (isPosition ? value : currentValue);
+    }
+}
+
+static inline void leaf_remove(TreeLeaf *leaf, double value) {
+    // The values from the first one equal to the value on move one slot down, NaN slots stay NaN.
+    // The last slot is free afterwards, as the leaf held the value.
+    for(size_t i = 0; i < (TREE_LEAF_CAPACITY - 1); i++) {
+        const double currentValue = leaf->values[i];
+        const double aboveValue = leaf->values[i + 1];
+        leaf->values[i] = (currentValue >= value) ? aboveValue : currentValue;
+    }
+    leaf->values[TREE_LEAF_CAPACITY - 1] = NAN;
+}
+
+static inline uint32_t leaf_allocate(Tree_MedianWindow *window) {
+    const uint32_t leafIndex = window->freeLeaves[--window->freeLeavesLength];
+    for(size_t i = 0; i < TREE_LEAF_CAPACITY; i++)
+        window->leaves[leafIndex].values[i] = NAN;
+    return leafIndex;
+}
+
+static inline uint32_t inner_child_index(const TreeInner *inner, double value) {
+    // The last child whose minimum is less than or equal to the value (the first child for smaller values)
+    uint32_t child = 0;
+    for(size_t i = 1; i < TREE_INNER_CAPACITY; i++)
+        child += (inner->keys[i] <= value);
+    return child;
+}
+
+static inline uint32_t inner_allocate(Tree_MedianWindow *window) {
+    const uint32_t innerIndex = window->freeInners[--window->freeInnersLength];
+    inner_entries_clear(&window->inners[innerIndex], 0, TREE_INNER_CAPACITY);
+    window->inners[innerIndex].count = 0;
+    return innerIndex;
+}
+
+static inline uint32_t inner_entries_move(TreeInner *target, size_t targetPosition, TreeInner *source,
+    size_t sourcePosition, size_t count) {
+    // The nodes may be the same, returns the number of values below the moved entries
+    memmove(&target->keys[targetPosition], &source->keys[sourcePosition], (count * sizeof(double)));
+    memmove(&target->sizes[targetPosition], &source->sizes[sourcePosition], (count * sizeof(uint32_t)));
+    memmove(&target->children[targetPosition], &source->children[sourcePosition], (count * sizeof(uint32_t)));
+
+    uint32_t movedSize = 0;
+    for(size_t i = 0; i < count; i++)
+        movedSize += target->sizes[targetPosition + i];
+    return movedSize;
+}
+
+static inline void inner_entries_clear(TreeInner *inner, size_t from, size_t to) {
+    for(size_t i = from; i < to; i++) {
+        inner->keys[i] = NAN;
+        inner->sizes[i] = 0;
+    }
+}
+
+static inline void inner_entry_insert(TreeInner *inner, size_t position, double key, uint32_t size, uint32_t child) {
+    inner_entries_move(inner, (position + 1), inner, position, (inner->count - position));
+    inner->keys[position] = key;
+    inner->sizes[position] = size;
+    inner->children[position] = child;
+    inner->count++;
+}
+
+static inline void inner_entry_remove(TreeInner *inner, size_t position) {
+    inner_entries_move(inner, position, inner, (position + 1), (inner->count - position - 1));
+    inner->count--;
+    inner_entries_clear(inner, inner->count, (inner->count + 1));
+}
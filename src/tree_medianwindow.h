@@ -0,0 +1,65 @@
+#ifndef TREE_MEDIANWINDOW_H
+#define TREE_MEDIANWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#define STD_ALIGNMENT 8
+#define TREE_CACHE_LINE 64
+#define TREE_LEAF_CAPACITY 16
+#define TREE_INNER_CAPACITY 16
+// Every inner node except the root has at least 4 children, so 16 levels cover any window size
+#define TREE_MAX_HEIGHT 16
+
+// A leaf stores up to TREE_LEAF_CAPACITY sorted values (2 cache lines), the unused slots are NaN.
+// Its number of values is stored in the parent (or in Tree_MedianWindow.validCount for a root leaf).
+typedef struct TreeLeaf
+{
+    double values[TREE_LEAF_CAPACITY];
+} TreeLeaf;
+
+// An inner node stores the minimum and the number of values of every child subtree, the unused keys are NaN
+typedef struct TreeInner
+{
+    double keys[TREE_INNER_CAPACITY];
+    uint32_t sizes[TREE_INNER_CAPACITY];
+    uint32_t children[TREE_INNER_CAPACITY];
+    uint32_t count;
+} TreeInner;
+
+// An order-statistic B+-tree over the valid (non-NaN) values of the window, NaN values are only counted.
+// The nodes are taken from two preallocated pools, height is the number of inner levels above the leaves.
+typedef struct Tree_MedianWindow
+{
+    size_t windowSize;
+    size_t validCount;
+    size_t nanCount;
+    bool ignoreNaNWindows;
+    uint32_t root;
+    uint32_t height;
+    TreeLeaf *leaves;
+    TreeInner *inners;
+    uint32_t *freeLeaves;
+    uint32_t freeLeavesLength;
+    uint32_t *freeInners;
+    uint32_t freeInnersLength;
+    uint32_t pathNodes[TREE_MAX_HEIGHT + 1];
+    uint32_t pathChildren[TREE_MAX_HEIGHT + 1];
+} Tree_MedianWindow;
+
+void tree_medianwindow_initialize(char **memory, size_t windowSize, bool ignoreNaNWindows,
+    Tree_MedianWindow **window);
+void tree_medianwindow_add(Tree_MedianWindow *window, double value);
+void tree_medianwindow_replace(Tree_MedianWindow *window, double oldValue, double newValue);
+void tree_medianwindow_result(Tree_MedianWindow *restrict window, double *restrict output);
+// Writes the values of the given ascending ranks (0 is the smallest valid value) to values in one descent
+void tree_medianwindow_select(const Tree_MedianWindow *restrict window, const size_t *restrict ranks, size_t count,
+    double *restrict values);
+size_t tree_medianwindow_est_mem(size_t windowSize);
+
+#define SIZE_OF_TREE_MEDIAN_WINDOW sizeof(Tree_MedianWindow)
+
+#endif
@@ -31,14 +31,15 @@ void median_tester_gen_medians(double *array, size_t length, size_t windowSize,
     for(size_t i = 0; i < neededWindows; i++) {
         size_t nanCounter = 0;
         build_nan_free_array((array + currentPos), windowSize, buffer, &nanCounter);
-        if((nanCounter > 0) && (ignoreNaNWindows)) {
+        // A window of NaN values only has no median either
+        const size_t validNum = (windowSize - nanCounter);
+        if(((nanCounter > 0) && (ignoreNaNWindows)) || (validNum == 0)) {
             *output = NAN;
             output++;
             currentPos += steps;
             continue;
         }
 
-        const size_t validNum = (windowSize - nanCounter);
         qsort(buffer, validNum, sizeof(double), &compare_doubles);
 
         const size_t middle = (validNum / 2);
@@ -7,9 +7,24 @@
  *        It is important to note that the edge case tests are tailored to the sizes of the specific window
  *        implementations. This means that the tiny window tests validate the dedicated Sorting/Median Network
  *        implementation used for median calculation, while the big window tests validate the specific
- *        double-heap implementation.
- *        Please note: Sorting/Median Networks are used for window sizes from 2 to 8. The double-heap approach,
- *        on the other hand, is used for larger window sizes.
+ *        double-heap implementation. The double-heap edge case tests force it on heavy duplicates, sorted input,
+ *        bursts of NaN values, the largest windows an input accepts and window sizes at which the last node of a heap
+ *        of any arity gains or loses children. The child selection tests run every vectorized child selection of
+ *        the double-heap the host supports against the scalar one.
+ *        Please note: Sorting/Median Networks can be used for window sizes from 2 to 25. The double-heap approach,
+ *        on the other hand, is used for larger window sizes, unless the cost model prefers a sorted array
+ *        (small to medium windows), the order-statistic B+-tree, the Fenwick tree over the ranks of the whole
+ *        input or to select every window on its own. The select tests compare the selection of every window with the
+ *        double-heap.
+ *        The engine tests therefore force every engine on the same inputs and run the median networks on every
+ *        window size they support. Integer inputs are counted in a histogram instead, which the histogram tests
+ *        cover with integers stored as doubles as well as with 8/16-bit integers. The float tests run the median
+ *        networks and the double-heap on single precision values, and the integer tests run them on int32 and int64
+ *        values with every averaging of the two middle values. The quantile tests split the double-heap at other
+ *        quantiles and ranks than the median and take several quantiles at once from the B+-tree or one double-heap
+ *        each. The MAD tests compare the median absolute deviation with the sorted deviations of every window, and
+ *        the Hampel tests compare the filtered values and the outlier mask with the same sorted windows. The IQR
+ *        tests take both quartiles of every sorted window with every interpolation.
  * @version 0.1
  * @date 2026-01-02
  *
@@ -21,8 +36,14 @@
 #include <assert.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <pthread.h>
 
 #include "medianwindow_api.h"
+#include "median_window.h"
+#include "mad_medianwindow.h"
+#include "hampel_medianwindow.h"
+#include "iqr_medianwindow.h"
 #include "mediantester.h"
 
 #define TEST_SEED 0xC0FFEE
@@ -38,6 +59,25 @@
 #define TEST_ARRAY_SIZE_EDGE_TESTS_BIG 20
 #define TEST_EDGE_CASE_BIG_WINDOWSIZE 10
 
+#define TEST_ARRAY_SIZE_HEAP_EDGE_TESTS 2000
+#define TEST_HEAP_EDGE_CASE_PATTERNS 5
+#define TEST_HEAP_EDGE_CASE_SMALL_RANGE 3
+#define TEST_HEAP_EDGE_CASE_OUTLIER_DISTANCE 97
+#define TEST_HEAP_EDGE_CASE_NAN_BURST 120
+#define TEST_HEAP_EDGE_CASE_INF_DISTANCE 13
+#define TEST_ARRAY_SIZE_HEAP_ARITY_TESTS 600
+
+#define TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS 20000
+#define TEST_CHILD_SELECTION_PATTERNS 3
+#define TEST_CHILD_SELECTION_SMALL_RANGE 4
+#define TEST_CHILD_SELECTION_RAMP 5000
+
+// The medians of the typed windows with the same signature
+#define TEST_RESULT_F64(window, dest) medianwindow_result(window, dest)
+#define TEST_RESULT_F32(window, dest) medianwindow_result_f32(window, dest)
+#define TEST_RESULT_I32(window, dest) medianwindow_result_i32(window, MEDIANWINDOW_AVERAGING_FLOOR, dest)
+#define TEST_RESULT_I64(window, dest) medianwindow_result_i64(window, MEDIANWINDOW_AVERAGING_FLOOR, dest)
+
 #define TEST_ARRAY_SIZE_FOR_CORRECTNESS 100000
 
 #define TEST_SPC_NUMBERS_NANS_COUNT_ONE 1000
@@ -78,6 +118,46 @@
 #define TEST_TEN_WINDOWSIZE 12000
 #define TEST_TEN_STEPS 9991
 
+#define TEST_ARRAY_SIZE_STREAM_TESTS 20000
+#define TEST_STREAM_WINDOWSIZE 257
+
+#define TEST_ARRAY_SIZE_WORKSPACE_TESTS 20000
+#define TEST_WORKSPACE_MAX_WINDOWSIZE 1153
+
+#define TEST_ARRAY_SIZE_SELECT_TESTS 20000
+
+#define TEST_ARRAY_SIZE_ENGINE_TESTS 20000
+#define TEST_ENGINE_TINY_MAX_WINDOWSIZE 25
+#define TEST_CALIBRATION_PATH "test/calibration.tmp"
+#define TEST_CALIBRATION_RELOADS 200
+
+#define TEST_ARRAY_SIZE_PARALLEL_TESTS 100000
+
+#define TEST_BATCH_NUM_SERIES 37
+#define TEST_BATCH_MAX_LENGTH 500
+
+#define TEST_ARRAY_SIZE_HISTOGRAM_TESTS 20000
+#define TEST_HISTOGRAM_MAX_RANGE 65536
+
+#define TEST_ARRAY_SIZE_FLOAT_TESTS 20000
+
+#define TEST_ARRAY_SIZE_INTEGER_TESTS 5000
+#define TEST_INTEGER_SMALL_RANGE 16
+
+#define TEST_ARRAY_SIZE_QUANTILE_TESTS 5000
+#define TEST_QUANTILE_NUM_QUANTILES 7
+#define TEST_QUANTILE_NUM_RANKS 4
+#define TEST_QUANTILES_FEW 3
+#define TEST_QUANTILES_MANY 9
+
+#define TEST_ARRAY_SIZE_MAD_TESTS 5000
+#define TEST_MAD_SMALL_RANGE 8
+
+#define TEST_ARRAY_SIZE_HAMPEL_TESTS 5000
+#define TEST_HAMPEL_SPIKE 10000
+
+#define TEST_ARRAY_SIZE_IQR_TESTS 5000
+
 static void run_standard_tests(void);
 
 static void run_edge_case_tests_tiny_window(void);
@@ -92,6 +172,21 @@ static void run_second_edge_case_test_big_window(void);
 static void run_third_edge_case_test_big_window(void);
 static void run_fourth_edge_case_test_big_window(void);
 
+static void run_heap_edge_case_tests(void);
+static void heap_edge_case_array_init(size_t pattern, size_t length, double *dest);
+static bool test_heap_edge_case(double *testArray, size_t testArrayLength, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows);
+
+static void run_child_selection_tests(void);
+static bool test_child_selection_f64(const double *testArray, size_t testArrayLength, size_t windowSize,
+    MedianWindowChildSelection selection);
+static bool test_child_selection_f32(const double *testArray, size_t testArrayLength, size_t windowSize,
+    MedianWindowChildSelection selection);
+static bool test_child_selection_i32(const double *testArray, size_t testArrayLength, size_t windowSize,
+    MedianWindowChildSelection selection);
+static bool test_child_selection_i64(const double *testArray, size_t testArrayLength, size_t windowSize,
+    MedianWindowChildSelection selection);
+
 static void run_tests_normal_input(void);
 static bool test_normal_input(size_t testArrayLength, size_t windowSize, size_t steps);
 
@@ -100,7 +195,59 @@ static void run_tests_normal_spc_input_not_ignoring_nan(void);
 static bool test_input_with_spc_numbers(size_t testArrayLength, size_t windowSize, size_t steps,
     bool ignoreNanWindows, size_t numNaNs, size_t numInfs);
 
+static void run_workspace_tests(void);
+static void run_stream_tests(void);
+static bool test_stream(size_t testArrayLength, size_t windowSize, bool ignoreNaNWindows,
+    size_t numNaNs, size_t numInfs);
+
+static void run_select_tests(void);
+static bool test_select(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows);
+
+static void run_engine_tests(void);
+static bool test_engine(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindowEngine engine);
+static void *test_engine_reload_calibration(void *argument);
+
+static void run_parallel_tests(void);
+
+static void run_batch_tests(void);
+static bool test_batch(size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout,
+    size_t numThreads);
+
+static void run_histogram_tests(void);
+static bool test_histogram(size_t testArrayLength, size_t windowSize, size_t steps, size_t range);
+static void assert_equal_medians(const double *expected, const double *actual, size_t length);
+static bool aligned_pointer(const void *pointer);
+
+static void run_float_tests(void);
+static bool test_float(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows);
+
+static void run_integer_tests(void);
+static bool test_integer(size_t testArrayLength, size_t windowSize, size_t steps, bool fullRange);
+static int compare_int64(const void *a, const void *b);
+
+static void run_quantile_tests(void);
+static bool test_quantile(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows);
+static bool test_quantiles(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    size_t numQuantiles, MedianWindowInterpolation interpolation);
+static double quantile_of_sorted(const double *sortedValues, size_t numValues, double quantile,
+    MedianWindowInterpolation interpolation);
+static int compare_double(const void *a, const void *b);
+
+static void run_mad_tests(void);
+static bool test_mad(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows, bool ties);
+static double median_of_sorted(const double *sortedValues, size_t numValues);
+
+static void run_hampel_tests(void);
+static bool test_hampel(size_t testArrayLength, size_t halfWindow, double threshold, bool ignoreNaNWindows,
+    bool ties);
+
+static void run_iqr_tests(void);
+static bool test_iqr(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindowInterpolation interpolation);
+
 static void test_array_init(size_t length, double lowestValue, double highestValue, double *dest);
+static bool test_array_init_with_spc_numbers(size_t length, size_t numNaNs, size_t numInfs, double *dest);
 static void test_array_init_random_nans(double *testArray, size_t *currentIndex, size_t num,
     size_t *spcNumbersIndizesArray);
 static void test_array_init_random_posinfs(double *testArray, size_t *currentIndex, size_t num,
@@ -116,9 +263,24 @@ int main(void) {
     run_standard_tests();
     run_edge_case_tests_tiny_window();
     run_edge_case_tests_big_window();
+    run_heap_edge_case_tests();
+    run_child_selection_tests();
     run_tests_normal_input();
     run_tests_normal_spc_input_ignoring_nan();
     run_tests_normal_spc_input_not_ignoring_nan();
+    run_workspace_tests();
+    run_stream_tests();
+    run_select_tests();
+    run_engine_tests();
+    run_parallel_tests();
+    run_batch_tests();
+    run_histogram_tests();
+    run_float_tests();
+    run_integer_tests();
+    run_quantile_tests();
+    run_mad_tests();
+    run_hampel_tests();
+    run_iqr_tests();
     return 0;
 }
 
@@ -430,6 +592,202 @@ static void run_fourth_edge_case_test_big_window(void) {
         assert(outputArray[i] == 7);
 }
 
+// The following tests force the double-heap on inputs that stress the sift loops of its inline heap values: heavy
+// duplicates (every sift stops at equal values), sorted input (every new value sifts through all levels), NaN values
+// that empty and refill whole windows (NaN nodes only differ from heap nodes by their type) and
+// the largest windows an input accepts (length - steps - 1 values, so the window moves only once or twice).
+static void run_heap_edge_case_tests(void) {
+    const size_t stepSizes[] = { 1, 7 };
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+    double testArray[TEST_ARRAY_SIZE_HEAP_EDGE_TESTS];
+
+    for(size_t pattern = 0; pattern < TEST_HEAP_EDGE_CASE_PATTERNS; pattern++) {
+        heap_edge_case_array_init(pattern, TEST_ARRAY_SIZE_HEAP_EDGE_TESTS, testArray);
+        for(size_t j = 0; j < numStepSizes; j++) {
+            const size_t windowSizes[] = { 26, 100, (TEST_ARRAY_SIZE_HEAP_EDGE_TESTS - stepSizes[j] - 1) };
+            const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+            for(size_t i = 0; i < numWindowSizes; i++) {
+                assert(test_heap_edge_case(testArray, TEST_ARRAY_SIZE_HEAP_EDGE_TESTS, windowSizes[i], stepSizes[j],
+                    false));
+                assert(test_heap_edge_case(testArray, TEST_ARRAY_SIZE_HEAP_EDGE_TESTS, windowSizes[i], stepSizes[j],
+                    true));
+            }
+        }
+    }
+
+    // Every arity K_ARY_HEAP_CHILDREN can be built with must handle a last node with any number of children. Both
+    // heaps hold about half of the window, so these window sizes cover heaps of up to K + 1 values and of about
+    // K * K + K + 1 values (the first node of the third level) for K = 2, 4, 8 and 16.
+    const size_t arityWindowSizes[][2] = { { 2, 48 }, { 140, 152 }, { 540, 552 } };
+    const size_t numArityRanges = (sizeof(arityWindowSizes) / sizeof(arityWindowSizes[0]));
+    for(size_t pattern = 0; pattern < TEST_HEAP_EDGE_CASE_PATTERNS; pattern++) {
+        heap_edge_case_array_init(pattern, TEST_ARRAY_SIZE_HEAP_ARITY_TESTS, testArray);
+        for(size_t i = 0; i < numArityRanges; i++) {
+            for(size_t windowSize = arityWindowSizes[i][0]; windowSize <= arityWindowSizes[i][1]; windowSize++) {
+                assert(test_heap_edge_case(testArray, TEST_ARRAY_SIZE_HEAP_ARITY_TESTS, windowSize, 1, false));
+                assert(test_heap_edge_case(testArray, TEST_ARRAY_SIZE_HEAP_ARITY_TESTS, windowSize, 1, true));
+            }
+        }
+    }
+
+    printf("All edge case tests for the double-heap passed\n");
+}
+
+static void heap_edge_case_array_init(size_t pattern, size_t length, double *dest) {
+    for(size_t i = 0; i < length; i++) {
+        switch (pattern) {
+            case 0:
+                // Few distinct values
+                dest[i] = (double) (rand() % TEST_HEAP_EDGE_CASE_SMALL_RANGE);
+                break;
+            case 1:
+                // Equal values with rare outliers on both sides
+                dest[i] = ((i % TEST_HEAP_EDGE_CASE_OUTLIER_DISTANCE) != 0) ? 7 : (((i % 2) == 0) ? -1000 : 1000);
+                break;
+            case 2:
+                dest[i] = (double) i;
+                break;
+            case 3:
+                dest[i] = (double) (length - i);
+                break;
+            default:
+                // Bursts of NaN values that empty whole windows, valid values with +/-INFINITY and every other
+                // value NaN, so NaN nodes keep entering and leaving the ring
+                if(((i / TEST_HEAP_EDGE_CASE_NAN_BURST) % 3) == 0)
+                    dest[i] = NAN;
+                else if(((i / TEST_HEAP_EDGE_CASE_NAN_BURST) % 3) == 1)
+                    dest[i] = ((i % TEST_HEAP_EDGE_CASE_INF_DISTANCE) != 0) ? (double) (rand() % 2000)
+                        : (((i % 2) == 0) ? INFINITY : -INFINITY);
+                else
+                    dest[i] = ((i % 2) == 0) ? NAN : (double) (rand() % 2000);
+                break;
+        }
+    }
+}
+
+static bool test_heap_edge_case(double *testArray, size_t testArrayLength, size_t windowSize, size_t steps,
+    bool ignoreNaNWindows) {
+    double *resultArray_heap = NULL;
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_heap);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_mediantester);
+    if((resultArray_heap == NULL) || (resultArray_mediantester == NULL)) {
+        free(resultArray_heap);
+        free(resultArray_mediantester);
+        return false;
+    }
+
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_HEAP, resultArray_heap));
+    median_tester_gen_medians(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        resultArray_mediantester);
+    assert_equal_medians(resultArray_mediantester, resultArray_heap, resultArray_length);
+
+    free(resultArray_heap);
+    resultArray_heap = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+    return true;
+}
+
+// The following tests run every vectorized child selection the host supports against the scalar one for all value
+// types, since a window only ever uses the widest one. Few distinct values make the vector kernels choose between
+// equal children, and a ramp makes every new value sift through all levels.
+static void run_child_selection_tests(void) {
+    const size_t windowSizes[] = { 9, 17, 64, 73, 1153, 4097 };
+    const MedianWindowChildSelection selections[] = { MEDIANWINDOW_CHILD_SELECTION_AVX2,
+        MEDIANWINDOW_CHILD_SELECTION_AVX512 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numSelections = (sizeof(selections) / sizeof(selections[0]));
+    double *testArray = (double* ) malloc(TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS * sizeof(double));
+    assert(testArray != NULL);
+
+    for(size_t pattern = 0; pattern < TEST_CHILD_SELECTION_PATTERNS; pattern++) {
+        for(size_t i = 0; i < TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS; i++) {
+            if(pattern == 0)
+                testArray[i] = (double) ((rand() % TEST_CHILD_SELECTION_SMALL_RANGE)
+                    - (TEST_CHILD_SELECTION_SMALL_RANGE / 2));
+            else if(pattern == 1)
+                testArray[i] = (double) (rand() - (RAND_MAX / 2));
+            else
+                testArray[i] = (double) (i % TEST_CHILD_SELECTION_RAMP);
+        }
+
+        for(size_t i = 0; i < numSelections; i++) {
+            for(size_t j = 0; j < numWindowSizes; j++) {
+                assert(test_child_selection_f64(testArray, TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS, windowSizes[j],
+                    selections[i]));
+                assert(test_child_selection_f32(testArray, TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS, windowSizes[j],
+                    selections[i]));
+                assert(test_child_selection_i32(testArray, TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS, windowSizes[j],
+                    selections[i]));
+                assert(test_child_selection_i64(testArray, TEST_ARRAY_SIZE_CHILD_SELECTION_TESTS, windowSizes[j],
+                    selections[i]));
+            }
+        }
+    }
+
+    free(testArray);
+    testArray = NULL;
+    printf("All child selection tests passed\n");
+}
+
+// Feeds the same values into a window of the given child selection and into a scalar one, whose medians must be equal
+// after every value. A selection that is not available for the value type or on the host passes without comparison.
+#define TEST_CHILD_SELECTION_OF_TYPE(NAME, WINDOW, VALUE, SUFFIX, RESULT) \
+static bool NAME(const double *testArray, size_t testArrayLength, size_t windowSize, \
+    MedianWindowChildSelection selection) { \
+    char *scalarMemory = (char* ) malloc(medianwindow_est_mem##SUFFIX(windowSize)); \
+    char *vectorMemory = (char* ) malloc(medianwindow_est_mem##SUFFIX(windowSize)); \
+    if((scalarMemory == NULL) || (vectorMemory == NULL)) { \
+        free(scalarMemory); \
+        free(vectorMemory); \
+        return false; \
+    } \
+    \
+    char *memory = scalarMemory; \
+    WINDOW *scalarWindow = NULL; \
+    medianwindow_initialize##SUFFIX(&memory, windowSize, 1, false, &scalarWindow); \
+    memory = vectorMemory; \
+    WINDOW *vectorWindow = NULL; \
+    medianwindow_initialize##SUFFIX(&memory, windowSize, 1, false, &vectorWindow); \
+    assert((size_t) (memory - vectorMemory) <= medianwindow_est_mem##SUFFIX(windowSize)); \
+    assert(aligned_pointer(vectorWindow->minHeap)); \
+    assert(medianwindow_use_child_selection##SUFFIX(scalarWindow, MEDIANWINDOW_CHILD_SELECTION_SCALAR)); \
+    \
+    if(medianwindow_use_child_selection##SUFFIX(vectorWindow, selection)) { \
+        for(size_t i = 0; i < testArrayLength; i++) { \
+            if(i < windowSize) { \
+                medianwindow_addNew##SUFFIX(scalarWindow, (VALUE) testArray[i]); \
+                medianwindow_addNew##SUFFIX(vectorWindow, (VALUE) testArray[i]); \
+                if(i < (windowSize - 1)) \
+                    continue; \
+            } else { \
+                medianwindow_updateOld##SUFFIX(scalarWindow, (VALUE) testArray[i]); \
+                medianwindow_updateOld##SUFFIX(vectorWindow, (VALUE) testArray[i]); \
+            } \
+            \
+            VALUE scalarMedian; \
+            VALUE vectorMedian; \
+            RESULT(scalarWindow, &scalarMedian); \
+            RESULT(vectorWindow, &vectorMedian); \
+            assert(vectorMedian == scalarMedian); \
+        } \
+    } \
+    \
+    free(scalarMemory); \
+    scalarMemory = NULL; \
+    free(vectorMemory); \
+    vectorMemory = NULL; \
+    return true; \
+}
+
+TEST_CHILD_SELECTION_OF_TYPE(test_child_selection_f64, MedianWindow, double, , TEST_RESULT_F64)
+TEST_CHILD_SELECTION_OF_TYPE(test_child_selection_f32, MedianWindow_F32, float, _f32, TEST_RESULT_F32)
+TEST_CHILD_SELECTION_OF_TYPE(test_child_selection_i32, MedianWindow_I32, int32_t, _i32, TEST_RESULT_I32)
+TEST_CHILD_SELECTION_OF_TYPE(test_child_selection_i64, MedianWindow_I64, int64_t, _i64, TEST_RESULT_I64)
+
 // The following tests are testing the correctness of the resulting median computation.
 // These tests generate an array consisting of random double values in the range from LOWEST_VALUE_NORMAL_INPUT_TEST
 // to HIGHEST_VALUE_NORMAL_INPUT_TEST. No NaN or infinity values are included in these tests.
@@ -698,8 +1056,1433 @@ static bool test_input_with_spc_numbers(size_t testArrayLength, size_t windowSiz
     return true;
 }
 
+// The following tests verify the workspace interface. One workspace, sized for the largest window,
+// is reused for all windows and every result must equal the result of the allocating interface.
+static void run_workspace_tests(void) {
+    const size_t windowSizes[] = { 2, 5, 8, 10, 100, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 3, 8, 1, 10, 373 };
+    const size_t numTests = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+
+    double *testArray = (double* ) malloc(TEST_ARRAY_SIZE_WORKSPACE_TESTS * sizeof(double));
+    double *resultArray_sliding = (double* ) malloc(TEST_ARRAY_SIZE_WORKSPACE_TESTS * sizeof(double));
+    double *resultArray_workspace = (double* ) malloc(TEST_ARRAY_SIZE_WORKSPACE_TESTS * sizeof(double));
+    const size_t workspaceSize = sliding_medianwindow_ws_size(TEST_WORKSPACE_MAX_WINDOWSIZE);
+    double *workspace = (double* ) malloc(workspaceSize);
+    assert((testArray != NULL) && (resultArray_sliding != NULL) && (resultArray_workspace != NULL)
+        && (workspace != NULL));
+    assert(test_array_init_with_spc_numbers(TEST_ARRAY_SIZE_WORKSPACE_TESTS, 2000, 1000, testArray));
+
+    // Should return false because the workspace is too small
+    assert(!sliding_medianwindow_ws(testArray, TEST_ARRAY_SIZE_WORKSPACE_TESTS, TEST_WORKSPACE_MAX_WINDOWSIZE, 1,
+        false, resultArray_workspace, workspace, (workspaceSize - 1)));
+
+    // Should return false because the workspace is not aligned
+    assert(!sliding_medianwindow_ws(testArray, TEST_ARRAY_SIZE_WORKSPACE_TESTS, 10, 1,
+        false, resultArray_workspace, ((char* ) workspace) + 1, (workspaceSize - 1)));
+
+    // Should return false because workspace == NULL
+    assert(!sliding_medianwindow_ws(testArray, TEST_ARRAY_SIZE_WORKSPACE_TESTS, 10, 1,
+        false, resultArray_workspace, NULL, workspaceSize));
+
+    for(size_t i = 0; i < numTests; i++) {
+        for(size_t ignoreNaN = 0; ignoreNaN <= 1; ignoreNaN++) {
+            const size_t resultLength = ((TEST_ARRAY_SIZE_WORKSPACE_TESTS - windowSizes[i]) / stepSizes[i] + 1);
+            assert(sliding_medianwindow(testArray, TEST_ARRAY_SIZE_WORKSPACE_TESTS, windowSizes[i], stepSizes[i],
+                ignoreNaN, resultArray_sliding));
+            assert(sliding_medianwindow_ws(testArray, TEST_ARRAY_SIZE_WORKSPACE_TESTS, windowSizes[i],
+                stepSizes[i], ignoreNaN, resultArray_workspace, workspace, workspaceSize));
+            assert(memcmp(resultArray_sliding, resultArray_workspace, (resultLength * sizeof(double))) == 0);
+        }
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray_sliding);
+    resultArray_sliding = NULL;
+    free(resultArray_workspace);
+    resultArray_workspace = NULL;
+    free(workspace);
+    workspace = NULL;
+
+    printf("All workspace tests passed\n");
+}
+
+// The following tests verify the streaming interface. Every sample is pushed on its own and the median
+// after each push is compared with the result of the median tester for the same window.
+// Before the window is full, the median is calculated over the samples pushed so far.
+static void run_stream_tests(void) {
+    MedianWindowStream *stream = medianwindow_stream_create(4, false);
+    assert(stream != NULL);
+
+    // Should return false because no sample was pushed yet
+    double median = 0;
+    assert(!medianwindow_stream_median(stream, &median));
+
+    // Partially filled window: 3 -> 3, (3, 1) -> 2, (3, 1, NaN) -> 2
+    assert(medianwindow_stream_push(stream, 3));
+    assert(medianwindow_stream_median(stream, &median) && (median == 3));
+    assert(medianwindow_stream_push(stream, 1));
+    assert(medianwindow_stream_median(stream, &median) && (median == 2));
+    assert(medianwindow_stream_push(stream, NAN));
+    assert(medianwindow_stream_median(stream, &median) && (median == 2));
+
+    // Full window: (3, 1, NaN, 8) -> 3, then 3 leaves: (1, NaN, 8, 4) -> 4
+    assert(medianwindow_stream_push(stream, 8));
+    assert(medianwindow_stream_median(stream, &median) && (median == 3));
+    assert(medianwindow_stream_push(stream, 4));
+    assert(medianwindow_stream_median(stream, &median) && (median == 4));
+    medianwindow_stream_destroy(stream);
+
+    // Should return NULL because windowSize < 2
+    assert(medianwindow_stream_create(1, false) == NULL);
+
+    // A clone continues independently from the state of the original window
+    stream = medianwindow_stream_create(TEST_STREAM_WINDOWSIZE, false);
+    assert(stream != NULL);
+    for(size_t i = 0; i < (TEST_STREAM_WINDOWSIZE + 100); i++)
+        assert(medianwindow_stream_push(stream, (double) ((i * 7919) % 1000)));
+
+    MedianWindowStream *clonedStream = medianwindow_stream_clone(stream);
+    assert(clonedStream != NULL);
+    for(size_t i = 0; i < TEST_STREAM_WINDOWSIZE; i++) {
+        const double value = (i % 3 == 0) ? NAN : (double) ((i * 104729) % 1000);
+        double clonedMedian = 0;
+        assert(medianwindow_stream_push(stream, value));
+        assert(medianwindow_stream_push(clonedStream, value));
+        assert(medianwindow_stream_median(stream, &median));
+        assert(medianwindow_stream_median(clonedStream, &clonedMedian));
+        assert(median == clonedMedian);
+    }
+
+    assert(medianwindow_stream_push(clonedStream, 1e9));
+    assert(medianwindow_stream_median(clonedStream, &median));
+    medianwindow_stream_destroy(stream);
+    stream = NULL;
+    assert(medianwindow_stream_push(clonedStream, -1e9));
+    assert(medianwindow_stream_median(clonedStream, &median));
+    medianwindow_stream_destroy(clonedStream);
+    clonedStream = NULL;
+
+    assert(test_stream(TEST_ARRAY_SIZE_STREAM_TESTS, TEST_STREAM_WINDOWSIZE, false, 0, 0));
+    assert(test_stream(TEST_ARRAY_SIZE_STREAM_TESTS, TEST_STREAM_WINDOWSIZE, false, 2000, 1000));
+    assert(test_stream(TEST_ARRAY_SIZE_STREAM_TESTS, TEST_STREAM_WINDOWSIZE, true, 20, 1000));
+    assert(test_stream(TEST_ARRAY_SIZE_STREAM_TESTS, TEST_EDGE_CASE_TINY_WINDOWSIZE, false, 2000, 1000));
+
+    printf("All stream tests passed\n");
+}
+
+static bool test_stream(size_t testArrayLength, size_t windowSize, bool ignoreNaNWindows,
+    size_t numNaNs, size_t numInfs) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *resultArray_stream = (double* ) malloc(testArrayLength * sizeof(double));
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_mediantester_length = 0;
+    result_array_init(testArrayLength, windowSize, 1,
+        &resultArray_mediantester_length, &resultArray_mediantester);
+    MedianWindowStream *stream = medianwindow_stream_create(windowSize, ignoreNaNWindows);
+    if((testArray == NULL) || (resultArray_stream == NULL) || (resultArray_mediantester == NULL)
+        || (stream == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, numNaNs, numInfs, testArray))) {
+        free(testArray);
+        free(resultArray_stream);
+        free(resultArray_mediantester);
+        medianwindow_stream_destroy(stream);
+        return false;
+    }
+
+    assert(medianwindow_stream_push_many(stream, testArray, testArrayLength, resultArray_stream));
+    median_tester_gen_medians(testArray, testArrayLength, windowSize, 1,
+        ignoreNaNWindows, resultArray_mediantester);
+
+    for(size_t i = 0; i < resultArray_mediantester_length; i++) {
+        const double streamResult = resultArray_stream[i + windowSize - 1];
+        if(isnan(resultArray_mediantester[i])) {
+            assert(isnan(streamResult));
+            continue;
+        }
+
+        if(isinf(resultArray_mediantester[i])) {
+            assert(streamResult == resultArray_mediantester[i]);
+            continue;
+        }
+
+        assert(fabs(streamResult - resultArray_mediantester[i]) < EPSILON);
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray_stream);
+    resultArray_stream = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+    medianwindow_stream_destroy(stream);
+    stream = NULL;
+    return true;
+}
+
+// The following tests compare the selection of every window on its own (Floyd-Rivest) with the double-heap on odd and
+// even windows over input with NaN and +/-INFINITY values, from overlapping windows up to gaps between the windows.
+static void run_select_tests(void) {
+    const size_t windowSizes[] = { 2, 3, 26, 27, 100, 101, 1152, 1153 };
+    const size_t stepSizes[] = { 1, 64, 1153, 5000 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t i = 0; i < numWindowSizes; i++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            assert(test_select(TEST_ARRAY_SIZE_SELECT_TESTS, windowSizes[i], stepSizes[j], false));
+            assert(test_select(TEST_ARRAY_SIZE_SELECT_TESTS, windowSizes[i], stepSizes[j], true));
+        }
+    }
+
+    printf("All select tests passed\n");
+}
+
+static bool test_select(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *resultArray_select = NULL;
+    double *resultArray_heap = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_select);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_heap);
+    if((testArray == NULL) || (resultArray_select == NULL) || (resultArray_heap == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 20), (testArrayLength / 50),
+            testArray))) {
+        free(testArray);
+        free(resultArray_select);
+        free(resultArray_heap);
+        return false;
+    }
+
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_SELECT, resultArray_select));
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_HEAP, resultArray_heap));
+    assert_equal_medians(resultArray_heap, resultArray_select, resultArray_length);
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray_select);
+    resultArray_select = NULL;
+    free(resultArray_heap);
+    resultArray_heap = NULL;
+    return true;
+}
+
+// The following tests force every engine on the same inputs and compare the results with the median tester.
+// Afterwards the cost model is calibrated, stored and restored.
+static void run_engine_tests(void) {
+    const size_t windowSizes[] = { 2, 5, 8, 10, 25, 26, 64, 100, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 3, 4, 10, 1153 };
+    const MedianWindowEngine engines[] = { MEDIANWINDOW_ENGINE_TINY, MEDIANWINDOW_ENGINE_HEAP,
+        MEDIANWINDOW_ENGINE_SELECT, MEDIANWINDOW_ENGINE_SORTED, MEDIANWINDOW_ENGINE_FENWICK, MEDIANWINDOW_ENGINE_AUTO };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+    const size_t numEngines = (sizeof(engines) / sizeof(engines[0]));
+
+    for(size_t i = 0; i < numWindowSizes; i++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            for(size_t k = 0; k < numEngines; k++) {
+                if((engines[k] == MEDIANWINDOW_ENGINE_TINY) && (windowSizes[i] > TEST_ENGINE_TINY_MAX_WINDOWSIZE))
+                    continue;
+
+                assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, windowSizes[i], stepSizes[j], false, engines[k]));
+                assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, windowSizes[i], stepSizes[j], true, engines[k]));
+            }
+        }
+    }
+
+    // Every median network on its own
+    for(size_t windowSize = 2; windowSize <= TEST_ENGINE_TINY_MAX_WINDOWSIZE; windowSize++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, windowSize, stepSizes[j], false,
+                MEDIANWINDOW_ENGINE_TINY));
+            assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, windowSize, stepSizes[j], true,
+                MEDIANWINDOW_ENGINE_TINY));
+        }
+    }
+
+    // Should return false because the median networks only support window sizes up to 25
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS];
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+    test_array_init(TEST_ARRAY_SIZE_STD_TESTS, LOWEST_VALUE_NORMAL_INPUT_TEST, HIGHEST_VALUE_NORMAL_INPUT_TEST,
+        testArray);
+    assert(!sliding_medianwindow_with_engine(testArray, TEST_ARRAY_SIZE_STD_TESTS,
+        TEST_ENGINE_TINY_MAX_WINDOWSIZE + 1, 1, false, MEDIANWINDOW_ENGINE_TINY, outputArray));
+
+    // Should return false because the ranks of such an input would not fit into FENWICK_MEDIANWINDOW_MAX_MEMORY
+    // (the input is rejected before it is read)
+    assert(!sliding_medianwindow_with_engine(testArray, ((size_t) 1 << 40), TEST_ARRAY_SIZE_STD_TESTS, 1, false,
+        MEDIANWINDOW_ENGINE_FENWICK, outputArray));
+
+    // Should return false because the file does not exist
+    remove(TEST_CALIBRATION_PATH);
+    assert(!medianwindow_load_calibration(TEST_CALIBRATION_PATH));
+
+    // Should return false because the file is no stored cost model
+    FILE *file = fopen(TEST_CALIBRATION_PATH, "w");
+    assert(file != NULL);
+    fprintf(file, "heapPerElement 1\n");
+    fclose(file);
+    assert(!medianwindow_load_calibration(TEST_CALIBRATION_PATH));
+
+    assert(medianwindow_calibrate(TEST_CALIBRATION_PATH));
+    assert(medianwindow_load_calibration(TEST_CALIBRATION_PATH));
+
+    // The engine choice of the calibrated model must not change any result, even while another thread replaces it
+    pthread_t reloadingThread;
+    assert(pthread_create(&reloadingThread, NULL, &test_engine_reload_calibration, NULL) == 0);
+    assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, 5, 1, false, MEDIANWINDOW_ENGINE_AUTO));
+    assert(test_engine(TEST_ARRAY_SIZE_ENGINE_TESTS, 100, 60, true, MEDIANWINDOW_ENGINE_AUTO));
+    assert(pthread_join(reloadingThread, NULL) == 0);
+    remove(TEST_CALIBRATION_PATH);
+
+    printf("All engine tests passed\n");
+}
+
+static void *test_engine_reload_calibration(void *argument) {
+    (void) argument;
+    for(size_t i = 0; i < TEST_CALIBRATION_RELOADS; i++)
+        assert(medianwindow_load_calibration(TEST_CALIBRATION_PATH));
+    return NULL;
+}
+
+static bool test_engine(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindowEngine engine) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *resultArray_engine = NULL;
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_engine);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_mediantester);
+    if((testArray == NULL) || (resultArray_engine == NULL) || (resultArray_mediantester == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 20), (testArrayLength / 50),
+            testArray))) {
+        free(testArray);
+        free(resultArray_engine);
+        free(resultArray_mediantester);
+        return false;
+    }
+
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, engine,
+        resultArray_engine));
+    median_tester_gen_medians(testArray, testArrayLength, windowSize, steps,
+        ignoreNaNWindows, resultArray_mediantester);
+
+    for(size_t i = 0; i < resultArray_length; i++) {
+        if(isnan(resultArray_mediantester[i])) {
+            assert(isnan(resultArray_engine[i]));
+            continue;
+        }
+
+        if(isinf(resultArray_mediantester[i])) {
+            assert(resultArray_engine[i] == resultArray_mediantester[i]);
+            continue;
+        }
+
+        assert(fabs(resultArray_engine[i] - resultArray_mediantester[i]) < EPSILON);
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray_engine);
+    resultArray_engine = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+    return true;
+}
+
+// The following tests compare the multi-threaded results bit for bit with the serial ones, including more
+// threads than medians and step sizes that do not divide the chunk boundaries.
+static void run_parallel_tests(void) {
+    const size_t windowSizes[] = { 3, 8, 10, 100, 1153, 9999 };
+    const size_t stepSizes[] = { 1, 7, 4, 33, 373, 1 };
+    const size_t threadCounts[] = { 1, 2, 3, 8, 0 };
+    const size_t numTests = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numThreadCounts = (sizeof(threadCounts) / sizeof(threadCounts[0]));
+
+    double *testArray = (double* ) malloc(TEST_ARRAY_SIZE_PARALLEL_TESTS * sizeof(double));
+    double *resultArray_serial = (double* ) malloc(TEST_ARRAY_SIZE_PARALLEL_TESTS * sizeof(double));
+    double *resultArray_parallel = (double* ) malloc(TEST_ARRAY_SIZE_PARALLEL_TESTS * sizeof(double));
+    assert((testArray != NULL) && (resultArray_serial != NULL) && (resultArray_parallel != NULL));
+    assert(test_array_init_with_spc_numbers(TEST_ARRAY_SIZE_PARALLEL_TESTS, 5000, 2000, testArray));
+
+    // Should return false because inputArray == NULL
+    assert(!sliding_medianwindow_parallel(NULL, TEST_ARRAY_SIZE_PARALLEL_TESTS, 10, 1, false,
+        resultArray_parallel, 4));
+
+    for(size_t i = 0; i < numTests; i++) {
+        for(size_t ignoreNaN = 0; ignoreNaN <= 1; ignoreNaN++) {
+            const size_t resultLength = ((TEST_ARRAY_SIZE_PARALLEL_TESTS - windowSizes[i]) / stepSizes[i] + 1);
+            assert(sliding_medianwindow(testArray, TEST_ARRAY_SIZE_PARALLEL_TESTS, windowSizes[i], stepSizes[i],
+                ignoreNaN, resultArray_serial));
+            for(size_t j = 0; j < numThreadCounts; j++) {
+                assert(sliding_medianwindow_parallel(testArray, TEST_ARRAY_SIZE_PARALLEL_TESTS, windowSizes[i],
+                    stepSizes[i], ignoreNaN, resultArray_parallel, threadCounts[j]));
+                assert(memcmp(resultArray_serial, resultArray_parallel, (resultLength * sizeof(double))) == 0);
+            }
+        }
+    }
+
+    // More threads than medians: (20 - 10) / 4 + 1 = 3 medians on 8 threads
+    assert(sliding_medianwindow(testArray, 20, 10, 4, false, resultArray_serial));
+    assert(sliding_medianwindow_parallel(testArray, 20, 10, 4, false, resultArray_parallel, 8));
+    assert(memcmp(resultArray_serial, resultArray_parallel, (3 * sizeof(double))) == 0);
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray_serial);
+    resultArray_serial = NULL;
+    free(resultArray_parallel);
+    resultArray_parallel = NULL;
+
+    printf("All parallel tests passed\n");
+}
+
+// The following tests compare every sequence of a batch with the result of sliding_medianwindow for the
+// same sequence, for both layouts and sequences of different lengths.
+static void run_batch_tests(void) {
+    const size_t windowSizes[] = { 2, 5, 10, 100, 250 };
+    const size_t stepSizes[] = { 1, 1, 3, 60, 7 };
+    const size_t threadCounts[] = { 1, 4, 0 };
+    const size_t numTests = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numThreadCounts = (sizeof(threadCounts) / sizeof(threadCounts[0]));
+
+    for(size_t i = 0; i < numTests; i++) {
+        for(size_t j = 0; j < numThreadCounts; j++) {
+            for(size_t ignoreNaN = 0; ignoreNaN <= 1; ignoreNaN++) {
+                assert(test_batch(windowSizes[i], stepSizes[i], ignoreNaN, MEDIANWINDOW_ROW_MAJOR, threadCounts[j]));
+                assert(test_batch(windowSizes[i], stepSizes[i], ignoreNaN, MEDIANWINDOW_COLUMN_MAJOR,
+                    threadCounts[j]));
+            }
+        }
+    }
+
+    double testMatrix[2 * TEST_ARRAY_SIZE_STD_TESTS];
+    double outputMatrix[2 * TEST_ARRAY_SIZE_STD_TESTS];
+    test_array_init(2 * TEST_ARRAY_SIZE_STD_TESTS, LOWEST_VALUE_NORMAL_INPUT_TEST, HIGHEST_VALUE_NORMAL_INPUT_TEST,
+        testMatrix);
+
+    // Should return false because a sequence is longer than maxLength
+    const size_t tooLongLengths[2] = { TEST_ARRAY_SIZE_STD_TESTS, TEST_ARRAY_SIZE_STD_TESTS + 1 };
+    assert(!sliding_medianwindow_batch(testMatrix, 2, TEST_ARRAY_SIZE_STD_TESTS, tooLongLengths, 3, 1, false,
+        MEDIANWINDOW_ROW_MAJOR, outputMatrix, 2));
+
+    // Should return false because a sequence is shorter than the window
+    const size_t tooShortLengths[2] = { TEST_ARRAY_SIZE_STD_TESTS, 2 };
+    assert(!sliding_medianwindow_batch(testMatrix, 2, TEST_ARRAY_SIZE_STD_TESTS, tooShortLengths, 3, 1, false,
+        MEDIANWINDOW_ROW_MAJOR, outputMatrix, 2));
+
+    // Should return false because there is no sequence
+    assert(!sliding_medianwindow_batch(testMatrix, 0, TEST_ARRAY_SIZE_STD_TESTS, NULL, 3, 1, false,
+        MEDIANWINDOW_ROW_MAJOR, outputMatrix, 2));
+
+    printf("All batch tests passed\n");
+}
+
+static bool test_batch(size_t windowSize, size_t steps, bool ignoreNaNWindows, MedianWindowLayout layout,
+    size_t numThreads) {
+    const size_t matrixSize = (TEST_BATCH_NUM_SERIES * TEST_BATCH_MAX_LENGTH);
+    const size_t outputStride = ((TEST_BATCH_MAX_LENGTH - windowSize) / steps + 1);
+    double *testMatrix = (double* ) malloc(matrixSize * sizeof(double));
+    double *outputMatrix = (double* ) malloc(TEST_BATCH_NUM_SERIES * outputStride * sizeof(double));
+    double *testArray = (double* ) malloc(TEST_BATCH_MAX_LENGTH * sizeof(double));
+    double *resultArray = (double* ) malloc(outputStride * sizeof(double));
+    size_t lengths[TEST_BATCH_NUM_SERIES];
+    if((testMatrix == NULL) || (outputMatrix == NULL) || (testArray == NULL) || (resultArray == NULL)
+        || (!test_array_init_with_spc_numbers(matrixSize, (matrixSize / 20), (matrixSize / 50), testMatrix))) {
+        free(testMatrix);
+        free(outputMatrix);
+        free(testArray);
+        free(resultArray);
+        return false;
+    }
+
+    // The lengths vary between (windowSize + steps + 1) and TEST_BATCH_MAX_LENGTH
+    for(size_t i = 0; i < TEST_BATCH_NUM_SERIES; i++)
+        lengths[i] = (windowSize + steps + 1) + ((size_t) rand() % (TEST_BATCH_MAX_LENGTH - windowSize - steps));
+
+    assert(sliding_medianwindow_batch(testMatrix, TEST_BATCH_NUM_SERIES, TEST_BATCH_MAX_LENGTH, lengths, windowSize,
+        steps, ignoreNaNWindows, layout, outputMatrix, numThreads));
+
+    for(size_t i = 0; i < TEST_BATCH_NUM_SERIES; i++) {
+        const size_t resultLength = ((lengths[i] - windowSize) / steps + 1);
+        for(size_t j = 0; j < lengths[i]; j++) {
+            testArray[j] = (layout == MEDIANWINDOW_ROW_MAJOR)
+                ? testMatrix[(i * TEST_BATCH_MAX_LENGTH) + j] : testMatrix[(j * TEST_BATCH_NUM_SERIES) + i];
+        }
+
+        assert(sliding_medianwindow(testArray, lengths[i], windowSize, steps, ignoreNaNWindows, resultArray));
+        for(size_t j = 0; j < resultLength; j++) {
+            const double batchResult = (layout == MEDIANWINDOW_ROW_MAJOR)
+                ? outputMatrix[(i * outputStride) + j] : outputMatrix[(j * TEST_BATCH_NUM_SERIES) + i];
+            assert(memcmp(&batchResult, &resultArray[j], sizeof(double)) == 0);
+        }
+    }
+
+    free(testMatrix);
+    testMatrix = NULL;
+    free(outputMatrix);
+    outputMatrix = NULL;
+    free(testArray);
+    testArray = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    return true;
+}
+
 // Test Util Methods
 
+// The following tests run the histogram on integers stored as doubles (with NaN values and negative integers) and
+// on 8/16-bit integers. The medians of integers are exact, so they are compared bit for bit.
+static void run_histogram_tests(void) {
+    const size_t windowSizes[] = { 2, 5, 26, 100, 1000, 1153 };
+    const size_t stepSizes[] = { 1, 3, 1, 10, 1, 77 };
+    const size_t ranges[] = { 1, 2, 256, 4096, TEST_HISTOGRAM_MAX_RANGE };
+    const size_t numTests = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numRanges = (sizeof(ranges) / sizeof(ranges[0]));
+
+    for(size_t i = 0; i < numTests; i++) {
+        for(size_t j = 0; j < numRanges; j++)
+            assert(test_histogram(TEST_ARRAY_SIZE_HISTOGRAM_TESTS, windowSizes[i], stepSizes[i], ranges[j]));
+    }
+
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS];
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because the values are no integers
+    test_array_init(TEST_ARRAY_SIZE_STD_TESTS, LOWEST_VALUE_NORMAL_INPUT_TEST, HIGHEST_VALUE_NORMAL_INPUT_TEST,
+        testArray);
+    assert(!sliding_medianwindow_with_engine(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        MEDIANWINDOW_ENGINE_HISTOGRAM, outputArray));
+
+    // The cost model only samples the input, so AUTO must fall back when a value between the samples is no integer
+    double *fractionArray = (double* ) malloc(TEST_ARRAY_SIZE_HISTOGRAM_TESTS * sizeof(double));
+    double *resultArray_auto = NULL;
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(TEST_ARRAY_SIZE_HISTOGRAM_TESTS, 1000, 1, &resultArray_length, &resultArray_auto);
+    result_array_init(TEST_ARRAY_SIZE_HISTOGRAM_TESTS, 1000, 1, &resultArray_length, &resultArray_mediantester);
+    assert((fractionArray != NULL) && (resultArray_auto != NULL) && (resultArray_mediantester != NULL));
+    for(size_t i = 0; i < TEST_ARRAY_SIZE_HISTOGRAM_TESTS; i++)
+        fractionArray[i] = (double) ((size_t) rand() % 256);
+    fractionArray[1] = 0.5;
+    assert(!sliding_medianwindow_with_engine(fractionArray, TEST_ARRAY_SIZE_HISTOGRAM_TESTS, 1000, 1, false,
+        MEDIANWINDOW_ENGINE_HISTOGRAM, resultArray_auto));
+    assert(sliding_medianwindow(fractionArray, TEST_ARRAY_SIZE_HISTOGRAM_TESTS, 1000, 1, false, resultArray_auto));
+    median_tester_gen_medians(fractionArray, TEST_ARRAY_SIZE_HISTOGRAM_TESTS, 1000, 1, false,
+        resultArray_mediantester);
+    assert_equal_medians(resultArray_mediantester, resultArray_auto, resultArray_length);
+    free(fractionArray);
+    fractionArray = NULL;
+    free(resultArray_auto);
+    resultArray_auto = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+
+    // Should return false because the integers span one more value than the histogram can count
+    for(size_t i = 0; i < TEST_ARRAY_SIZE_STD_TESTS; i++)
+        testArray[i] = (double) (i % 2) * TEST_HISTOGRAM_MAX_RANGE;
+    assert(!sliding_medianwindow_with_engine(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        MEDIANWINDOW_ENGINE_HISTOGRAM, outputArray));
+
+    // Should return false because there is no valid value, whereas the other engines return NaN medians
+    for(size_t i = 0; i < TEST_ARRAY_SIZE_STD_TESTS; i++)
+        testArray[i] = NAN;
+    assert(!sliding_medianwindow_with_engine(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        MEDIANWINDOW_ENGINE_HISTOGRAM, outputArray));
+    assert(sliding_medianwindow(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, outputArray));
+    assert(isnan(outputArray[0]));
+
+    // Should return false because the input is missing
+    assert(!sliding_medianwindow_u8(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, outputArray));
+    assert(!sliding_medianwindow_u16(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, outputArray));
+
+    printf("All histogram tests passed\n");
+}
+
+static bool test_histogram(size_t testArrayLength, size_t windowSize, size_t steps, size_t range) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *integerArray = (double* ) malloc(testArrayLength * sizeof(double));
+    uint16_t *u16Array = (uint16_t* ) malloc(testArrayLength * sizeof(uint16_t));
+    uint8_t *u8Array = (uint8_t* ) malloc(testArrayLength * sizeof(uint8_t));
+    double *resultArray_engine = NULL;
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_engine);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_mediantester);
+    if((testArray == NULL) || (integerArray == NULL) || (u16Array == NULL) || (u8Array == NULL)
+        || (resultArray_engine == NULL) || (resultArray_mediantester == NULL)) {
+        free(testArray);
+        free(integerArray);
+        free(u16Array);
+        free(u8Array);
+        free(resultArray_engine);
+        free(resultArray_mediantester);
+        return false;
+    }
+
+    // The first value spans the whole range, so the histogram gets range bins
+    for(size_t i = 0; i < testArrayLength; i++) {
+        u16Array[i] = (uint16_t) ((i == 0) ? (range - 1) : ((size_t) rand() % range));
+        u8Array[i] = (uint8_t) u16Array[i];
+        integerArray[i] = (double) u16Array[i];
+        testArray[i] = (((size_t) rand() % 20) == 0) ? NAN : (integerArray[i] - (double) (range / 2));
+    }
+    testArray[0] = (double) (range - 1) - (double) (range / 2);
+    testArray[1] = -(double) (range / 2);
+
+    const MedianWindowEngine engines[] = { MEDIANWINDOW_ENGINE_HISTOGRAM, MEDIANWINDOW_ENGINE_AUTO };
+    for(size_t k = 0; k < (sizeof(engines) / sizeof(engines[0])); k++) {
+        for(size_t ignoreNaN = 0; ignoreNaN <= 1; ignoreNaN++) {
+            assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaN,
+                engines[k], resultArray_engine));
+            median_tester_gen_medians(testArray, testArrayLength, windowSize, steps, ignoreNaN,
+                resultArray_mediantester);
+            assert_equal_medians(resultArray_mediantester, resultArray_engine, resultArray_length);
+        }
+    }
+
+    median_tester_gen_medians(integerArray, testArrayLength, windowSize, steps, false, resultArray_mediantester);
+    assert(sliding_medianwindow_u16(u16Array, testArrayLength, windowSize, steps, resultArray_engine));
+    assert_equal_medians(resultArray_mediantester, resultArray_engine, resultArray_length);
+    if(range <= (UINT8_MAX + 1)) {
+        assert(sliding_medianwindow_u8(u8Array, testArrayLength, windowSize, steps, resultArray_engine));
+        assert_equal_medians(resultArray_mediantester, resultArray_engine, resultArray_length);
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(integerArray);
+    integerArray = NULL;
+    free(u16Array);
+    u16Array = NULL;
+    free(u8Array);
+    u8Array = NULL;
+    free(resultArray_engine);
+    resultArray_engine = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+    return true;
+}
+
+static bool aligned_pointer(const void *pointer) {
+    return ((((uintptr_t) pointer) % STD_ALIGNMENT) == 0);
+}
+
+static void assert_equal_medians(const double *expected, const double *actual, size_t length) {
+    for(size_t i = 0; i < length; i++) {
+        if(isnan(expected[i]))
+            assert(isnan(actual[i]));
+        else
+            assert(actual[i] == expected[i]);
+    }
+}
+
+// The float windows must return the float value of the median of the same values as doubles. Windows of up to
+// 25 values run the median networks and larger ones the double-heap.
+static void run_float_tests(void) {
+    const size_t windowSizes[] = { 26, 64, 100, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 3, 10 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t j = 0; j < numStepSizes; j++) {
+        for(size_t windowSize = 2; windowSize <= TEST_ENGINE_TINY_MAX_WINDOWSIZE; windowSize++) {
+            assert(test_float(TEST_ARRAY_SIZE_FLOAT_TESTS, windowSize, stepSizes[j], false));
+            assert(test_float(TEST_ARRAY_SIZE_FLOAT_TESTS, windowSize, stepSizes[j], true));
+        }
+
+        for(size_t i = 0; i < numWindowSizes; i++) {
+            assert(test_float(TEST_ARRAY_SIZE_FLOAT_TESTS, windowSizes[i], stepSizes[j], false));
+            assert(test_float(TEST_ARRAY_SIZE_FLOAT_TESTS, windowSizes[i], stepSizes[j], true));
+        }
+    }
+
+    float testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    float outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because inputArray == NULL, outputArray == NULL or the window is larger than the input
+    assert(!sliding_medianwindow_f32(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, outputArray));
+    assert(!sliding_medianwindow_f32(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, NULL));
+    assert(!sliding_medianwindow_f32(testArray, TEST_ARRAY_SIZE_STD_TESTS, TEST_ARRAY_SIZE_STD_TESTS + 1, 1, false,
+        outputArray));
+
+    printf("All float tests passed\n");
+}
+
+static bool test_float(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    float *floatArray = (float* ) malloc(testArrayLength * sizeof(float));
+    float *resultArray_float = (float* ) malloc(testArrayLength * sizeof(float));
+    double *resultArray_mediantester = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_mediantester);
+    if((testArray == NULL) || (floatArray == NULL) || (resultArray_float == NULL)
+        || (resultArray_mediantester == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 50), (testArrayLength / 100),
+        testArray))) {
+        free(testArray);
+        free(floatArray);
+        free(resultArray_float);
+        free(resultArray_mediantester);
+        return false;
+    }
+
+    // The doubles are rounded to floats first, so both sides see the same values
+    for(size_t i = 0; i < testArrayLength; i++) {
+        floatArray[i] = (float) testArray[i];
+        testArray[i] = (double) floatArray[i];
+    }
+
+    assert(sliding_medianwindow_f32(floatArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        resultArray_float));
+    median_tester_gen_medians(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        resultArray_mediantester);
+
+    for(size_t i = 0; i < resultArray_length; i++) {
+        if(isnan(resultArray_mediantester[i]))
+            assert(isnan(resultArray_float[i]));
+        else
+            assert(resultArray_float[i] == (float) resultArray_mediantester[i]);
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(floatArray);
+    floatArray = NULL;
+    free(resultArray_float);
+    resultArray_float = NULL;
+    free(resultArray_mediantester);
+    resultArray_mediantester = NULL;
+    return true;
+}
+
+// The integer windows must return the middle values of every sorted window exactly, also for values beyond 2^53
+// and for sums of both middle values that overflow. Small ranges cover windows full of equal values.
+static void run_integer_tests(void) {
+    const size_t windowSizes[] = { 26, 64, 100, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 3, 10 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t j = 0; j < numStepSizes; j++) {
+        for(size_t windowSize = 2; windowSize <= TEST_ENGINE_TINY_MAX_WINDOWSIZE; windowSize++) {
+            assert(test_integer(TEST_ARRAY_SIZE_INTEGER_TESTS, windowSize, stepSizes[j], true));
+            assert(test_integer(TEST_ARRAY_SIZE_INTEGER_TESTS, windowSize, stepSizes[j], false));
+        }
+
+        for(size_t i = 0; i < numWindowSizes; i++) {
+            assert(test_integer(TEST_ARRAY_SIZE_INTEGER_TESTS, windowSizes[i], stepSizes[j], true));
+            assert(test_integer(TEST_ARRAY_SIZE_INTEGER_TESTS, windowSizes[i], stepSizes[j], false));
+        }
+    }
+
+    int32_t testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    int32_t outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because inputArray == NULL, outputArray == NULL, the window is larger than the input
+    // or the averaging is unknown
+    assert(!sliding_medianwindow_i32(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, MEDIANWINDOW_AVERAGING_FLOOR,
+        outputArray));
+    assert(!sliding_medianwindow_i32(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, MEDIANWINDOW_AVERAGING_FLOOR, NULL));
+    assert(!sliding_medianwindow_i32(testArray, TEST_ARRAY_SIZE_STD_TESTS, TEST_ARRAY_SIZE_STD_TESTS + 1, 1,
+        MEDIANWINDOW_AVERAGING_FLOOR, outputArray));
+    assert(!sliding_medianwindow_i32(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1,
+        (MedianWindowAveraging) (MEDIANWINDOW_AVERAGING_UPPER + 1), outputArray));
+
+    // The middle values of the first two windows are INT64_MAX - 1 and INT64_MAX, so their sum overflows
+    const int64_t bigArray[] = { INT64_MAX, INT64_MIN, INT64_MAX - 1, INT64_MAX, INT64_MAX, INT64_MAX };
+    int64_t bigOutput[3];
+    assert(sliding_medianwindow_i64(bigArray, 6, 4, 1, MEDIANWINDOW_AVERAGING_FLOOR, bigOutput));
+    assert((bigOutput[0] == (INT64_MAX - 1)) && (bigOutput[1] == (INT64_MAX - 1)) && (bigOutput[2] == INT64_MAX));
+
+    printf("All integer tests passed\n");
+}
+
+static bool test_integer(size_t testArrayLength, size_t windowSize, size_t steps, bool fullRange) {
+    const size_t resultLength = ((testArrayLength - windowSize) / steps) + 1;
+    int64_t *testArray = (int64_t* ) malloc(testArrayLength * sizeof(int64_t));
+    int32_t *testArray_i32 = (int32_t* ) malloc(testArrayLength * sizeof(int32_t));
+    int64_t *window = (int64_t* ) malloc(windowSize * sizeof(int64_t));
+    int64_t *middleValues = (int64_t* ) malloc(2 * resultLength * sizeof(int64_t));
+    int64_t *middleValues_i32 = (int64_t* ) malloc(2 * resultLength * sizeof(int64_t));
+    int64_t *resultArray = (int64_t* ) malloc(resultLength * sizeof(int64_t));
+    int32_t *resultArray_i32 = (int32_t* ) malloc(resultLength * sizeof(int32_t));
+    if((testArray == NULL) || (testArray_i32 == NULL) || (window == NULL) || (middleValues == NULL)
+        || (middleValues_i32 == NULL) || (resultArray == NULL) || (resultArray_i32 == NULL)) {
+        free(testArray);
+        free(testArray_i32);
+        free(window);
+        free(middleValues);
+        free(middleValues_i32);
+        free(resultArray);
+        free(resultArray_i32);
+        return false;
+    }
+
+    // rand() returns at least 15 random bits, the int32 input takes the upper half of the int64 input
+    for(size_t i = 0; i < testArrayLength; i++) {
+        uint64_t value = 0;
+        for(size_t j = 0; j < 5; j++)
+            value = (value << 15) ^ (uint64_t) rand();
+
+        testArray[i] = fullRange ? (int64_t) value : ((int64_t) (value % TEST_INTEGER_SMALL_RANGE) - 8);
+        testArray_i32[i] = fullRange ? (int32_t) (testArray[i] >> 32) : (int32_t) testArray[i];
+    }
+
+    // Both middle values of every window, for the int64 and the int32 input
+    for(size_t i = 0; i < resultLength; i++) {
+        memcpy(window, &testArray[i * steps], windowSize * sizeof(int64_t));
+        qsort(window, windowSize, sizeof(int64_t), compare_int64);
+        middleValues[2 * i] = window[(windowSize - 1) / 2];
+        middleValues[(2 * i) + 1] = window[windowSize / 2];
+
+        for(size_t j = 0; j < windowSize; j++)
+            window[j] = testArray_i32[(i * steps) + j];
+        qsort(window, windowSize, sizeof(int64_t), compare_int64);
+        middleValues_i32[2 * i] = window[(windowSize - 1) / 2];
+        middleValues_i32[(2 * i) + 1] = window[windowSize / 2];
+    }
+
+    const MedianWindowAveraging averagings[] = { MEDIANWINDOW_AVERAGING_FLOOR, MEDIANWINDOW_AVERAGING_LOWER,
+        MEDIANWINDOW_AVERAGING_UPPER };
+    for(size_t k = 0; k < 3; k++) {
+        assert(sliding_medianwindow_i64(testArray, testArrayLength, windowSize, steps, averagings[k], resultArray));
+        assert(sliding_medianwindow_i32(testArray_i32, testArrayLength, windowSize, steps, averagings[k],
+            resultArray_i32));
+
+        for(size_t i = 0; i < resultLength; i++) {
+            const int64_t lower = middleValues[2 * i];
+            const int64_t upper = middleValues[(2 * i) + 1];
+            const int64_t lower_i32 = middleValues_i32[2 * i];
+            const int64_t upper_i32 = middleValues_i32[(2 * i) + 1];
+            switch (averagings[k]) {
+                case MEDIANWINDOW_AVERAGING_LOWER:
+                    assert(resultArray[i] == lower);
+                    assert(resultArray_i32[i] == lower_i32);
+                    break;
+                case MEDIANWINDOW_AVERAGING_UPPER:
+                    assert(resultArray[i] == upper);
+                    assert(resultArray_i32[i] == upper_i32);
+                    break;
+                default:
+                    // upper - lower does not overflow in uint64_t, and int64_t holds the sum of two int32 values
+                    assert(resultArray[i] == (int64_t) ((uint64_t) lower + (((uint64_t) upper - (uint64_t) lower)
+                        >> 1)));
+                    assert(resultArray_i32[i] == ((lower_i32 + upper_i32) >> 1));
+                    break;
+            }
+        }
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(testArray_i32);
+    testArray_i32 = NULL;
+    free(window);
+    window = NULL;
+    free(middleValues);
+    middleValues = NULL;
+    free(middleValues_i32);
+    middleValues_i32 = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    free(resultArray_i32);
+    resultArray_i32 = NULL;
+    return true;
+}
+
+static int compare_int64(const void *a, const void *b) {
+    const int64_t first = *(const int64_t* ) a;
+    const int64_t second = *(const int64_t* ) b;
+    return (first > second) - (first < second);
+}
+
+// Every quantile, interpolation and rank must match the sorted valid values of every window. The quantile 0.5 with
+// the midpoint interpolation must return the median.
+static void run_quantile_tests(void) {
+    const size_t windowSizes[] = { 2, 5, 10, 64, 100, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 7 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t i = 0; i < numWindowSizes; i++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            assert(test_quantile(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], false));
+            assert(test_quantile(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], true));
+            for(size_t k = 0; k <= MEDIANWINDOW_INTERPOLATION_MIDPOINT; k++) {
+                assert(test_quantiles(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], false,
+                    TEST_QUANTILES_FEW, (MedianWindowInterpolation) k));
+                assert(test_quantiles(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], false,
+                    TEST_QUANTILES_MANY, (MedianWindowInterpolation) k));
+                assert(test_quantiles(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], true,
+                    TEST_QUANTILES_FEW, (MedianWindowInterpolation) k));
+                assert(test_quantiles(TEST_ARRAY_SIZE_QUANTILE_TESTS, windowSizes[i], stepSizes[j], true,
+                    TEST_QUANTILES_MANY, (MedianWindowInterpolation) k));
+            }
+        }
+    }
+
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because the quantile, the interpolation or the rank is out of range
+    assert(!sliding_medianwindow_quantile(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, -0.1,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_quantile(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, 1.1,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_quantile(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, NAN,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_quantile(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, 0.5,
+        (MedianWindowInterpolation) (MEDIANWINDOW_INTERPOLATION_MIDPOINT + 1), outputArray));
+    assert(!sliding_medianwindow_rank(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, 0, outputArray));
+    assert(!sliding_medianwindow_rank(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, 4, outputArray));
+    assert(!sliding_medianwindow_rank(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, 2, outputArray));
+
+    // Should return false because there are no quantiles or one of them is out of range
+    const double quantiles[] = { 0.5, 1.5 };
+    assert(!sliding_medianwindow_quantiles(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, NULL, 1,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_quantiles(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, quantiles, 0,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_quantiles(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, quantiles, 2,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+
+    // The windows of several quantiles are packed one after another, which must keep every odd sized one aligned
+    const size_t oddWindowSizes[] = { 3, 5, 9, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    for(size_t i = 0; i < (sizeof(oddWindowSizes) / sizeof(oddWindowSizes[0])); i++) {
+        const size_t windowMemory = medianwindow_pack_size(1, oddWindowSizes[i]);
+        char *packedMemory = (char* ) malloc(medianwindow_pack_size(TEST_QUANTILES_FEW, oddWindowSizes[i]));
+        assert(packedMemory != NULL);
+        char *memory = packedMemory;
+        for(size_t k = 0; k < TEST_QUANTILES_FEW; k++) {
+            MedianWindow *window = NULL;
+            medianwindow_initialize_quantile(&memory, oddWindowSizes[i], 1, false, quantiles[0], 0, &window);
+            assert(((char* ) window) == (packedMemory + (k * windowMemory)));
+            assert(aligned_pointer(window) && aligned_pointer(window->maxHeap) && aligned_pointer(window->minHeap));
+        }
+        free(packedMemory);
+        packedMemory = NULL;
+    }
+
+    printf("All quantile tests passed\n");
+}
+
+static bool test_quantile(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows) {
+    const double quantiles[TEST_QUANTILE_NUM_QUANTILES] = { 0.0, 0.1, 0.25, 0.5, 0.95, 0.99, 1.0 };
+    const MedianWindowInterpolation interpolations[] = { MEDIANWINDOW_INTERPOLATION_LINEAR,
+        MEDIANWINDOW_INTERPOLATION_LOWER, MEDIANWINDOW_INTERPOLATION_HIGHER, MEDIANWINDOW_INTERPOLATION_NEAREST,
+        MEDIANWINDOW_INTERPOLATION_MIDPOINT };
+    const size_t numInterpolations = (sizeof(interpolations) / sizeof(interpolations[0]));
+    const size_t ranks[TEST_QUANTILE_NUM_RANKS] = { 1, 2, ((windowSize + 2) / 3), windowSize };
+    const size_t numResults = ((TEST_QUANTILE_NUM_QUANTILES * numInterpolations) + TEST_QUANTILE_NUM_RANKS);
+
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *window = (double* ) malloc(windowSize * sizeof(double));
+    double *resultArray = NULL;
+    double *resultArray_median = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_median);
+    double *expected = (double* ) malloc(numResults * resultArray_length * sizeof(double));
+    if((testArray == NULL) || (window == NULL) || (resultArray == NULL) || (resultArray_median == NULL)
+        || (expected == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 50), (testArrayLength / 100),
+        testArray))) {
+        free(testArray);
+        free(window);
+        free(resultArray);
+        free(resultArray_median);
+        free(expected);
+        return false;
+    }
+
+    // expected holds the results of all quantiles and interpolations, followed by those of all ranks
+    for(size_t i = 0; i < resultArray_length; i++) {
+        size_t numValues = 0;
+        for(size_t j = 0; j < windowSize; j++) {
+            if(!isnan(testArray[(i * steps) + j]))
+                window[numValues++] = testArray[(i * steps) + j];
+        }
+        qsort(window, numValues, sizeof(double), compare_double);
+
+        const bool nanWindow = (numValues == 0) || ((ignoreNaNWindows) && (numValues < windowSize));
+        for(size_t q = 0; q < TEST_QUANTILE_NUM_QUANTILES; q++) {
+            for(size_t k = 0; k < numInterpolations; k++) {
+                expected[(((q * numInterpolations) + k) * resultArray_length) + i] = nanWindow ? NAN :
+                    quantile_of_sorted(window, numValues, quantiles[q], interpolations[k]);
+            }
+        }
+        for(size_t r = 0; r < TEST_QUANTILE_NUM_RANKS; r++) {
+            expected[(((TEST_QUANTILE_NUM_QUANTILES * numInterpolations) + r) * resultArray_length) + i] = nanWindow ?
+                NAN : window[((numValues - 1) * (ranks[r] - 1)) / (windowSize - 1)];
+        }
+    }
+
+    for(size_t q = 0; q < TEST_QUANTILE_NUM_QUANTILES; q++) {
+        for(size_t k = 0; k < numInterpolations; k++) {
+            assert(sliding_medianwindow_quantile(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+                quantiles[q], interpolations[k], resultArray));
+            assert_equal_medians(&expected[((q * numInterpolations) + k) * resultArray_length], resultArray,
+                resultArray_length);
+        }
+    }
+    for(size_t r = 0; r < TEST_QUANTILE_NUM_RANKS; r++) {
+        assert(sliding_medianwindow_rank(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, ranks[r],
+            resultArray));
+        assert_equal_medians(&expected[((TEST_QUANTILE_NUM_QUANTILES * numInterpolations) + r) * resultArray_length],
+            resultArray, resultArray_length);
+    }
+
+    assert(sliding_medianwindow_quantile(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, 0.5,
+        MEDIANWINDOW_INTERPOLATION_MIDPOINT, resultArray));
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_HEAP, resultArray_median));
+    assert_equal_medians(resultArray_median, resultArray, resultArray_length);
+
+    free(testArray);
+    testArray = NULL;
+    free(window);
+    window = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    free(resultArray_median);
+    resultArray_median = NULL;
+    free(expected);
+    expected = NULL;
+    return true;
+}
+
+// Every quantile of sliding_medianwindow_quantiles must match the single quantile of the double-heap. The quantiles
+// are unsorted and share positions, which the shared descent of the tree has to resolve. Up to
+// QUANTILES_MEDIANWINDOW_TREE_THRESHOLD - 1 of them are taken by one double-heap each.
+static bool test_quantiles(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    size_t numQuantiles, MedianWindowInterpolation interpolation) {
+    const double quantiles[] = { 0.9, 0.1, 0.5, 0.5, 0.0, 1.0, 0.99, 0.101, 0.25 };
+    assert(numQuantiles <= (sizeof(quantiles) / sizeof(quantiles[0])));
+
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *resultArray = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray);
+    double *resultArray_quantiles = (double* ) malloc(numQuantiles * resultArray_length * sizeof(double));
+    double *column = (double* ) malloc(resultArray_length * sizeof(double));
+    if((testArray == NULL) || (resultArray == NULL) || (resultArray_quantiles == NULL) || (column == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 50), (testArrayLength / 100),
+        testArray))) {
+        free(testArray);
+        free(resultArray);
+        free(resultArray_quantiles);
+        free(column);
+        return false;
+    }
+
+    assert(sliding_medianwindow_quantiles(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, quantiles,
+        numQuantiles, interpolation, resultArray_quantiles));
+    for(size_t q = 0; q < numQuantiles; q++) {
+        assert(sliding_medianwindow_quantile(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+            quantiles[q], interpolation, resultArray));
+        for(size_t i = 0; i < resultArray_length; i++)
+            column[i] = resultArray_quantiles[(i * numQuantiles) + q];
+        assert_equal_medians(resultArray, column, resultArray_length);
+    }
+
+    free(testArray);
+    testArray = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    free(resultArray_quantiles);
+    resultArray_quantiles = NULL;
+    free(column);
+    column = NULL;
+    return true;
+}
+
+static void run_mad_tests(void) {
+    // 256 and 257 are both sides of MAD_MEDIANWINDOW_SORTED_MAX_WINDOWSIZE
+    const size_t windowSizes[] = { 2, 3, 5, 10, 64, 256, 257, 258, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 7 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t i = 0; i < numWindowSizes; i++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            assert(test_mad(TEST_ARRAY_SIZE_MAD_TESTS, windowSizes[i], stepSizes[j], false, false));
+            assert(test_mad(TEST_ARRAY_SIZE_MAD_TESTS, windowSizes[i], stepSizes[j], true, false));
+            assert(test_mad(TEST_ARRAY_SIZE_MAD_TESTS, windowSizes[i], stepSizes[j], false, true));
+        }
+    }
+
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because the MAD output is missing or the window is invalid
+    assert(!sliding_medianwindow_mad(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, outputArray, NULL));
+    assert(!sliding_medianwindow_mad(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false, NULL, outputArray));
+    assert(!sliding_medianwindow_mad(testArray, TEST_ARRAY_SIZE_STD_TESTS, 1, 1, false, NULL, outputArray));
+
+    // The three double-heaps of a MAD follow one another in one allocation, which must keep odd sized ones aligned
+    const size_t oddWindowSizes[] = { 257, 259, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    for(size_t i = 0; i < (sizeof(oddWindowSizes) / sizeof(oddWindowSizes[0])); i++) {
+        const size_t madMemory = mad_medianwindow_est_mem(oddWindowSizes[i]);
+        char *madStart = (char* ) malloc(madMemory);
+        assert(madStart != NULL);
+        char *memory = madStart;
+        Mad_MedianWindow *madWindow = NULL;
+        mad_medianwindow_initialize(&memory, oddWindowSizes[i], false, &madWindow);
+        assert((size_t) (memory - madStart) == madMemory);
+        assert(aligned_pointer(madWindow->median) && aligned_pointer(madWindow->lower)
+            && aligned_pointer(madWindow->upper));
+        assert(aligned_pointer(madWindow->lower->minHeap) && aligned_pointer(madWindow->upper->minHeap));
+        free(madStart);
+        madStart = NULL;
+    }
+
+    printf("All MAD tests passed\n");
+}
+
+// The MAD must match median(|x - median|) of the sorted valid values of every window, the median must match the
+// double-heap. With ties, the values are integers of a small range, so many deviations are equal.
+static bool test_mad(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows, bool ties) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *window = (double* ) malloc(windowSize * sizeof(double));
+    double *resultArray_median = NULL;
+    double *resultArray_mad = NULL;
+    double *expected_median = NULL;
+    double *expected_mad = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_median);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray_mad);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &expected_median);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &expected_mad);
+    if((testArray == NULL) || (window == NULL) || (resultArray_median == NULL) || (resultArray_mad == NULL)
+        || (expected_median == NULL) || (expected_mad == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 50), 0, testArray))) {
+        free(testArray);
+        free(window);
+        free(resultArray_median);
+        free(resultArray_mad);
+        free(expected_median);
+        free(expected_mad);
+        return false;
+    }
+    if(ties) {
+        for(size_t i = 0; i < testArrayLength; i++) {
+            if(!isnan(testArray[i]))
+                testArray[i] = (double) (rand() % TEST_MAD_SMALL_RANGE);
+        }
+    }
+
+    for(size_t i = 0; i < resultArray_length; i++) {
+        size_t numValues = 0;
+        for(size_t j = 0; j < windowSize; j++) {
+            if(!isnan(testArray[(i * steps) + j]))
+                window[numValues++] = testArray[(i * steps) + j];
+        }
+
+        if((numValues == 0) || ((ignoreNaNWindows) && (numValues < windowSize))) {
+            expected_median[i] = NAN;
+            expected_mad[i] = NAN;
+            continue;
+        }
+        qsort(window, numValues, sizeof(double), compare_double);
+        expected_median[i] = median_of_sorted(window, numValues);
+        for(size_t j = 0; j < numValues; j++)
+            window[j] = fabs(window[j] - expected_median[i]);
+        qsort(window, numValues, sizeof(double), compare_double);
+        expected_mad[i] = median_of_sorted(window, numValues);
+    }
+
+    assert(sliding_medianwindow_mad(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        resultArray_median, resultArray_mad));
+    assert_equal_medians(expected_median, resultArray_median, resultArray_length);
+    assert_equal_medians(expected_mad, resultArray_mad, resultArray_length);
+
+    assert(sliding_medianwindow_mad(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, NULL,
+        resultArray_mad));
+    assert_equal_medians(expected_mad, resultArray_mad, resultArray_length);
+    assert(sliding_medianwindow_with_engine(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows,
+        MEDIANWINDOW_ENGINE_HEAP, resultArray_median));
+    assert_equal_medians(expected_median, resultArray_median, resultArray_length);
+
+    free(testArray);
+    testArray = NULL;
+    free(window);
+    window = NULL;
+    free(resultArray_median);
+    resultArray_median = NULL;
+    free(resultArray_mad);
+    resultArray_mad = NULL;
+    free(expected_median);
+    expected_median = NULL;
+    free(expected_mad);
+    expected_mad = NULL;
+    return true;
+}
+
+static void run_hampel_tests(void) {
+    // 12 is the largest half window of the median networks, 128 the first one of the double-heaps
+    const size_t halfWindows[] = { 1, 2, 5, 12, 13, 128, 200 };
+    const double thresholds[] = { 0.0, 3.0 };
+    const size_t numHalfWindows = (sizeof(halfWindows) / sizeof(halfWindows[0]));
+    const size_t numThresholds = (sizeof(thresholds) / sizeof(thresholds[0]));
+
+    for(size_t i = 0; i < numHalfWindows; i++) {
+        for(size_t j = 0; j < numThresholds; j++) {
+            assert(test_hampel(TEST_ARRAY_SIZE_HAMPEL_TESTS, halfWindows[i], thresholds[j], false, false));
+            assert(test_hampel(TEST_ARRAY_SIZE_HAMPEL_TESTS, halfWindows[i], thresholds[j], true, false));
+            assert(test_hampel(TEST_ARRAY_SIZE_HAMPEL_TESTS, halfWindows[i], thresholds[j], false, true));
+        }
+    }
+
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because the output is missing, the half window is invalid or the threshold is negative
+    assert(!sliding_medianwindow_hampel(testArray, TEST_ARRAY_SIZE_STD_TESTS, 1, 3.0, false, NULL, NULL));
+    assert(!sliding_medianwindow_hampel(NULL, TEST_ARRAY_SIZE_STD_TESTS, 1, 3.0, false, outputArray, NULL));
+    assert(!sliding_medianwindow_hampel(testArray, TEST_ARRAY_SIZE_STD_TESTS, 0, 3.0, false, outputArray, NULL));
+    assert(!sliding_medianwindow_hampel(testArray, TEST_ARRAY_SIZE_STD_TESTS, TEST_ARRAY_SIZE_STD_TESTS / 2, 3.0,
+        false, outputArray, NULL));
+    assert(!sliding_medianwindow_hampel(testArray, TEST_ARRAY_SIZE_STD_TESTS, 1, -1.0, false, outputArray, NULL));
+    assert(!sliding_medianwindow_hampel(testArray, TEST_ARRAY_SIZE_STD_TESTS, 1, NAN, false, outputArray, NULL));
+
+    // The MAD follows the Hampel filter in one allocation, so its double-heaps must stay aligned as well
+    char *hampelStart = (char* ) malloc(hampel_medianwindow_est_mem(halfWindows[numHalfWindows - 1]));
+    assert(hampelStart != NULL);
+    char *memory = hampelStart;
+    Hampel_MedianWindow *hampelWindow = NULL;
+    hampel_medianwindow_initialize(&memory, halfWindows[numHalfWindows - 1], 3.0, false, &hampelWindow);
+    assert(aligned_pointer(hampelWindow->mad->lower) && aligned_pointer(hampelWindow->mad->upper));
+    free(hampelStart);
+    hampelStart = NULL;
+
+    printf("All Hampel tests passed\n");
+}
+
+// Every value must be replaced by the median of its sorted window exactly if it deviates by more than
+// threshold * 1.4826 * MAD, and the mask must flag the replaced values. About every 50th value is a spike, and the
+// NaN values are sparse enough to leave windows without NaN values for ignoreNaNWindows.
+static bool test_hampel(size_t testArrayLength, size_t halfWindow, double threshold, bool ignoreNaNWindows,
+    bool ties) {
+    const size_t windowSize = ((2 * halfWindow) + 1);
+    const size_t maskLength = ((testArrayLength + 7) / 8);
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *window = (double* ) malloc(windowSize * sizeof(double));
+    double *resultArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *expected = (double* ) malloc(testArrayLength * sizeof(double));
+    uint8_t *resultMask = (uint8_t* ) malloc(maskLength);
+    uint8_t *expectedMask = (uint8_t* ) calloc(maskLength, 1);
+    if((testArray == NULL) || (window == NULL) || (resultArray == NULL) || (expected == NULL)
+        || (resultMask == NULL) || (expectedMask == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 500), 0, testArray))) {
+        free(testArray);
+        free(window);
+        free(resultArray);
+        free(expected);
+        free(resultMask);
+        free(expectedMask);
+        return false;
+    }
+    for(size_t i = 0; i < testArrayLength; i++) {
+        if(isnan(testArray[i]))
+            continue;
+        if(ties)
+            testArray[i] = (double) (rand() % TEST_MAD_SMALL_RANGE);
+        if((rand() % 50) == 0)
+            testArray[i] += TEST_HAMPEL_SPIKE;
+    }
+
+    size_t numOutliers = 0;
+    memcpy(expected, testArray, (testArrayLength * sizeof(double)));
+    for(size_t center = halfWindow; (center + halfWindow) < testArrayLength; center++) {
+        size_t numValues = 0;
+        for(size_t j = (center - halfWindow); j <= (center + halfWindow); j++) {
+            if(!isnan(testArray[j]))
+                window[numValues++] = testArray[j];
+        }
+        if((numValues == 0) || ((ignoreNaNWindows) && (numValues < windowSize)))
+            continue;
+
+        qsort(window, numValues, sizeof(double), compare_double);
+        const double median = median_of_sorted(window, numValues);
+        for(size_t j = 0; j < numValues; j++)
+            window[j] = fabs(window[j] - median);
+        qsort(window, numValues, sizeof(double), compare_double);
+        const double mad = median_of_sorted(window, numValues);
+        if(fabs(testArray[center] - median) > ((threshold * 1.4826) * mad)) {
+            expected[center] = median;
+            expectedMask[center / 8] |= (uint8_t) (1u << (center % 8));
+            numOutliers++;
+        }
+    }
+    assert(numOutliers > 0);
+
+    assert(sliding_medianwindow_hampel(testArray, testArrayLength, halfWindow, threshold, ignoreNaNWindows,
+        resultArray, resultMask));
+    assert_equal_medians(expected, resultArray, testArrayLength);
+    assert(memcmp(expectedMask, resultMask, maskLength) == 0);
+
+    assert(sliding_medianwindow_hampel(testArray, testArrayLength, halfWindow, threshold, ignoreNaNWindows,
+        resultArray, NULL));
+    assert_equal_medians(expected, resultArray, testArrayLength);
+
+    free(testArray);
+    testArray = NULL;
+    free(window);
+    window = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    free(expected);
+    expected = NULL;
+    free(resultMask);
+    resultMask = NULL;
+    free(expectedMask);
+    expectedMask = NULL;
+    return true;
+}
+
+static void run_iqr_tests(void) {
+    const size_t windowSizes[] = { 2, 3, 4, 5, 10, 64, 257, TEST_WORKSPACE_MAX_WINDOWSIZE };
+    const size_t stepSizes[] = { 1, 7 };
+    const size_t numWindowSizes = (sizeof(windowSizes) / sizeof(windowSizes[0]));
+    const size_t numStepSizes = (sizeof(stepSizes) / sizeof(stepSizes[0]));
+
+    for(size_t i = 0; i < numWindowSizes; i++) {
+        for(size_t j = 0; j < numStepSizes; j++) {
+            for(size_t k = 0; k <= MEDIANWINDOW_INTERPOLATION_MIDPOINT; k++) {
+                assert(test_iqr(TEST_ARRAY_SIZE_IQR_TESTS, windowSizes[i], stepSizes[j], false,
+                    (MedianWindowInterpolation) k));
+                assert(test_iqr(TEST_ARRAY_SIZE_IQR_TESTS, windowSizes[i], stepSizes[j], true,
+                    (MedianWindowInterpolation) k));
+            }
+        }
+    }
+
+    double testArray[TEST_ARRAY_SIZE_STD_TESTS] = { 0 };
+    double outputArray[TEST_ARRAY_SIZE_STD_TESTS];
+
+    // Should return false because the output is missing, the window or the interpolation is invalid
+    assert(!sliding_medianwindow_iqr(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, NULL));
+    assert(!sliding_medianwindow_iqr(NULL, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_iqr(testArray, TEST_ARRAY_SIZE_STD_TESTS, 1, 1, false,
+        MEDIANWINDOW_INTERPOLATION_LINEAR, outputArray));
+    assert(!sliding_medianwindow_iqr(testArray, TEST_ARRAY_SIZE_STD_TESTS, 3, 1, false,
+        (MedianWindowInterpolation) (MEDIANWINDOW_INTERPOLATION_MIDPOINT + 1), outputArray));
+
+    // The upper quartile window follows the lower one, which must keep it aligned for odd window sizes
+    const size_t oddWindowSizes[] = { 3, 5, 9, 257 };
+    for(size_t i = 0; i < (sizeof(oddWindowSizes) / sizeof(oddWindowSizes[0])); i++) {
+        const size_t iqrMemory = iqr_medianwindow_est_mem(oddWindowSizes[i]);
+        char *iqrStart = (char* ) malloc(iqrMemory);
+        assert(iqrStart != NULL);
+        char *memory = iqrStart;
+        Iqr_MedianWindow *iqrWindow = NULL;
+        iqr_medianwindow_initialize(&memory, oddWindowSizes[i], false, MEDIANWINDOW_INTERPOLATION_LINEAR,
+            &iqrWindow);
+        assert((size_t) (memory - iqrStart) == iqrMemory);
+        assert(aligned_pointer(iqrWindow->lower) && aligned_pointer(iqrWindow->upper));
+        assert(aligned_pointer(iqrWindow->upper->maxHeap) && aligned_pointer(iqrWindow->upper->minHeap));
+        free(iqrStart);
+        iqrStart = NULL;
+    }
+
+    printf("All IQR tests passed\n");
+}
+
+// The IQR must match the difference of the quartiles of the sorted valid values of every window
+static bool test_iqr(size_t testArrayLength, size_t windowSize, size_t steps, bool ignoreNaNWindows,
+    MedianWindowInterpolation interpolation) {
+    double *testArray = (double* ) malloc(testArrayLength * sizeof(double));
+    double *window = (double* ) malloc(windowSize * sizeof(double));
+    double *resultArray = NULL;
+    double *expected = NULL;
+    size_t resultArray_length = 0;
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &resultArray);
+    result_array_init(testArrayLength, windowSize, steps, &resultArray_length, &expected);
+    if((testArray == NULL) || (window == NULL) || (resultArray == NULL) || (expected == NULL)
+        || (!test_array_init_with_spc_numbers(testArrayLength, (testArrayLength / 50), 0, testArray))) {
+        free(testArray);
+        free(window);
+        free(resultArray);
+        free(expected);
+        return false;
+    }
+
+    for(size_t i = 0; i < resultArray_length; i++) {
+        size_t numValues = 0;
+        for(size_t j = 0; j < windowSize; j++) {
+            if(!isnan(testArray[(i * steps) + j]))
+                window[numValues++] = testArray[(i * steps) + j];
+        }
+
+        if((numValues == 0) || ((ignoreNaNWindows) && (numValues < windowSize))) {
+            expected[i] = NAN;
+            continue;
+        }
+        qsort(window, numValues, sizeof(double), compare_double);
+        expected[i] = (quantile_of_sorted(window, numValues, 0.75, interpolation)
+            - quantile_of_sorted(window, numValues, 0.25, interpolation));
+    }
+
+    assert(sliding_medianwindow_iqr(testArray, testArrayLength, windowSize, steps, ignoreNaNWindows, interpolation,
+        resultArray));
+    assert_equal_medians(expected, resultArray, resultArray_length);
+
+    free(testArray);
+    testArray = NULL;
+    free(window);
+    window = NULL;
+    free(resultArray);
+    resultArray = NULL;
+    free(expected);
+    expected = NULL;
+    return true;
+}
+
+static double median_of_sorted(const double *sortedValues, size_t numValues) {
+    const size_t middle = (numValues / 2);
+    if((numValues % 2) != 0)
+        return sortedValues[middle];
+
+    return (sortedValues[middle - 1] + sortedValues[middle]) / 2;
+}
+
+static double quantile_of_sorted(const double *sortedValues, size_t numValues, double quantile,
+    MedianWindowInterpolation interpolation) {
+    const double position = ((double) (numValues - 1) * quantile);
+    const size_t index = (size_t) floor(position);
+    const double fraction = position - floor(position);
+    const double lower = sortedValues[index];
+    if(fraction == 0.0)
+        return lower;
+
+    const double upper = sortedValues[index + 1];
+    switch (interpolation) {
+        case MEDIANWINDOW_INTERPOLATION_LOWER:
+            return lower;
+        case MEDIANWINDOW_INTERPOLATION_HIGHER:
+            return upper;
+        case MEDIANWINDOW_INTERPOLATION_NEAREST:
+            if(fraction == 0.5)
+                return ((index % 2) == 0) ? lower : upper;
+            return (fraction < 0.5) ? lower : upper;
+        case MEDIANWINDOW_INTERPOLATION_MIDPOINT:
+            return (lower + upper) / 2;
+        default:
+            return lower + ((upper - lower) * fraction);
+    }
+}
+
+static int compare_double(const void *a, const void *b) {
+    const double first = *(const double* ) a;
+    const double second = *(const double* ) b;
+    return (first > second) - (first < second);
+}
+
 static void test_array_init(size_t length, double lowestValue, double highestValue, double *dest) {
     for(size_t i = 0; i < length; i++) {
         const double v = (lowestValue + (highestValue - lowestValue) * ((double) rand() / (double) RAND_MAX));
@@ -707,6 +2490,25 @@ static void test_array_init(size_t length, double lowestValue, double highestVal
     }
 }
 
+static bool test_array_init_with_spc_numbers(size_t length, size_t numNaNs, size_t numInfs, double *dest) {
+    test_array_init(length, LOWEST_VALUE_NORMAL_INPUT_TEST, HIGHEST_VALUE_NORMAL_INPUT_TEST, dest);
+
+    size_t *spcNumberIndizesArray = (size_t* ) malloc(length * sizeof(size_t));
+    if(spcNumberIndizesArray == NULL)
+        return false;
+
+    fill_and_shuffle_spc_number_indizes_array(length, spcNumberIndizesArray);
+    size_t currentIndex = 0;
+    test_array_init_random_nans(dest, &currentIndex, numNaNs, spcNumberIndizesArray);
+    const size_t posInfs = (numInfs / 2);
+    test_array_init_random_posinfs(dest, &currentIndex, posInfs, spcNumberIndizesArray);
+    test_array_init_random_neginfs(dest, &currentIndex, (numInfs - posInfs), spcNumberIndizesArray);
+
+    free(spcNumberIndizesArray);
+    spcNumberIndizesArray = NULL;
+    return true;
+}
+
 static void test_array_init_random_nans(double *testArray, size_t *currentIndex, size_t num,
     size_t *spcNumbersIndizesArray) {
     for(size_t i = 0; i < num; i++) {